@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/src/property.c" "CMakeFiles/property.dir/src/property.c.o" "gcc" "CMakeFiles/property.dir/src/property.c.o.d"
+  "/root/repo/test/stubs/src/host.c" "CMakeFiles/property.dir/stubs/src/host.c.o" "gcc" "CMakeFiles/property.dir/stubs/src/host.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/property.dir/src/property.c.o"
+  "CMakeFiles/property.dir/src/property.c.o.d"
+  "CMakeFiles/property.dir/stubs/src/host.c.o"
+  "CMakeFiles/property.dir/stubs/src/host.c.o.d"
+  "libproperty.a"
+  "libproperty.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/property.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
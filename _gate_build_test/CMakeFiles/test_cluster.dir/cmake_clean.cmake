@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_cluster.dir/root/repo/middleware/cluster/src/cluster.c.o"
+  "CMakeFiles/test_cluster.dir/root/repo/middleware/cluster/src/cluster.c.o.d"
+  "CMakeFiles/test_cluster.dir/src/test_cluster.c.o"
+  "CMakeFiles/test_cluster.dir/src/test_cluster.c.o.d"
+  "test_cluster"
+  "test_cluster.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_cluster.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
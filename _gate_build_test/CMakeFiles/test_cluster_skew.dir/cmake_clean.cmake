@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_cluster_skew.dir/root/repo/middleware/cluster/src/cluster.c.o"
+  "CMakeFiles/test_cluster_skew.dir/root/repo/middleware/cluster/src/cluster.c.o.d"
+  "CMakeFiles/test_cluster_skew.dir/src/test_cluster_skew.c.o"
+  "CMakeFiles/test_cluster_skew.dir/src/test_cluster_skew.c.o.d"
+  "test_cluster_skew"
+  "test_cluster_skew.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_cluster_skew.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
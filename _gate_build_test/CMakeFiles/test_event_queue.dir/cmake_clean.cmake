@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_event_queue.dir/root/repo/drivers/utils/src/event_queue.c.o"
+  "CMakeFiles/test_event_queue.dir/root/repo/drivers/utils/src/event_queue.c.o.d"
+  "CMakeFiles/test_event_queue.dir/src/test_event_queue.c.o"
+  "CMakeFiles/test_event_queue.dir/src/test_event_queue.c.o.d"
+  "test_event_queue"
+  "test_event_queue.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_event_queue.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_profile.dir/root/repo/middleware/profile/src/profile.c.o"
+  "CMakeFiles/test_profile.dir/root/repo/middleware/profile/src/profile.c.o.d"
+  "CMakeFiles/test_profile.dir/src/test_profile.c.o"
+  "CMakeFiles/test_profile.dir/src/test_profile.c.o.d"
+  "test_profile"
+  "test_profile.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_profile.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
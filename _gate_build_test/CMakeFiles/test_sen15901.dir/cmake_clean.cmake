@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_sen15901.dir/root/repo/drivers/components/src/sen15901.c.o"
+  "CMakeFiles/test_sen15901.dir/root/repo/drivers/components/src/sen15901.c.o.d"
+  "CMakeFiles/test_sen15901.dir/src/test_sen15901.c.o"
+  "CMakeFiles/test_sen15901.dir/src/test_sen15901.c.o.d"
+  "test_sen15901"
+  "test_sen15901.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_sen15901.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/middleware/synchro/src/synchro.c" "CMakeFiles/test_synchro.dir/root/repo/middleware/synchro/src/synchro.c.o" "gcc" "CMakeFiles/test_synchro.dir/root/repo/middleware/synchro/src/synchro.c.o.d"
+  "/root/repo/test/src/test_synchro.c" "CMakeFiles/test_synchro.dir/src/test_synchro.c.o" "gcc" "CMakeFiles/test_synchro.dir/src/test_synchro.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build_test/CMakeFiles/property.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
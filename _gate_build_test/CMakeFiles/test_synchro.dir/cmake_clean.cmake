@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_synchro.dir/root/repo/middleware/synchro/src/synchro.c.o"
+  "CMakeFiles/test_synchro.dir/root/repo/middleware/synchro/src/synchro.c.o.d"
+  "CMakeFiles/test_synchro.dir/src/test_synchro.c.o"
+  "CMakeFiles/test_synchro.dir/src/test_synchro.c.o.d"
+  "test_synchro"
+  "test_synchro.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/test_synchro.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,18 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_gate_build_test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_sen15901 "/root/repo/_gate_build_test/test_sen15901")
+set_tests_properties(test_sen15901 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;46;add_test;/root/repo/test/CMakeLists.txt;49;add_host_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(test_synchro "/root/repo/_gate_build_test/test_synchro")
+set_tests_properties(test_synchro PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;46;add_test;/root/repo/test/CMakeLists.txt;52;add_host_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(test_cluster "/root/repo/_gate_build_test/test_cluster")
+set_tests_properties(test_cluster PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;46;add_test;/root/repo/test/CMakeLists.txt;53;add_host_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(test_profile "/root/repo/_gate_build_test/test_profile")
+set_tests_properties(test_profile PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;46;add_test;/root/repo/test/CMakeLists.txt;54;add_host_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(test_event_queue "/root/repo/_gate_build_test/test_event_queue")
+set_tests_properties(test_event_queue PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;46;add_test;/root/repo/test/CMakeLists.txt;58;add_host_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(test_cluster_skew "/root/repo/_gate_build_test/test_cluster_skew")
+set_tests_properties(test_cluster_skew PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;46;add_test;/root/repo/test/CMakeLists.txt;62;add_host_test;/root/repo/test/CMakeLists.txt;0;")
@@ -14,8 +14,14 @@
 #include "rcc.h"
 #include "rtc.h"
 // Utils.
+#include "boot.h"
+#include "capture.h"
 #include "error.h"
+#include "event_queue.h"
+#include "history.h"
 #include "terminal.h"
+#include "timebase.h"
+#include "trace.h"
 // Components.
 #include "sen15901.h"
 // Middleware.
@@ -35,9 +41,15 @@ typedef enum {
     ERROR_BASE_RCC = (ERROR_BASE_LPTIM + LPTIM_ERROR_BASE_LAST),
     ERROR_BASE_RTC = (ERROR_BASE_RCC + RCC_ERROR_BASE_LAST),
     // Utils.
-    ERROR_BASE_TERMINAL = (ERROR_BASE_RTC + RTC_ERROR_BASE_LAST),
+    ERROR_BASE_BOOT = (ERROR_BASE_RTC + RTC_ERROR_BASE_LAST),
+    ERROR_BASE_CAPTURE = (ERROR_BASE_BOOT + BOOT_ERROR_BASE_LAST),
+    ERROR_BASE_EVENT_QUEUE = (ERROR_BASE_CAPTURE + CAPTURE_ERROR_BASE_LAST),
+    ERROR_BASE_HISTORY = (ERROR_BASE_EVENT_QUEUE + EVENT_QUEUE_ERROR_BASE_LAST),
+    ERROR_BASE_TERMINAL = (ERROR_BASE_HISTORY + HISTORY_ERROR_BASE_LAST),
+    ERROR_BASE_TIMEBASE = (ERROR_BASE_TERMINAL + TERMINAL_ERROR_BASE_LAST),
+    ERROR_BASE_TRACE = (ERROR_BASE_TIMEBASE + TIMEBASE_ERROR_BASE_LAST),
     // Components.
-    ERROR_BASE_SEN15901 = (ERROR_BASE_TERMINAL + TERMINAL_ERROR_BASE_LAST),
+    ERROR_BASE_SEN15901 = (ERROR_BASE_TRACE + TRACE_ERROR_BASE_LAST),
     // Middleware.
     ERROR_BASE_SIMULATION = (ERROR_BASE_SEN15901 + SEN15901_ERROR_BASE_LAST),
     // Last base value.
@@ -13,5 +13,31 @@
 //#define SEN15901_EMULATOR_MODE_DEBUG
 
 //#define SEN15901_MODE_ULTIMETER
+//#define SEN15901_MODE_DUAL
+
+//#define SEN15901_EMULATOR_MODE_WEATHER
+#define SEN15901_EMULATOR_WEATHER_SEED      1
+
+//#define SEN15901_EMULATOR_MODE_STRESS
+
+//#define SEN15901_EMULATOR_MODE_PROFILE
+
+//#define SEN15901_EMULATOR_SYNCHRO_COMMAND
+
+//#define SEN15901_EMULATOR_MODE_CAPTURE
+
+//#define SEN15901_EMULATOR_CLUSTER_LEADER
+//#define SEN15901_EMULATOR_CLUSTER_FOLLOWER
+
+//#define SEN15901_EMULATOR_COVERAGE
+//#define SEN15901_EMULATOR_COVERAGE_CHECKPOINT
+
+//#define SEN15901_EMULATOR_RAMFUNC
+
+//#define SEN15901_EMULATOR_SLEEP_GATING
+
+//#define SEN15901_EMULATOR_CHECK_INVARIANTS
+
+#define SEN15901_EMULATOR_VANE_VELOCITY_DPS 0
 
 #endif /* __SEN15901_EMULATOR_FLAGS_H__ */
@@ -0,0 +1,477 @@
+/*
+ * benchmark.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+// Peripherals.
+#include "error.h"
+#include "exti.h"
+#include "exti_registers.h"
+#include "gpio.h"
+#include "mcu_mapping.h"
+#include "nvic_priority.h"
+#include "pwr.h"
+#include "rcc.h"
+#include "tim.h"
+#include "tim_registers.h"
+// Components.
+#include "sen15901.h"
+// Utils.
+#include "ramfunc.h"
+#include "sleep_gating.h"
+#include "terminal.h"
+#include "timebase.h"
+#include "types.h"
+// Applicative.
+#include "error_base.h"
+#include "sen15901_emulator_flags.h"
+
+/*** BENCHMARK local macros ***/
+
+// SysTick is used as free running down counter clocked by the processor clock (no interrupt).
+#define BENCHMARK_SYSTICK_CSR               (*((volatile uint32_t*) 0xE000E010))
+#define BENCHMARK_SYSTICK_RVR               (*((volatile uint32_t*) 0xE000E014))
+#define BENCHMARK_SYSTICK_CVR               (*((volatile uint32_t*) 0xE000E018))
+
+#define BENCHMARK_SYSTICK_CSR_ENABLE        (0b1 << 0)
+#define BENCHMARK_SYSTICK_CSR_CLKSOURCE     (0b1 << 2)
+#define BENCHMARK_SYSTICK_COUNTER_MASK      0x00FFFFFF
+
+#define BENCHMARK_LOG_BAUD_RATE             9600
+#define BENCHMARK_LINE_END                  "\r\n"
+
+#define BENCHMARK_EXTI_LATENCY_LOOPS        64
+#define BENCHMARK_TERMINAL_LOOPS            8
+#define BENCHMARK_WAVEFORM_FREQUENCY_MHZ    1000
+#define BENCHMARK_TIMEBASE_PERIOD_US        1000
+#define BENCHMARK_TIMEBASE_LOOPS            64
+#define BENCHMARK_TIMER_INTERVAL_LOOPS      64
+#define BENCHMARK_COMMIT_LOOPS              64
+#define BENCHMARK_WAVEFORM_LOOPS            64
+#define BENCHMARK_WAKEUP_PERIOD_US          1000
+#define BENCHMARK_WAKEUP_LOOPS              64
+
+/*** BENCHMARK local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    uint32_t sum;
+    uint32_t count;
+} BENCHMARK_statistics_t;
+
+/*******************************************************************/
+typedef struct {
+    uint32_t overhead_cycles;
+    volatile uint32_t exti_systick;
+    volatile uint8_t exti_flag;
+    BENCHMARK_statistics_t timer_interval;
+    volatile uint32_t timer_systick;
+    volatile uint32_t timer_count;
+    BENCHMARK_statistics_t wakeup_latency;
+    volatile uint32_t wakeup_count;
+} BENCHMARK_context_t;
+
+/*** BENCHMARK local global variables ***/
+
+static BENCHMARK_context_t benchmark_ctx = {
+    .overhead_cycles = 0,
+    .exti_systick = 0,
+    .exti_flag = 0,
+    .timer_interval = { 0, 0, 0, 0 },
+    .timer_systick = 0,
+    .timer_count = 0,
+    .wakeup_latency = { 0, 0, 0, 0 },
+    .wakeup_count = 0
+};
+
+/*** BENCHMARK local functions ***/
+
+/*******************************************************************/
+static uint32_t _BENCHMARK_elapsed_cycles(uint32_t start, uint32_t end) {
+    // Local variables.
+    uint32_t cycles = ((start - end) & BENCHMARK_SYSTICK_COUNTER_MASK);
+    // Down counter: remove the cost of the counter reads (clamped since the calibration is not exact for every access pattern).
+    return ((cycles > benchmark_ctx.overhead_cycles) ? (cycles - benchmark_ctx.overhead_cycles) : 0);
+}
+
+/*******************************************************************/
+static void _BENCHMARK_reset(BENCHMARK_statistics_t* statistics) {
+    statistics->min = 0xFFFFFFFF;
+    statistics->max = 0;
+    statistics->sum = 0;
+    statistics->count = 0;
+}
+
+/*******************************************************************/
+static void _BENCHMARK_add(BENCHMARK_statistics_t* statistics, uint32_t cycles) {
+    // Update statistics.
+    if (cycles < statistics->min) {
+        statistics->min = cycles;
+    }
+    if (cycles > statistics->max) {
+        statistics->max = cycles;
+    }
+    statistics->sum += cycles;
+    statistics->count++;
+}
+
+/*******************************************************************/
+static void _BENCHMARK_print_value(char_t* name, int32_t value, char_t* unit) {
+    // Local variables.
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    // Print value.
+    terminal_status = TERMINAL_flush_tx_buffer(0);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(0, name);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_integer(0, value, STRING_FORMAT_DECIMAL, 0);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    if (unit != NULL) {
+        terminal_status = TERMINAL_tx_buffer_add_string(0, unit);
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    }
+    terminal_status = TERMINAL_tx_buffer_add_string(0, BENCHMARK_LINE_END);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_send_tx_buffer(0);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+}
+
+/*******************************************************************/
+static void _BENCHMARK_print_statistics(char_t* name, BENCHMARK_statistics_t* statistics) {
+    // Local variables.
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    // Print minimum, average and maximum cycles.
+    terminal_status = TERMINAL_flush_tx_buffer(0);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(0, "Bench_");
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(0, name);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(0, "=");
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_integer(0, (int32_t) statistics->min, STRING_FORMAT_DECIMAL, 0);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(0, ";");
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_integer(0, (int32_t) ((statistics->count == 0) ? 0 : (statistics->sum / statistics->count)), STRING_FORMAT_DECIMAL, 0);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(0, ";");
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_integer(0, (int32_t) statistics->max, STRING_FORMAT_DECIMAL, 0);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(0, "cycles" BENCHMARK_LINE_END);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_send_tx_buffer(0);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+}
+
+/*******************************************************************/
+RAMFUNC static void _BENCHMARK_exti_callback(void) {
+    // Latch counter as soon as possible.
+    benchmark_ctx.exti_systick = BENCHMARK_SYSTICK_CVR;
+    benchmark_ctx.exti_flag = 1;
+}
+
+/*******************************************************************/
+RAMFUNC static void _BENCHMARK_timebase_callback(void) {
+    // Local variables.
+    uint32_t systick = BENCHMARK_SYSTICK_CVR;
+    // Interval between consecutive interrupts: its spread is the interrupt jitter.
+    if (benchmark_ctx.timer_count != 0) {
+        _BENCHMARK_add(&(benchmark_ctx.timer_interval), ((benchmark_ctx.timer_systick - systick) & BENCHMARK_SYSTICK_COUNTER_MASK));
+    }
+    benchmark_ctx.timer_systick = systick;
+    benchmark_ctx.timer_count++;
+    // Account timer period.
+    TIMEBASE_period_elapsed(BENCHMARK_TIMEBASE_PERIOD_US);
+}
+
+/*******************************************************************/
+RAMFUNC static void _BENCHMARK_wakeup_callback(void) {
+    // Timer counts elapsed since the update event (timer and processor share the same clock).
+    _BENCHMARK_add(&(benchmark_ctx.wakeup_latency), ((TIM2->CNT) * ((TIM2->PSC) + 1)));
+    benchmark_ctx.wakeup_count++;
+}
+
+/*******************************************************************/
+static void _BENCHMARK_init_hw(void) {
+    // Local variables.
+    RCC_status_t rcc_status = RCC_SUCCESS;
+    // Init error stack
+    ERROR_stack_init();
+    // Init memory.
+    NVIC_init();
+    // Init power module and clock tree.
+    PWR_init();
+    rcc_status = RCC_init(NVIC_PRIORITY_CLOCK);
+    RCC_stack_error(ERROR_BASE_RCC);
+    // Init GPIOs.
+    GPIO_init();
+    EXTI_init();
+    // HSI has the same frequency as the HSE used by the emulator.
+    rcc_status = RCC_switch_to_hsi();
+    RCC_stack_error(ERROR_BASE_RCC);
+    // Start cycle counter.
+    BENCHMARK_SYSTICK_CSR = 0;
+    BENCHMARK_SYSTICK_RVR = BENCHMARK_SYSTICK_COUNTER_MASK;
+    BENCHMARK_SYSTICK_CVR = 0;
+    BENCHMARK_SYSTICK_CSR = (BENCHMARK_SYSTICK_CSR_ENABLE | BENCHMARK_SYSTICK_CSR_CLKSOURCE);
+}
+
+/*******************************************************************/
+static void _BENCHMARK_calibrate(void) {
+    // Local variables.
+    uint32_t start = 0;
+    uint32_t end = 0;
+    // Cost of two consecutive counter reads.
+    start = BENCHMARK_SYSTICK_CVR;
+    end = BENCHMARK_SYSTICK_CVR;
+    benchmark_ctx.overhead_cycles = ((start - end) & BENCHMARK_SYSTICK_COUNTER_MASK);
+}
+
+/*******************************************************************/
+static void _BENCHMARK_sen15901(SEN15901_personality_t personality) {
+    // Local variables.
+    SEN15901_status_t sen15901_status = SEN15901_SUCCESS;
+    TIM_status_t tim_status = TIM_SUCCESS;
+    BENCHMARK_statistics_t statistics;
+    SEN15901_commit_cb_t commit = NULL;
+    uint32_t wind_speed_ckmh_max = 0;
+    uint32_t wind_speed_ckmh = 0;
+    uint32_t start = 0;
+    uint32_t end = 0;
+    uint8_t idx = 0;
+    // Init emulator outputs.
+    sen15901_status = SEN15901_init(personality);
+    SEN15901_stack_error(ERROR_BASE_SEN15901);
+    _BENCHMARK_print_value("Bench_personality=", (int32_t) personality, NULL);
+    // Wind speed over the whole frequency range, by steps of 1 km/h.
+    wind_speed_ckmh_max = (uint32_t) ((((uint64_t) SEN15901_WIND_FREQUENCY_MHZ_MAX) * SEN15901_get_wind_speed_1hz_to_mh()) / (MATH_POWER_10[4]));
+    _BENCHMARK_reset(&statistics);
+    for (wind_speed_ckmh = 0; wind_speed_ckmh <= wind_speed_ckmh_max; wind_speed_ckmh += SEN15901_WIND_SPEED_CKMH_PER_KMH) {
+        start = BENCHMARK_SYSTICK_CVR;
+        sen15901_status = SEN15901_set_wind_speed(wind_speed_ckmh);
+        end = BENCHMARK_SYSTICK_CVR;
+        SEN15901_stack_error(ERROR_BASE_SEN15901);
+        _BENCHMARK_add(&statistics, _BENCHMARK_elapsed_cycles(start, end));
+    }
+    _BENCHMARK_print_statistics("sen15901_set_wind_speed", &statistics);
+    // Wind direction over the 16 directions.
+    _BENCHMARK_reset(&statistics);
+    for (idx = 0; idx < SEN15901_WIND_DIRECTION_NUMBER; idx++) {
+        start = BENCHMARK_SYSTICK_CVR;
+        sen15901_status = SEN15901_set_wind_direction((idx * MATH_2_PI_DEGREES) / SEN15901_WIND_DIRECTION_NUMBER);
+        end = BENCHMARK_SYSTICK_CVR;
+        SEN15901_stack_error(ERROR_BASE_SEN15901);
+        _BENCHMARK_add(&statistics, _BENCHMARK_elapsed_cycles(start, end));
+    }
+    _BENCHMARK_print_statistics("sen15901_set_wind_direction", &statistics);
+    // Register update applied by the waveform timer interrupt on each tick.
+    commit = SEN15901_get_commit_callback();
+    _BENCHMARK_reset(&statistics);
+    for (idx = 0; idx < BENCHMARK_COMMIT_LOOPS; idx++) {
+        start = BENCHMARK_SYSTICK_CVR;
+        commit();
+        end = BENCHMARK_SYSTICK_CVR;
+        _BENCHMARK_add(&statistics, _BENCHMARK_elapsed_cycles(start, end));
+    }
+    _BENCHMARK_print_statistics("sen15901_commit", &statistics);
+    // Timer driver waveform update.
+    _BENCHMARK_reset(&statistics);
+    for (idx = 0; idx < BENCHMARK_WAVEFORM_LOOPS; idx++) {
+        start = BENCHMARK_SYSTICK_CVR;
+        tim_status = TIM_PWM_set_waveform(TIM_INSTANCE_WIND, TIM_CHANNEL_WIND_SPEED, BENCHMARK_WAVEFORM_FREQUENCY_MHZ, 50);
+        end = BENCHMARK_SYSTICK_CVR;
+        TIM_stack_error(ERROR_BASE_SEN15901 + SEN15901_ERROR_BASE_TIM_WIND);
+        _BENCHMARK_add(&statistics, _BENCHMARK_elapsed_cycles(start, end));
+    }
+    _BENCHMARK_print_statistics("tim_pwm_set_waveform", &statistics);
+    // Release outputs.
+    sen15901_status = SEN15901_de_init();
+    SEN15901_stack_error(ERROR_BASE_SEN15901);
+}
+
+/*******************************************************************/
+static void _BENCHMARK_terminal(void) {
+    // Local variables.
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    BENCHMARK_statistics_t statistics_open;
+    BENCHMARK_statistics_t statistics_close;
+    BENCHMARK_statistics_t statistics_print;
+    uint32_t start = 0;
+    uint32_t end = 0;
+    uint8_t idx = 0;
+    // Reset statistics.
+    _BENCHMARK_reset(&statistics_open);
+    _BENCHMARK_reset(&statistics_close);
+    _BENCHMARK_reset(&statistics_print);
+    for (idx = 0; idx < BENCHMARK_TERMINAL_LOOPS; idx++) {
+        // Open.
+        start = BENCHMARK_SYSTICK_CVR;
+        terminal_status = TERMINAL_open(0, BENCHMARK_LOG_BAUD_RATE, NULL);
+        end = BENCHMARK_SYSTICK_CVR;
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+        _BENCHMARK_add(&statistics_open, _BENCHMARK_elapsed_cycles(start, end));
+        // Same sequence as a simulation log value (blocking transmission included).
+        start = BENCHMARK_SYSTICK_CVR;
+        _BENCHMARK_print_value("Bench_loop=", (int32_t) idx, NULL);
+        end = BENCHMARK_SYSTICK_CVR;
+        _BENCHMARK_add(&statistics_print, _BENCHMARK_elapsed_cycles(start, end));
+        // Close.
+        start = BENCHMARK_SYSTICK_CVR;
+        terminal_status = TERMINAL_close(0);
+        end = BENCHMARK_SYSTICK_CVR;
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+        _BENCHMARK_add(&statistics_close, _BENCHMARK_elapsed_cycles(start, end));
+    }
+    // Print results.
+    terminal_status = TERMINAL_open(0, BENCHMARK_LOG_BAUD_RATE, NULL);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    _BENCHMARK_print_statistics("terminal_open", &statistics_open);
+    _BENCHMARK_print_statistics("terminal_close", &statistics_close);
+    _BENCHMARK_print_statistics("print_value", &statistics_print);
+}
+
+/*******************************************************************/
+static void _BENCHMARK_timebase(void) {
+    // Local variables.
+    TIM_status_t tim_status = TIM_SUCCESS;
+    TIMEBASE_status_t timebase_status = TIMEBASE_SUCCESS;
+    BENCHMARK_statistics_t statistics_time_us;
+    BENCHMARK_statistics_t statistics_timestamp_us;
+    BENCHMARK_statistics_t statistics_timestamp_ms;
+    uint32_t start = 0;
+    uint32_t end = 0;
+    uint8_t idx = 0;
+    // Run the waveform timer as in the emulator.
+    TIMEBASE_init();
+    tim_status = TIM_STD_init(TIM_INSTANCE_SIMULATION, NVIC_PRIORITY_SIMULATION_WAVEFORM_TIMER);
+    TIM_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_WAVEFORM_TIMER);
+    tim_status = TIM_STD_start(TIM_INSTANCE_SIMULATION, BENCHMARK_TIMEBASE_PERIOD_US, TIM_UNIT_US, &_BENCHMARK_timebase_callback);
+    TIM_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_WAVEFORM_TIMER);
+    timebase_status = TIMEBASE_start(BENCHMARK_TIMEBASE_PERIOD_US);
+    TIMEBASE_stack_error(ERROR_BASE_TIMEBASE);
+    _BENCHMARK_reset(&statistics_time_us);
+    _BENCHMARK_reset(&statistics_timestamp_us);
+    _BENCHMARK_reset(&statistics_timestamp_ms);
+    _BENCHMARK_reset(&(benchmark_ctx.timer_interval));
+    benchmark_ctx.timer_count = 0;
+    for (idx = 0; idx < BENCHMARK_TIMEBASE_LOOPS; idx++) {
+        start = BENCHMARK_SYSTICK_CVR;
+        TIMEBASE_get_time_us();
+        end = BENCHMARK_SYSTICK_CVR;
+        _BENCHMARK_add(&statistics_time_us, _BENCHMARK_elapsed_cycles(start, end));
+        start = BENCHMARK_SYSTICK_CVR;
+        TIMEBASE_get_timestamp_us();
+        end = BENCHMARK_SYSTICK_CVR;
+        _BENCHMARK_add(&statistics_timestamp_us, _BENCHMARK_elapsed_cycles(start, end));
+        start = BENCHMARK_SYSTICK_CVR;
+        TIMEBASE_get_timestamp_ms();
+        end = BENCHMARK_SYSTICK_CVR;
+        _BENCHMARK_add(&statistics_timestamp_ms, _BENCHMARK_elapsed_cycles(start, end));
+    }
+    // Wait for enough timer interrupts.
+    while (benchmark_ctx.timer_count <= BENCHMARK_TIMER_INTERVAL_LOOPS);
+    TIMEBASE_stop();
+    tim_status = TIM_STD_stop(TIM_INSTANCE_SIMULATION);
+    TIM_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_WAVEFORM_TIMER);
+    tim_status = TIM_STD_de_init(TIM_INSTANCE_SIMULATION);
+    TIM_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_WAVEFORM_TIMER);
+    _BENCHMARK_print_statistics("timebase_get_time_us", &statistics_time_us);
+    _BENCHMARK_print_statistics("timebase_get_timestamp_us", &statistics_timestamp_us);
+    _BENCHMARK_print_statistics("timebase_get_timestamp_ms", &statistics_timestamp_ms);
+    _BENCHMARK_print_statistics("timer_interval", &(benchmark_ctx.timer_interval));
+}
+
+/*******************************************************************/
+static void _BENCHMARK_exti_latency(void) {
+    // Local variables.
+    BENCHMARK_statistics_t statistics;
+    uint32_t start = 0;
+    uint8_t idx = 0;
+    // Software trigger of the DUT synchronization line.
+    EXTI_configure_gpio(&GPIO_DUT_SYNCHRO, GPIO_PULL_DOWN, EXTI_TRIGGER_RISING_EDGE, &_BENCHMARK_exti_callback, NVIC_PRIORITY_DUT_SYNCHRONIZATION);
+    EXTI_enable_gpio_interrupt(&GPIO_DUT_SYNCHRO);
+    _BENCHMARK_reset(&statistics);
+    for (idx = 0; idx < BENCHMARK_EXTI_LATENCY_LOOPS; idx++) {
+        benchmark_ctx.exti_flag = 0;
+        start = BENCHMARK_SYSTICK_CVR;
+        EXTI->SWIER = (0b1 << (GPIO_DUT_SYNCHRO.pin));
+        while (benchmark_ctx.exti_flag == 0);
+        _BENCHMARK_add(&statistics, _BENCHMARK_elapsed_cycles(start, benchmark_ctx.exti_systick));
+    }
+    EXTI_disable_gpio_interrupt(&GPIO_DUT_SYNCHRO);
+    EXTI_release_gpio(&GPIO_DUT_SYNCHRO, GPIO_MODE_ANALOG);
+    _BENCHMARK_print_statistics("exti_latency", &statistics);
+}
+
+/*******************************************************************/
+static void _BENCHMARK_wakeup(char_t* name) {
+    // Local variables.
+    TIM_status_t tim_status = TIM_SUCCESS;
+    // Timer interrupts are received in sleep mode, as in the emulator main loop.
+    _BENCHMARK_reset(&(benchmark_ctx.wakeup_latency));
+    benchmark_ctx.wakeup_count = 0;
+    tim_status = TIM_STD_init(TIM_INSTANCE_SIMULATION, NVIC_PRIORITY_SIMULATION_WAVEFORM_TIMER);
+    TIM_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_WAVEFORM_TIMER);
+    tim_status = TIM_STD_start(TIM_INSTANCE_SIMULATION, BENCHMARK_WAKEUP_PERIOD_US, TIM_UNIT_US, &_BENCHMARK_wakeup_callback);
+    TIM_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_WAVEFORM_TIMER);
+    while (benchmark_ctx.wakeup_count < BENCHMARK_WAKEUP_LOOPS) {
+        PWR_enter_sleep_mode(PWR_SLEEP_MODE_NORMAL);
+    }
+    tim_status = TIM_STD_stop(TIM_INSTANCE_SIMULATION);
+    TIM_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_WAVEFORM_TIMER);
+    tim_status = TIM_STD_de_init(TIM_INSTANCE_SIMULATION);
+    TIM_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_WAVEFORM_TIMER);
+    _BENCHMARK_print_statistics(name, &(benchmark_ctx.wakeup_latency));
+}
+
+/*** BENCHMARK function ***/
+
+/*******************************************************************/
+int main(void) {
+    // Local variables.
+    RCC_status_t rcc_status = RCC_SUCCESS;
+    uint32_t sysclk_frequency_hz = 0;
+    // Init board.
+    _BENCHMARK_init_hw();
+    _BENCHMARK_calibrate();
+    // Terminal costs are measured first, then the terminal remains opened for the results.
+    _BENCHMARK_terminal();
+    rcc_status = RCC_get_frequency_hz(RCC_CLOCK_SYSTEM, &sysclk_frequency_hz);
+    RCC_stack_error(ERROR_BASE_RCC);
+    _BENCHMARK_print_value("Bench_sysclk=", (int32_t) sysclk_frequency_hz, "Hz");
+    _BENCHMARK_print_value("Bench_overhead=", (int32_t) benchmark_ctx.overhead_cycles, "cycles");
+#ifdef SEN15901_EMULATOR_RAMFUNC
+    _BENCHMARK_print_value("Bench_ramfunc=", 1, NULL);
+#else
+    _BENCHMARK_print_value("Bench_ramfunc=", 0, NULL);
+#endif
+    // Emulator outputs in all personalities.
+    _BENCHMARK_sen15901(SEN15901_PERSONALITY_CLASSIC);
+    _BENCHMARK_sen15901(SEN15901_PERSONALITY_ULTIMETER);
+    _BENCHMARK_sen15901(SEN15901_PERSONALITY_DUAL);
+    // Time reading.
+    _BENCHMARK_timebase();
+    // Interrupt latency.
+    _BENCHMARK_exti_latency();
+    // Wake-up latency with the default and the gated sleep clocks.
+    _BENCHMARK_wakeup("wakeup_latency");
+    SLEEP_GATING_init();
+    _BENCHMARK_wakeup("wakeup_latency_gated");
+    SLEEP_GATING_de_init();
+    // Report errors.
+    while (ERROR_stack_is_empty() == 0) {
+        _BENCHMARK_print_value("Bench_error=", (int32_t) ERROR_stack_read(), NULL);
+    }
+    _BENCHMARK_print_value("Bench_end=", 0, NULL);
+    // Main loop.
+    while (1) {
+        PWR_enter_sleep_mode(PWR_SLEEP_MODE_NORMAL);
+    }
+    return 0;
+}
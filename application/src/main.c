@@ -18,23 +18,41 @@
 #include "rtc.h"
 #include "usart.h"
 // Middleware.
+#include "energy.h"
 #include "simulation.h"
+// Components.
+#include "sen15901.h"
+// Utils.
+#include "boot.h"
+#include "sleep_gating.h"
+#include "trace.h"
 // Applicative.
 #include "error_base.h"
 #include "sen15901_emulator_flags.h"
 
 /*** MAIN local functions ***/
 
+/*******************************************************************/
+void __real_ERROR_stack_add(ERROR_code_t code);
+
+/*******************************************************************/
+void __wrap_ERROR_stack_add(ERROR_code_t code) {
+    // Errors are traced with their timestamp when they are stacked (linked with --wrap=ERROR_stack_add), the error stack itself is left untouched.
+    TRACE_write_error(code);
+    __real_ERROR_stack_add(code);
+}
+
 /*******************************************************************/
 static void _SEN15901_EMULATOR_init_hw(void) {
     // Local variables.
     RCC_status_t rcc_status = RCC_SUCCESS;
-    RTC_status_t rtc_status = RTC_SUCCESS;
-    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
     SIMULATION_status_t simulation_status = SIMULATION_SUCCESS;
+    BOOT_status_t boot_status = BOOT_SUCCESS;
 #ifndef SEN15901_EMULATOR_MODE_DEBUG
     IWDG_status_t iwdg_status = IWDG_SUCCESS;
 #endif
+    // Start boot timing.
+    BOOT_start();
     // Init error stack
     ERROR_stack_init();
     // Init memory.
@@ -43,34 +61,73 @@ static void _SEN15901_EMULATOR_init_hw(void) {
     PWR_init();
     rcc_status = RCC_init(NVIC_PRIORITY_CLOCK);
     RCC_stack_error(ERROR_BASE_RCC);
+    boot_status = BOOT_end_phase(BOOT_PHASE_CORE);
+    BOOT_stack_error(ERROR_BASE_BOOT);
     // Init GPIOs.
     GPIO_init();
     EXTI_init();
+    // Drive the outputs to their idle level immediately (plain GPIO writes, timers are configured later by the simulation).
+    SEN15901_init_idle_outputs();
 #ifndef SEN15901_EMULATOR_MODE_DEBUG
     // Start independent watchdog.
     iwdg_status = IWDG_init();
     IWDG_stack_error(ERROR_BASE_IWDG);
 #endif
-    // Init TCXO control pin.
+    // Power TCXO as soon as possible so that it settles while the outputs are initialized.
     GPIO_configure(&GPIO_TCXO_POWER_ENABLE, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
     GPIO_write(&GPIO_TCXO_POWER_ENABLE, 1);
+    ENERGY_set_state(ENERGY_STATE_TCXO, 1);
+    boot_status = BOOT_end_phase(BOOT_PHASE_SAFE_OUTPUTS);
+    BOOT_stack_error(ERROR_BASE_BOOT);
     // High speed oscillator.
     rcc_status = RCC_switch_to_hsi();
     RCC_stack_error(ERROR_BASE_RCC);
+    boot_status = BOOT_end_phase(BOOT_PHASE_HSI);
+    BOOT_stack_error(ERROR_BASE_BOOT);
     rcc_status = RCC_switch_to_hse(RCC_HSE_MODE_BYPASS);
     RCC_stack_error(ERROR_BASE_RCC);
-    // Calibrate internal clocks.
+    boot_status = BOOT_end_phase(BOOT_PHASE_HSE);
+    BOOT_stack_error(ERROR_BASE_BOOT);
+    // Init simulation (timers take the outputs over).
+    simulation_status = SIMULATION_init();
+    SIMULATION_stack_error(ERROR_BASE_SIMULATION);
+    boot_status = BOOT_end_phase(BOOT_PHASE_SIMULATION);
+    BOOT_stack_error(ERROR_BASE_BOOT);
+}
+
+/*******************************************************************/
+static void _SEN15901_EMULATOR_init_hw_deferred(void) {
+    // Local variables.
+    RCC_status_t rcc_status = RCC_SUCCESS;
+    SEN15901_status_t sen15901_status = SEN15901_SUCCESS;
+    RTC_status_t rtc_status = RTC_SUCCESS;
+    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    BOOT_status_t boot_status = BOOT_SUCCESS;
+    // Calibrate internal clocks on HSE while the waveforms are running.
+    // The measurement uses TIM21 (internal clocks capture), which is lent by the rainfall output (held low meanwhile).
+    // Rainfall pulses are only requested by the main loop, which is not running yet.
+    sen15901_status = SEN15901_suspend_rainfall();
+    SEN15901_stack_error(ERROR_BASE_SEN15901);
     rcc_status = RCC_calibrate_internal_clocks(NVIC_PRIORITY_CLOCK_CALIBRATION);
     RCC_stack_error(ERROR_BASE_RCC);
-    // Init RTC.
+    sen15901_status = SEN15901_resume_rainfall();
+    SEN15901_stack_error(ERROR_BASE_SEN15901);
+    boot_status = BOOT_end_phase(BOOT_PHASE_CALIBRATION);
+    BOOT_stack_error(ERROR_BASE_BOOT);
+    // Init RTC (uses the calibrated internal clocks).
     rtc_status = RTC_init(NULL, NVIC_PRIORITY_RTC);
     RTC_stack_error(ERROR_BASE_RTC);
+    boot_status = BOOT_end_phase(BOOT_PHASE_RTC);
+    BOOT_stack_error(ERROR_BASE_BOOT);
     // Init delay timer.
     lptim_status = LPTIM_init(NVIC_PRIORITY_DELAY);
     LPTIM_stack_error(ERROR_BASE_LPTIM);
-    // Init simulation.
-    simulation_status = SIMULATION_init();
-    SIMULATION_stack_error(ERROR_BASE_SIMULATION);
+    boot_status = BOOT_end_phase(BOOT_PHASE_LPTIM);
+    BOOT_stack_error(ERROR_BASE_BOOT);
+#ifdef SEN15901_EMULATOR_SLEEP_GATING
+    // Reduce the clocks of the idle periods.
+    SLEEP_GATING_init();
+#endif
 }
 
 /*** MAIN function ***/
@@ -79,16 +136,23 @@ static void _SEN15901_EMULATOR_init_hw(void) {
 int main(void) {
     // Local variables.
     SIMULATION_status_t simulation_status = SIMULATION_SUCCESS;
+    BOOT_status_t boot_status = BOOT_SUCCESS;
     // Init board.
     _SEN15901_EMULATOR_init_hw();
     // Start simulation.
     simulation_status = SIMULATION_start();
     SIMULATION_stack_error(ERROR_BASE_SIMULATION);
+    boot_status = BOOT_end_phase(BOOT_PHASE_FIRST_WAVEFORM);
+    BOOT_stack_error(ERROR_BASE_BOOT);
+    // Init remaining peripherals once the waveforms are running.
+    _SEN15901_EMULATOR_init_hw_deferred();
     // Main loop.
     while (1) {
         // Enter sleep mode.
         IWDG_reload();
+        ENERGY_set_state(ENERGY_STATE_SLEEP, 1);
         PWR_enter_sleep_mode(PWR_SLEEP_MODE_NORMAL);
+        ENERGY_set_state(ENERGY_STATE_SLEEP, 0);
         IWDG_reload();
         // Run simulation.
         simulation_status = SIMULATION_process();
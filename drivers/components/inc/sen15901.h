@@ -9,6 +9,7 @@
 #define __SEN15901_H__
 
 #include "error.h"
+#include "sen15901_emulator_flags.h"
 #include "tim.h"
 #include "types.h"
 
@@ -17,6 +18,26 @@
 #define SEN15901_WIND_DIRECTION_RESISTOR_NUMBER     8
 #define SEN15901_WIND_DIRECTION_NUMBER              (SEN15901_WIND_DIRECTION_RESISTOR_NUMBER << 1)
 
+#define SEN15901_WIND_SPEED_CKMH_PER_KMH            100
+
+#if ((defined SEN15901_MODE_ULTIMETER) && (defined SEN15901_MODE_DUAL))
+#error "Only one default personality must be selected"
+#endif
+
+#ifdef SEN15901_MODE_ULTIMETER
+#define SEN15901_PERSONALITY_DEFAULT                SEN15901_PERSONALITY_ULTIMETER
+#elif (defined SEN15901_MODE_DUAL)
+#define SEN15901_PERSONALITY_DEFAULT                SEN15901_PERSONALITY_DUAL
+#else
+#define SEN15901_PERSONALITY_DEFAULT                SEN15901_PERSONALITY_CLASSIC
+#endif
+
+// Wind timer limit (2 counts period at 10kHz).
+#define SEN15901_WIND_FREQUENCY_MHZ_MAX             5000000
+
+// Vane rotation speed limit (all intermediate states are visited with 12ms updates).
+#define SEN15901_WIND_DIRECTION_VELOCITY_DPS_MAX    720
+
 /*** SEN15901 structures ***/
 
 /*!******************************************************************
@@ -26,7 +47,13 @@
 typedef enum {
     // Driver errors.
     SEN15901_SUCCESS = 0,
+    SEN15901_ERROR_NULL_PARAMETER,
+    SEN15901_ERROR_PERSONALITY,
     SEN15901_ERROR_WIND_DIRECTION,
+    SEN15901_ERROR_WIND_DIRECTION_VELOCITY,
+    SEN15901_ERROR_WIND_DIRECTION_COMBINATION,
+    SEN15901_ERROR_RAINFALL_FREQUENCY,
+    SEN15901_ERROR_RAINFALL_SUSPENDED,
     // Low level driver errors.
     SEN15901_ERROR_BASE_TIM_WIND = ERROR_BASE_STEP,
     SEN15901_ERROR_BASE_TIM_RAINFALL = (SEN15901_ERROR_BASE_TIM_WIND + TIM_ERROR_BASE_LAST),
@@ -34,16 +61,42 @@ typedef enum {
     SEN15901_ERROR_BASE_LAST = (SEN15901_ERROR_BASE_TIM_RAINFALL + TIM_ERROR_BASE_LAST)
 } SEN15901_status_t;
 
+/*!******************************************************************
+ * \enum SEN15901_personality_t
+ * \brief Emulated sensor variants.
+ *******************************************************************/
+typedef enum {
+    SEN15901_PERSONALITY_CLASSIC = 0,
+    SEN15901_PERSONALITY_ULTIMETER,
+    SEN15901_PERSONALITY_DUAL,
+    SEN15901_PERSONALITY_LAST
+} SEN15901_personality_t;
+
+/*!******************************************************************
+ * \fn SEN15901_commit_cb_t
+ * \brief Apply staged waveform (to be called from the waveform tick interrupt).
+ *******************************************************************/
+typedef void (*SEN15901_commit_cb_t)(void);
+
 /*** SEN15901 functions ***/
 
 /*!******************************************************************
- * \fn SEN15901_status_t SEN15901_init(void)
- * \brief Init SEN15901 emulator driver.
+ * \fn void SEN15901_init_idle_outputs(void)
+ * \brief Drive all emulator outputs to their idle level with plain GPIO writes (no timer is required, to be called right after the GPIO init).
  * \param[in]   none
  * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void SEN15901_init_idle_outputs(void);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_init(SEN15901_personality_t personality)
+ * \brief Init SEN15901 emulator driver.
+ * \param[in]   personality: Sensor variant to emulate.
+ * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
-SEN15901_status_t SEN15901_init(void);
+SEN15901_status_t SEN15901_init(SEN15901_personality_t personality);
 
 /*!******************************************************************
  * \fn SEN15901_status_t SEN15901_de_init(void)
@@ -55,23 +108,128 @@ SEN15901_status_t SEN15901_init(void);
 SEN15901_status_t SEN15901_de_init(void);
 
 /*!******************************************************************
- * \fn SEN15901_status_t SEN15901_set_wind_speed(uint32_t wind_speed_kmh)
- * \brief Set SEN15901 test waveform to simulate a wind speed.
- * \param[in]   wind_speed_kmh: Wind speed to simulate in km/h.
+ * \fn SEN15901_personality_t SEN15901_get_personality(void)
+ * \brief Get the emulated sensor variant.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Current personality.
+ *******************************************************************/
+SEN15901_personality_t SEN15901_get_personality(void);
+
+/*!******************************************************************
+ * \fn uint32_t SEN15901_get_tick_period_ms(void)
+ * \brief Get the waveform tick period of the current personality.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Waveform tick period in ms.
+ *******************************************************************/
+uint32_t SEN15901_get_tick_period_ms(void);
+
+/*!******************************************************************
+ * \fn uint32_t SEN15901_get_wind_speed_1hz_to_mh(void)
+ * \brief Get the anemometer factor of the current personality.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Wind speed in m/h corresponding to a 1Hz signal.
+ *******************************************************************/
+uint32_t SEN15901_get_wind_speed_1hz_to_mh(void);
+
+/*!******************************************************************
+ * \fn uint32_t SEN15901_get_classic_wind_speed_ckmh(void)
+ * \brief Get the wind speed measured by a classic anemometer on the wind speed output.
+ * \note        The wind speed output is shared in dual personality: it can not be scaled for both DUTs and the classic one measures this value.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Wind speed in 0.01km/h unit (differs from the staged one in dual personality).
+ *******************************************************************/
+uint32_t SEN15901_get_classic_wind_speed_ckmh(void);
+
+/*!******************************************************************
+ * \fn SEN15901_commit_cb_t SEN15901_get_commit_callback(void)
+ * \brief Get the commit function of the current personality.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function applying the staged waveform.
+ *******************************************************************/
+SEN15901_commit_cb_t SEN15901_get_commit_callback(void);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_set_wind_speed(uint32_t wind_speed_ckmh)
+ * \brief Stage SEN15901 test waveform to simulate a wind speed (applied on next commit).
+ * \param[in]   wind_speed_ckmh: Wind speed to simulate in 0.01km/h unit.
  * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
-SEN15901_status_t SEN15901_set_wind_speed(uint32_t wind_speed_kmh);
+SEN15901_status_t SEN15901_set_wind_speed(uint32_t wind_speed_ckmh);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_get_wind_speed_error(int32_t* wind_speed_error_ppm)
+ * \brief Get the average frequency error of the wind speed waveform emitted since the last speed change (dithering is applied per tick).
+ * \param[in]   none
+ * \param[out]  wind_speed_error_ppm: Pointer to the achieved frequency error in ppm.
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_get_wind_speed_error(int32_t* wind_speed_error_ppm);
+
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+/*!******************************************************************
+ * \fn uint32_t SEN15901_get_wind_speed_pulse_count(uint32_t tick_offset_us)
+ * \brief Get the number of wind speed pulses emitted since init, computed from the timer registers committed on each tick.
+ * \param[in]   tick_offset_us: Time elapsed since the last tick in us.
+ * \param[out]  none
+ * \retval      Number of rising edges emitted on the wind speed output (wraps around).
+ *******************************************************************/
+uint32_t SEN15901_get_wind_speed_pulse_count(uint32_t tick_offset_us);
+#endif
 
 /*!******************************************************************
  * \fn SEN15901_status_t SEN15901_set_wind_direction(uint32_t wind_direction_degrees)
- * \brief Set SEN15901 test waveform to simulate a wind direction.
+ * \brief Stage SEN15901 test waveform to simulate a wind direction (applied on next commit).
  * \param[in]   wind_direction_degrees: Wind direction to simulate in degrees.
  * \param[out]  none
  * \retval      Function execution status.
  *******************************************************************/
 SEN15901_status_t SEN15901_set_wind_direction(uint32_t wind_direction_degrees);
 
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_set_wind_direction_target(uint32_t wind_direction_degrees, uint32_t velocity_dps)
+ * \brief Start a vane rotation towards a wind direction, by the shortest way.
+ * \param[in]   wind_direction_degrees: Target wind direction in degrees.
+ * \param[in]   velocity_dps: Angular velocity in degrees per second (0 to stage the target direction as SEN15901_set_wind_direction).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_set_wind_direction_target(uint32_t wind_direction_degrees, uint32_t velocity_dps);
+
+/*!******************************************************************
+ * \fn uint8_t SEN15901_is_wind_direction_rotating(void)
+ * \brief Check if a vane rotation is in progress.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      1 if SEN15901_rotate_wind_direction() has to be called periodically, 0 otherwise.
+ *******************************************************************/
+uint8_t SEN15901_is_wind_direction_rotating(void);
+
+/*!******************************************************************
+ * \fn void SEN15901_rotate_wind_direction(uint32_t elapsed_us)
+ * \brief Move the vane according to the elapsed time (to be called periodically from timer interrupt, constant cost).
+ * \param[in]   elapsed_us: Time elapsed since the previous call in microseconds.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void SEN15901_rotate_wind_direction(uint32_t elapsed_us);
+
+#ifdef SEN15901_EMULATOR_CHECK_INVARIANTS
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_check_wind_direction(void)
+ * \brief Check that every wind direction drives a valid vane resistors combination.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_check_wind_direction(void);
+#endif
+
 /*!******************************************************************
  * \fn SEN15901_status_t SEN15901_make_rainfall_interrupt(void)
  * \brief Simulate a rainfall interrupt.
@@ -81,6 +239,33 @@ SEN15901_status_t SEN15901_set_wind_direction(uint32_t wind_direction_degrees);
  *******************************************************************/
 SEN15901_status_t SEN15901_make_rainfall_interrupt(void);
 
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_set_rainfall_frequency(uint32_t rainfall_frequency_mhz)
+ * \brief Start or stop a continuous rainfall pulses train.
+ * \param[in]   rainfall_frequency_mhz: Pulses frequency in mHz (0 to stop the train at the end of the current pulse).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_set_rainfall_frequency(uint32_t rainfall_frequency_mhz);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_suspend_rainfall(void)
+ * \brief Release the rainfall timer for another use, the rainfall output is held at its idle level meanwhile.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_suspend_rainfall(void);
+
+/*!******************************************************************
+ * \fn SEN15901_status_t SEN15901_resume_rainfall(void)
+ * \brief Take the rainfall timer back after SEN15901_suspend_rainfall().
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SEN15901_status_t SEN15901_resume_rainfall(void);
+
 /*******************************************************************/
 #define SEN15901_exit_error(base) { ERROR_check_exit(sen15901_status, SEN15901_SUCCESS, base) }
 
@@ -7,32 +7,67 @@
 
 #include "sen15901.h"
 
+#include "capture.h"
 #include "error.h"
 #include "error_base.h"
 #include "gpio.h"
+#include "gpio_registers.h"
+#include "irq.h"
 #include "mcu_mapping.h"
+#include "ramfunc.h"
 #include "sen15901_emulator_flags.h"
+#include "stm32l0xx_drivers_flags.h"
 #include "tim.h"
+#include "tim_registers.h"
+#include "trace.h"
 #include "types.h"
 
 /*** SEN15901 local macros ***/
 
-#ifdef SEN15901_MODE_ULTIMETER
-#define SEN15901_WIND_SPEED_1HZ_TO_MH                   5400
-#else
-#define SEN15901_WIND_SPEED_1HZ_TO_MH                   2400
-#endif
+#define SEN15901_CLASSIC_WIND_SPEED_1HZ_TO_MH           2400
+#define SEN15901_CLASSIC_TICK_PERIOD_MS                 3001
+
+#define SEN15901_ULTIMETER_WIND_SPEED_1HZ_TO_MH         5400
+#define SEN15901_ULTIMETER_TICK_PERIOD_MS               6001
 
-#define SEN15901_PWM_FREQUENCY_MHZ_MIN                  (1000000 / SEN15901_WIND_SPEED_1HZ_TO_MH)
+// Timer clock periods are computed as (wind_period_numerator / (10 * wind_speed_ckmh)), then divided by the prescaler.
+#define SEN15901_WIND_PERIOD_MIN                        2
+#define SEN15901_WIND_PERIOD_MAX                        0xFFFF
+#define SEN15901_WIND_PRESCALER_MAX                     0x10000
 
 #define SEN15901_WIND_DIRECTION_RESISTOR_NUMBER         8
 #define SEN15901_WIND_DIRECTION_RESISTOR_RANGE_DEGREES  34
 
+// Vane position is integrated in millidegrees.
+#define SEN15901_WIND_DIRECTION_MDEG_PER_DEGREE         1000
+#define SEN15901_WIND_DIRECTION_MDEG_FULL_SCALE         (MATH_2_PI_DEGREES * SEN15901_WIND_DIRECTION_MDEG_PER_DEGREE)
+#define SEN15901_US_PER_MS                              1000
+
 #define SEN15901_RAINFALL_PULSE_DURATION_MS             200
+// Pulses train half period is (SEN15901_RAINFALL_HALF_PERIOD_NUMERATOR / rainfall_frequency_mhz) microseconds.
+#define SEN15901_RAINFALL_HALF_PERIOD_NUMERATOR         500000000
+#define SEN15901_RAINFALL_HALF_PERIOD_US_MIN            50
+
+// Wind timer prescaler is selected for each speed, pulses are modeled in timer clock cycles.
+#define SEN15901_TIM_CLOCK_HZ                           STM32L0XX_DRIVERS_RCC_HSE_FREQUENCY_HZ
+#define SEN15901_TIM_CYCLES_PER_MS                      (SEN15901_TIM_CLOCK_HZ / SEN15901_US_PER_MS)
+#define SEN15901_TIM_CYCLES_PER_US                      (SEN15901_TIM_CYCLES_PER_MS / SEN15901_US_PER_MS)
+#define SEN15901_TIM_CYCLES_PER_CAPTURE_TICK            (SEN15901_TIM_CYCLES_PER_US * CAPTURE_TICK_US)
+
+#define SEN15901_TIM_CR1_CEN                            (0b1 << 0)
+#define SEN15901_TIM_CR1_UDIS                           (0b1 << 1)
+#define SEN15901_TIM_CR1_OPM                            (0b1 << 3)
+#define SEN15901_TIM_CR1_ARPE                           (0b1 << 7)
+#define SEN15901_TIM_CCMR1_OC1PE                        (0b1 << 3)
+#define SEN15901_TIM_CCMR1_OC2PE                        (0b1 << 11)
+#define SEN15901_TIM_EGR_UG                             (0b1 << 0)
+
+#define SEN15901_GPIO_PORT_NUMBER                       2
+
+#define SEN15901_DITHER_STATE_NUMBER                    2
 
 /*** SEN15901 local structures ***/
 
-#ifndef SEN15901_MODE_ULTIMETER
 /*******************************************************************/
 typedef struct {
     const GPIO_pin_t* const gpio;
@@ -40,19 +75,129 @@ typedef struct {
     uint32_t angle_min;
     uint32_t angle_max;
 } SEN15901_wind_direction_resistor_t;
+
+/*******************************************************************/
+typedef struct {
+    // Wind timer period is N or (N + 1) counts (index 0 and 1 of the compare arrays) of the prescaled clock.
+    uint32_t tim_psc;
+    uint32_t tim_period;
+    uint32_t tim_period_dither_q16;
+    uint32_t tim_ccr_speed[SEN15901_DITHER_STATE_NUMBER];
+    // Wind direction outputs (both are driven by the dual personality).
+    uint32_t tim_ccr_direction[SEN15901_DITHER_STATE_NUMBER];
+    uint32_t gpio_bsrr[SEN15901_GPIO_PORT_NUMBER];
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+    uint8_t vane_mask;
+#endif
+    // Long-term frequency error of the dithered period.
+    int32_t wind_speed_error_ppm;
+} SEN15901_shadow_t;
+
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+/*******************************************************************/
+typedef struct {
+    // Rising edges emitted until the last commit.
+    uint32_t pulse_count;
+    // Position in the current pulse, period and high duration of the current and preloaded pulses (in timer clock cycles).
+    uint32_t phase;
+    uint32_t period;
+    uint32_t high;
+    uint32_t next_period;
+    uint32_t next_high;
+} SEN15901_pulse_model_t;
 #endif
 
-#ifdef SEN15901_MODE_ULTIMETER
 /*******************************************************************/
 typedef struct {
-    uint32_t speed_pwm_frequency_mhz;
+    uint32_t wind_speed_1hz_to_mh;
+    uint32_t tick_period_ms;
+    const TIM_gpio_t* tim_gpio_wind;
+    void (*init_direction)(void);
+    void (*release_direction)(void);
+    void (*stage_direction)(void);
+    void (*apply_direction)(void);
+    SEN15901_commit_cb_t commit;
+} SEN15901_personality_descriptor_t;
+
+/*******************************************************************/
+typedef struct {
+    const SEN15901_personality_descriptor_t* descriptor;
+    SEN15901_personality_t personality;
+    uint64_t wind_period_numerator;
+    uint32_t wind_speed_ckmh;
+    SEN15901_shadow_t shadow;
+    SEN15901_shadow_t active;
+    volatile uint8_t shadow_pending;
+    uint32_t dither_accumulator;
+    volatile uint32_t dither_tick_count;
+    volatile uint32_t dither_carry_count;
     uint8_t speed_pwm_duty_cycle;
-} SEN15901_context_t;
+    uint32_t wind_direction_degrees;
+    // Vane rotation.
+    volatile uint32_t wind_direction_velocity_dps;
+    volatile uint32_t wind_direction_mdeg;
+    volatile uint32_t wind_direction_target_mdeg;
+    // Rainfall timer lent to another driver.
+    uint8_t rainfall_suspended;
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+    // Wind speed pulses actually emitted by the timer.
+    SEN15901_pulse_model_t wind_pulses;
 #endif
+} SEN15901_context_t;
+
+/*** SEN15901 local functions declaration ***/
+
+static void _SEN15901_classic_init_direction(void);
+static void _SEN15901_classic_release_direction(void);
+static void _SEN15901_classic_stage_direction(void);
+static void _SEN15901_classic_apply_direction(void);
+static void _SEN15901_classic_commit(void);
+static void _SEN15901_ultimeter_init_direction(void);
+static void _SEN15901_ultimeter_release_direction(void);
+static void _SEN15901_ultimeter_stage_direction(void);
+static void _SEN15901_ultimeter_apply_direction(void);
+static void _SEN15901_ultimeter_commit(void);
+static void _SEN15901_dual_init_direction(void);
+static void _SEN15901_dual_release_direction(void);
+static void _SEN15901_dual_stage_direction(void);
+static void _SEN15901_dual_apply_direction(void);
+static void _SEN15901_dual_commit(void);
 
 /*** SEN15901 local global variables ***/
 
-#ifndef SEN15901_MODE_ULTIMETER
+static const SEN15901_personality_descriptor_t SEN15901_PERSONALITY[SEN15901_PERSONALITY_LAST] = {
+    {
+        SEN15901_CLASSIC_WIND_SPEED_1HZ_TO_MH,
+        SEN15901_CLASSIC_TICK_PERIOD_MS,
+        &TIM_GPIO_WIND_CLASSIC,
+        &_SEN15901_classic_init_direction,
+        &_SEN15901_classic_release_direction,
+        &_SEN15901_classic_stage_direction,
+        &_SEN15901_classic_apply_direction,
+        &_SEN15901_classic_commit
+    },
+    {
+        SEN15901_ULTIMETER_WIND_SPEED_1HZ_TO_MH,
+        SEN15901_ULTIMETER_TICK_PERIOD_MS,
+        &TIM_GPIO_WIND_ULTIMETER,
+        &_SEN15901_ultimeter_init_direction,
+        &_SEN15901_ultimeter_release_direction,
+        &_SEN15901_ultimeter_stage_direction,
+        &_SEN15901_ultimeter_apply_direction,
+        &_SEN15901_ultimeter_commit
+    },
+    {
+        SEN15901_ULTIMETER_WIND_SPEED_1HZ_TO_MH,
+        SEN15901_ULTIMETER_TICK_PERIOD_MS,
+        &TIM_GPIO_WIND_ULTIMETER,
+        &_SEN15901_dual_init_direction,
+        &_SEN15901_dual_release_direction,
+        &_SEN15901_dual_stage_direction,
+        &_SEN15901_dual_apply_direction,
+        &_SEN15901_dual_commit
+    }
+};
+
 static SEN15901_wind_direction_resistor_t SEN159001_WIND_DIRECTION_RESISTOR[SEN15901_WIND_DIRECTION_RESISTOR_NUMBER] = {
     { &GPIO_WIND_DIRECTION_N, 0, 0, 0 },
     { &GPIO_WIND_DIRECTION_NE, 45, 0, 0 },
@@ -63,32 +208,204 @@ static SEN15901_wind_direction_resistor_t SEN159001_WIND_DIRECTION_RESISTOR[SEN1
     { &GPIO_WIND_DIRECTION_W, 270, 0, 0 },
     { &GPIO_WIND_DIRECTION_NW, 315, 0, 0 },
 };
-#endif
 
-#ifdef SEN15901_MODE_ULTIMETER
+static GPIO_registers_t* const SEN15901_GPIO_PORT[SEN15901_GPIO_PORT_NUMBER] = { GPIOA, GPIOB };
+
 static SEN15901_context_t sen15901_ctx = {
-    .speed_pwm_frequency_mhz = SEN15901_PWM_FREQUENCY_MHZ_MIN,
-    .speed_pwm_duty_cycle = 0,
+    .descriptor = &(SEN15901_PERSONALITY[SEN15901_PERSONALITY_DEFAULT]),
+    .personality = SEN15901_PERSONALITY_DEFAULT
 };
-#endif
 
-/*** SEN15901 functions ***/
+/*** SEN15901 local functions ***/
 
 /*******************************************************************/
-SEN15901_status_t SEN15901_init(void) {
+static void _SEN15901_drive_gpio(const GPIO_pin_t* gpio, uint8_t state) {
+    // Output level is written before the pin is driven.
+    GPIO_write(gpio, state);
+    GPIO_configure(gpio, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
+}
+
+/*******************************************************************/
+static void _SEN15901_drive_tim_gpio(const TIM_gpio_t* tim_gpio) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Timer outputs are active high: idle level is low.
+    for (idx = 0; idx < (tim_gpio->list_size); idx++) {
+        _SEN15901_drive_gpio((tim_gpio->list[idx])->gpio, 0);
+    }
+}
+
+/*******************************************************************/
+static void _SEN15901_compute_speed_ccr(SEN15901_shadow_t* shadow, uint8_t speed_pwm_duty_cycle) {
     // Local variables.
-    SEN15901_status_t status = SEN15901_SUCCESS;
-    TIM_status_t tim_status = TIM_SUCCESS;
-#ifndef SEN15901_MODE_ULTIMETER
-    int32_t tmp_s32 = 0;
     uint8_t idx = 0;
+    // Compute compare value for both periods.
+    for (idx = 0; idx < SEN15901_DITHER_STATE_NUMBER; idx++) {
+        shadow->tim_ccr_speed[idx] = (((shadow->tim_period + idx) * speed_pwm_duty_cycle) / (MATH_PERCENT_MAX));
+    }
+}
+
+/*******************************************************************/
+static void _SEN15901_compute_wind_period(uint32_t wind_speed_ckmh, SEN15901_shadow_t* shadow) {
+    // Local variables.
+    uint64_t numerator = (sen15901_ctx.wind_period_numerator << 16);
+    uint64_t denominator = (10 * ((uint64_t) wind_speed_ckmh));
+    uint64_t cycles_q16 = 0;
+    uint64_t prescaler = 0;
+    uint64_t exact_q16 = 0;
+    uint64_t period_q16 = 0;
+    int64_t period_n = 0;
+    int64_t period_fraction_q16 = 0;
+    int64_t dither_q16 = 0;
+    int64_t error = 0;
+    // Idle state: no pulse and no update event until the next wind speed.
+    if (wind_speed_ckmh == 0) {
+        shadow->tim_psc = (SEN15901_WIND_PRESCALER_MAX - 1);
+        shadow->tim_period = SEN15901_WIND_PERIOD_MAX;
+        shadow->tim_period_dither_q16 = 0;
+        shadow->wind_speed_error_ppm = 0;
+        goto errors;
+    }
+    // Exact period in timer clock cycles (Q16 format).
+    cycles_q16 = ((numerator + (denominator >> 1)) / (denominator));
+    // Smallest prescaler keeping the period within the 16-bits ARR: N is at least 32768 counts when the clock is divided.
+    prescaler = (((cycles_q16 >> 16) / SEN15901_WIND_PERIOD_MAX) + 1);
+    if (prescaler > SEN15901_WIND_PRESCALER_MAX) {
+        prescaler = SEN15901_WIND_PRESCALER_MAX;
+    }
+    shadow->tim_psc = (uint32_t) (prescaler - 1);
+    // Exact period in prescaled counts (Q16 format).
+    exact_q16 = ((cycles_q16 + (prescaler >> 1)) / prescaler);
+    period_q16 = exact_q16;
+    if (period_q16 < (((uint64_t) SEN15901_WIND_PERIOD_MIN) << 16)) {
+        period_q16 = (((uint64_t) SEN15901_WIND_PERIOD_MIN) << 16);
+    }
+    if (period_q16 > (((uint64_t) SEN15901_WIND_PERIOD_MAX) << 16)) {
+        period_q16 = (((uint64_t) SEN15901_WIND_PERIOD_MAX) << 16);
+    }
+    shadow->tim_period = (uint32_t) (period_q16 >> 16);
+    period_n = (int64_t) shadow->tim_period;
+    period_fraction_q16 = (int64_t) (period_q16 & 0xFFFF);
+    // Ratio of (N + 1) ticks giving the exact average frequency (all ticks have the same duration): x = frac * (N + 1) / P.
+    shadow->tim_period_dither_q16 = (uint32_t) ((((uint64_t) period_fraction_q16 * (shadow->tim_period + 1)) << 16) / (period_q16));
+    dither_q16 = (int64_t) shadow->tim_period_dither_q16;
+    // Achieved average frequency is (2^16 * (N + 1) - x) / (2^16 * N * (N + 1)) and target frequency is (2^16 / P).
+    error = (((period_n + 1) * period_fraction_q16) - (dither_q16 * period_n) - ((dither_q16 * period_fraction_q16) >> 16));
+    error = ((error * MATH_POWER_10[6]) / ((period_n * (period_n + 1)) << 16));
+    // Speed out of the timer range: error of the clamped period (the fraction is null).
+    if (period_q16 != exact_q16) {
+        error = (((int64_t) exact_q16) - ((int64_t) period_q16));
+        // Avoid overflow.
+        if ((error < (((int64_t) 1) << 43)) && (error > (-(((int64_t) 1) << 43)))) {
+            error = ((error * MATH_POWER_10[6]) / ((int64_t) period_q16));
+        }
+        else {
+            error = (error / ((int64_t) (period_q16 / MATH_POWER_10[6])));
+        }
+    }
+    if (error > 0x7FFFFFFF) {
+        error = 0x7FFFFFFF;
+    }
+    if (error < (-0x7FFFFFFF)) {
+        error = (-0x7FFFFFFF);
+    }
+    shadow->wind_speed_error_ppm = (int32_t) error;
+errors:
+    return;
+}
+
+/*******************************************************************/
+RAMFUNC static uint8_t _SEN15901_activate_shadow(void) {
+    // Local variables.
+    uint8_t period_change = 0;
+    // Restart the emitted ticks statistics on wind speed change.
+    if ((sen15901_ctx.shadow.tim_period != sen15901_ctx.active.tim_period) || (sen15901_ctx.shadow.tim_period_dither_q16 != sen15901_ctx.active.tim_period_dither_q16)) {
+        sen15901_ctx.dither_tick_count = 0;
+        sen15901_ctx.dither_carry_count = 0;
+    }
+    // New counter clock or period has to be applied on the tick (by an update event) instead of the end of the current pulse.
+    if ((sen15901_ctx.shadow.tim_psc != sen15901_ctx.active.tim_psc) || (sen15901_ctx.shadow.tim_period != sen15901_ctx.active.tim_period)) {
+        period_change = 1;
+    }
+    sen15901_ctx.active = sen15901_ctx.shadow;
+    sen15901_ctx.shadow_pending = 0;
+    return period_change;
+}
+
+/*******************************************************************/
+RAMFUNC static uint32_t _SEN15901_modulate(void) {
+    // Local variables.
+    uint32_t carry = 0;
+    // First order sigma-delta modulator selecting N or (N + 1) counts for the whole next tick.
+    sen15901_ctx.dither_accumulator += sen15901_ctx.active.tim_period_dither_q16;
+    carry = (sen15901_ctx.dither_accumulator >> 16);
+    sen15901_ctx.dither_accumulator &= 0xFFFF;
+    // Emitted ticks statistics.
+    sen15901_ctx.dither_tick_count++;
+    sen15901_ctx.dither_carry_count += carry;
+    return carry;
+}
+
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+/*******************************************************************/
+RAMFUNC static void _SEN15901_advance_pulses(SEN15901_pulse_model_t* model, uint32_t counts) {
+    // Local variables.
+    uint32_t remaining = (model->period - model->phase);
+    // Current pulse is not completed.
+    if (counts < remaining) {
+        model->phase += counts;
+        goto errors;
+    }
+    // Preloaded registers are loaded by the update event, then the pulses are repeated (one rising edge at the start of each pulse).
+    counts -= remaining;
+    model->period = model->next_period;
+    model->high = model->next_high;
+    if (model->high != 0) {
+        model->pulse_count += ((counts / model->period) + 1);
+    }
+    model->phase = (counts % model->period);
+errors:
+    return;
+}
+
+/*******************************************************************/
+RAMFUNC static void _SEN15901_update_pulses(uint32_t carry, uint8_t period_change) {
+    // Local variables.
+    uint32_t prescaler = (sen15901_ctx.active.tim_psc + 1);
+    uint32_t period = ((sen15901_ctx.active.tim_period + carry) * prescaler);
+    uint32_t high = (sen15901_ctx.active.tim_ccr_speed[carry] * prescaler);
+    // Account the tick which has just ended.
+    _SEN15901_advance_pulses(&(sen15901_ctx.wind_pulses), (sen15901_ctx.descriptor->tick_period_ms * SEN15901_TIM_CYCLES_PER_MS));
+    sen15901_ctx.wind_pulses.next_period = period;
+    sen15901_ctx.wind_pulses.next_high = high;
+    if (period_change == 0) goto errors;
+    // Update event on the tick: the current pulse is cut and the new one starts now (rising edge only if the output was low).
+    if ((sen15901_ctx.wind_pulses.phase >= sen15901_ctx.wind_pulses.high) && (high != 0)) {
+        sen15901_ctx.wind_pulses.pulse_count++;
+    }
+    sen15901_ctx.wind_pulses.phase = 0;
+    sen15901_ctx.wind_pulses.period = period;
+    sen15901_ctx.wind_pulses.high = high;
+errors:
+    return;
+}
 #endif
-#ifdef SEN15901_MODE_ULTIMETER
-    // Init context.
-    sen15901_ctx.speed_pwm_frequency_mhz = SEN15901_PWM_FREQUENCY_MHZ_MIN;
-    sen15901_ctx.speed_pwm_duty_cycle = 0;
+
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+/*******************************************************************/
+RAMFUNC static uint32_t _SEN15901_get_capture_value(uint32_t counts) {
+    // Local variables.
+    uint32_t capture_ticks = (((counts * (sen15901_ctx.active.tim_psc + 1)) + (SEN15901_TIM_CYCLES_PER_CAPTURE_TICK >> 1)) / SEN15901_TIM_CYCLES_PER_CAPTURE_TICK);
+    // Longer pulses are saturated.
+    return ((capture_ticks > 0xFFFF) ? 0xFFFF : capture_ticks);
+}
 #endif
-#ifndef SEN15901_MODE_ULTIMETER
+
+/*******************************************************************/
+static void _SEN15901_classic_init_direction(void) {
+    // Local variables.
+    int32_t tmp_s32 = 0;
+    uint8_t idx = 0;
     // Init wind vane resistors.
     for (idx = 0; idx < SEN15901_WIND_DIRECTION_RESISTOR_NUMBER; idx++) {
         GPIO_configure(SEN159001_WIND_DIRECTION_RESISTOR[idx].gpio, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
@@ -99,10 +416,315 @@ SEN15901_status_t SEN15901_init(void) {
         tmp_s32 = SEN159001_WIND_DIRECTION_RESISTOR[idx].angle + SEN15901_WIND_DIRECTION_RESISTOR_RANGE_DEGREES;
         SEN159001_WIND_DIRECTION_RESISTOR[idx].angle_max = (tmp_s32 > MATH_2_PI_DEGREES) ? ((uint32_t) (tmp_s32 - MATH_2_PI_DEGREES)) : ((uint32_t) tmp_s32);
     }
+}
+
+/*******************************************************************/
+static void _SEN15901_classic_release_direction(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Release wind vane resistors.
+    for (idx = 0; idx < SEN15901_WIND_DIRECTION_RESISTOR_NUMBER; idx++) {
+        GPIO_configure(SEN159001_WIND_DIRECTION_RESISTOR[idx].gpio, GPIO_MODE_ANALOG, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
+    }
+}
+
+/*******************************************************************/
+static uint8_t _SEN15901_classic_get_resistor_state(uint8_t resistor_index, uint32_t wind_direction_degrees) {
+    // Local variables.
+    uint32_t angle_min = SEN159001_WIND_DIRECTION_RESISTOR[resistor_index].angle_min;
+    uint32_t angle_max = SEN159001_WIND_DIRECTION_RESISTOR[resistor_index].angle_max;
+    uint8_t state = 0;
+    // Check formula to apply.
+    if (angle_min < angle_max) {
+        // And condition.
+        state = (wind_direction_degrees > angle_min) && (wind_direction_degrees < angle_max) ? 1 : 0;
+    }
+    else {
+        // Or condition.
+        state = (wind_direction_degrees > angle_min) || (wind_direction_degrees < angle_max) ? 1 : 0;
+    }
+    return state;
+}
+
+/*******************************************************************/
+static void _SEN15901_classic_stage_direction(void) {
+    // Local variables.
+    const GPIO_pin_t* gpio = NULL;
+    uint32_t gpio_bsrr[SEN15901_GPIO_PORT_NUMBER] = { 0 };
+    uint8_t idx = 0;
+    uint8_t state = 0;
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+    uint8_t vane_mask = 0;
+#endif
+    // Compute required resistors.
+    for (idx = 0; idx < SEN15901_WIND_DIRECTION_RESISTOR_NUMBER; idx++) {
+        gpio = SEN159001_WIND_DIRECTION_RESISTOR[idx].gpio;
+        state = _SEN15901_classic_get_resistor_state(idx, sen15901_ctx.wind_direction_degrees);
+        // Set or reset bit.
+        gpio_bsrr[gpio->port_index] |= (0b1 << ((gpio->pin) + ((state == 0) ? 16 : 0)));
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+        vane_mask |= (state << idx);
+#endif
+    }
+    // Stage pins masks.
+    for (idx = 0; idx < SEN15901_GPIO_PORT_NUMBER; idx++) {
+        sen15901_ctx.shadow.gpio_bsrr[idx] = gpio_bsrr[idx];
+    }
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+    sen15901_ctx.shadow.vane_mask = vane_mask;
+#endif
+}
+
+/*******************************************************************/
+static void _SEN15901_classic_apply_direction(void) {
+    // Vane resistors are switched immediately, outside of the commit.
+    _SEN15901_classic_stage_direction();
+    sen15901_ctx.active.gpio_bsrr[0] = sen15901_ctx.shadow.gpio_bsrr[0];
+    sen15901_ctx.active.gpio_bsrr[1] = sen15901_ctx.shadow.gpio_bsrr[1];
+    SEN15901_GPIO_PORT[0]->BSRR = sen15901_ctx.active.gpio_bsrr[0];
+    SEN15901_GPIO_PORT[1]->BSRR = sen15901_ctx.active.gpio_bsrr[1];
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+    sen15901_ctx.active.vane_mask = sen15901_ctx.shadow.vane_mask;
+    CAPTURE_write(CAPTURE_SIGNAL_VANE, sen15901_ctx.active.vane_mask);
+#endif
+}
+
+/*******************************************************************/
+RAMFUNC static void _SEN15901_classic_commit(void) {
+    // Local variables.
+    uint32_t carry = 0;
+    uint8_t period_change = 0;
+    // Check staged values.
+    if (sen15901_ctx.shadow_pending != 0) {
+        period_change = _SEN15901_activate_shadow();
+        // Atomic write of all vane resistors of each port.
+        SEN15901_GPIO_PORT[0]->BSRR = sen15901_ctx.active.gpio_bsrr[0];
+        SEN15901_GPIO_PORT[1]->BSRR = sen15901_ctx.active.gpio_bsrr[1];
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+        CAPTURE_write(CAPTURE_SIGNAL_VANE, sen15901_ctx.active.vane_mask);
+#endif
+    }
+    // Select N or (N + 1) counts for the next tick.
+    carry = _SEN15901_modulate();
+    // Timer registers are preloaded: new values are taken into account on the next update event (pulse boundary).
+    // Update event is disabled during the writes so that a pulse boundary never loads a mixed set of registers.
+    TIM22->CR1 |= SEN15901_TIM_CR1_UDIS;
+    TIM22->PSC = sen15901_ctx.active.tim_psc;
+    TIM22->ARR = (sen15901_ctx.active.tim_period + carry - 1);
+    TIM22->CCR1 = sen15901_ctx.active.tim_ccr_speed[carry];
+    TIM22->CR1 &= ~(SEN15901_TIM_CR1_UDIS);
+    // New wind speed is applied on the tick instead of the end of the current pulse (up to one slow period later).
+    if (period_change != 0) {
+        TIM22->EGR = SEN15901_TIM_EGR_UG;
+    }
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+    _SEN15901_update_pulses(carry, period_change);
+#endif
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+    CAPTURE_write(CAPTURE_SIGNAL_WIND_SPEED, ((_SEN15901_get_capture_value(sen15901_ctx.active.tim_period + carry) << 16) | _SEN15901_get_capture_value(sen15901_ctx.active.tim_ccr_speed[carry])));
+    if (period_change != 0) {
+        CAPTURE_write(CAPTURE_SIGNAL_WIND_RESTART, 0);
+    }
+#endif
+}
+
+/*******************************************************************/
+static void _SEN15901_ultimeter_init_direction(void) {
+    // Direction channel is configured by the PWM driver.
+    sen15901_ctx.shadow.tim_ccr_direction[0] = 0;
+    sen15901_ctx.shadow.tim_ccr_direction[1] = 0;
+}
+
+/*******************************************************************/
+static void _SEN15901_ultimeter_release_direction(void) {
+    // Direction channel is released by the PWM driver.
+    return;
+}
+
+/*******************************************************************/
+static void _SEN15901_ultimeter_stage_direction(void) {
+    // Local variables.
+    uint8_t wind_direction_percent = 0;
+    uint8_t pwm_duty_cycle_percent = 0;
+    uint8_t idx = 0;
+    // Convert degrees to percent.
+    wind_direction_percent = ((sen15901_ctx.wind_direction_degrees * MATH_PERCENT_MAX) / (MATH_2_PI_DEGREES));
+    // Compute direction duty cycle.
+    if (sen15901_ctx.speed_pwm_duty_cycle > 0) {
+        pwm_duty_cycle_percent = ((sen15901_ctx.speed_pwm_duty_cycle + MATH_PERCENT_MAX - wind_direction_percent) % MATH_PERCENT_MAX);
+        // Avoid 0 case.
+        if (pwm_duty_cycle_percent == 0) {
+            pwm_duty_cycle_percent = 1;
+        }
+    }
+    for (idx = 0; idx < SEN15901_DITHER_STATE_NUMBER; idx++) {
+        sen15901_ctx.shadow.tim_ccr_direction[idx] = (((sen15901_ctx.shadow.tim_period + idx) * pwm_duty_cycle_percent) / (MATH_PERCENT_MAX));
+    }
+}
+
+/*******************************************************************/
+static void _SEN15901_ultimeter_apply_direction(void) {
+    // Direction is encoded in the pulses: new duty cycle is applied on next commit.
+    _SEN15901_ultimeter_stage_direction();
+    sen15901_ctx.shadow_pending = 1;
+}
+
+/*******************************************************************/
+RAMFUNC static void _SEN15901_ultimeter_commit(void) {
+    // Local variables.
+    uint32_t carry = 0;
+    uint8_t period_change = 0;
+    // Check staged values.
+    if (sen15901_ctx.shadow_pending != 0) {
+        period_change = _SEN15901_activate_shadow();
+    }
+    // Select N or (N + 1) counts for the next tick.
+    carry = _SEN15901_modulate();
+    // Timer registers are preloaded: new values are taken into account on the next update event (pulse boundary).
+    // Update event is disabled during the writes so that a pulse boundary never loads a mixed set of registers.
+    TIM22->CR1 |= SEN15901_TIM_CR1_UDIS;
+    TIM22->PSC = sen15901_ctx.active.tim_psc;
+    TIM22->ARR = (sen15901_ctx.active.tim_period + carry - 1);
+    TIM22->CCR1 = sen15901_ctx.active.tim_ccr_speed[carry];
+    TIM22->CCR2 = sen15901_ctx.active.tim_ccr_direction[carry];
+    TIM22->CR1 &= ~(SEN15901_TIM_CR1_UDIS);
+    // New wind speed is applied on the tick instead of the end of the current pulse (up to one slow period later).
+    if (period_change != 0) {
+        TIM22->EGR = SEN15901_TIM_EGR_UG;
+    }
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+    _SEN15901_update_pulses(carry, period_change);
+#endif
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+    CAPTURE_write(CAPTURE_SIGNAL_WIND_SPEED, ((_SEN15901_get_capture_value(sen15901_ctx.active.tim_period + carry) << 16) | _SEN15901_get_capture_value(sen15901_ctx.active.tim_ccr_speed[carry])));
+    CAPTURE_write(CAPTURE_SIGNAL_WIND_DIRECTION, ((_SEN15901_get_capture_value(sen15901_ctx.active.tim_period + carry) << 16) | _SEN15901_get_capture_value(sen15901_ctx.active.tim_ccr_direction[carry])));
+    if (period_change != 0) {
+        CAPTURE_write(CAPTURE_SIGNAL_WIND_RESTART, 0);
+    }
+#endif
+}
+
+/*******************************************************************/
+static void _SEN15901_dual_init_direction(void) {
+    // Both direction outputs.
+    _SEN15901_classic_init_direction();
+    _SEN15901_ultimeter_init_direction();
+}
+
+/*******************************************************************/
+static void _SEN15901_dual_release_direction(void) {
+    // Both direction outputs.
+    _SEN15901_classic_release_direction();
+    _SEN15901_ultimeter_release_direction();
+}
+
+/*******************************************************************/
+static void _SEN15901_dual_stage_direction(void) {
+    // Both outputs are computed from the same direction.
+    _SEN15901_classic_stage_direction();
+    _SEN15901_ultimeter_stage_direction();
+}
+
+/*******************************************************************/
+static void _SEN15901_dual_apply_direction(void) {
+    // Vane resistors follow the rotation on each sub-tick like the classic sensor, the Ultimeter pulses are updated on next commit.
+    _SEN15901_classic_apply_direction();
+    _SEN15901_ultimeter_apply_direction();
+}
+
+/*******************************************************************/
+RAMFUNC static void _SEN15901_dual_commit(void) {
+    // Staged vane resistors are switched just before the Ultimeter registers are preloaded.
+    if (sen15901_ctx.shadow_pending != 0) {
+        SEN15901_GPIO_PORT[0]->BSRR = sen15901_ctx.shadow.gpio_bsrr[0];
+        SEN15901_GPIO_PORT[1]->BSRR = sen15901_ctx.shadow.gpio_bsrr[1];
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+        CAPTURE_write(CAPTURE_SIGNAL_VANE, sen15901_ctx.shadow.vane_mask);
+#endif
+    }
+    _SEN15901_ultimeter_commit();
+}
+
+/*** SEN15901 functions ***/
+
+/*******************************************************************/
+void SEN15901_init_idle_outputs(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Vane resistors at the north position (state of the 0 degree direction set by SEN15901_init()).
+    for (idx = 0; idx < SEN15901_WIND_DIRECTION_RESISTOR_NUMBER; idx++) {
+        _SEN15901_drive_gpio(SEN159001_WIND_DIRECTION_RESISTOR[idx].gpio, ((SEN159001_WIND_DIRECTION_RESISTOR[idx].angle == 0) ? 1 : 0));
+    }
+    // Wind speed, Ultimeter direction and rainfall outputs until their timers take them over.
+    _SEN15901_drive_tim_gpio(&TIM_GPIO_WIND_ULTIMETER);
+    _SEN15901_drive_tim_gpio(&TIM_GPIO_RAINFALL);
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_init(SEN15901_personality_t personality) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    TIM_status_t tim_status = TIM_SUCCESS;
+    const TIM_gpio_t* tim_gpio_wind = NULL;
+    uint8_t idx = 0;
+    // Check parameter.
+    if (personality >= SEN15901_PERSONALITY_LAST) {
+        status = SEN15901_ERROR_PERSONALITY;
+        goto errors;
+    }
+    // Select personality.
+    sen15901_ctx.personality = personality;
+    sen15901_ctx.descriptor = &(SEN15901_PERSONALITY[personality]);
+    sen15901_ctx.wind_period_numerator = (((uint64_t) SEN15901_TIM_CLOCK_HZ) * sen15901_ctx.descriptor->wind_speed_1hz_to_mh);
+    tim_gpio_wind = sen15901_ctx.descriptor->tim_gpio_wind;
+    // Init context.
+    sen15901_ctx.wind_speed_ckmh = 0;
+    sen15901_ctx.shadow_pending = 0;
+    sen15901_ctx.dither_accumulator = 0;
+    sen15901_ctx.dither_tick_count = 0;
+    sen15901_ctx.dither_carry_count = 0;
+    sen15901_ctx.speed_pwm_duty_cycle = 0;
+    sen15901_ctx.wind_direction_degrees = 0;
+    sen15901_ctx.wind_direction_velocity_dps = 0;
+    sen15901_ctx.wind_direction_mdeg = 0;
+    sen15901_ctx.wind_direction_target_mdeg = 0;
+    sen15901_ctx.rainfall_suspended = 0;
+    // Release the idle outputs which are not used by the personality.
+    if (personality == SEN15901_PERSONALITY_CLASSIC) {
+        GPIO_configure((TIM_GPIO_WIND_ULTIMETER.list[TIM_CHANNEL_INDEX_WIND_DIRECTION])->gpio, GPIO_MODE_ANALOG, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
+    }
+    if (personality == SEN15901_PERSONALITY_ULTIMETER) {
+        _SEN15901_classic_release_direction();
+    }
+    _SEN15901_compute_wind_period(0, &(sen15901_ctx.shadow));
+    _SEN15901_compute_speed_ccr(&(sen15901_ctx.shadow), 0);
+    sen15901_ctx.descriptor->init_direction();
+    sen15901_ctx.descriptor->stage_direction();
+    sen15901_ctx.active = sen15901_ctx.shadow;
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+    // Timer is started with the idle period and without pulse.
+    sen15901_ctx.wind_pulses.pulse_count = 0;
+    sen15901_ctx.wind_pulses.phase = 0;
+    sen15901_ctx.wind_pulses.period = (sen15901_ctx.active.tim_period * (sen15901_ctx.active.tim_psc + 1));
+    sen15901_ctx.wind_pulses.high = 0;
+    sen15901_ctx.wind_pulses.next_period = sen15901_ctx.wind_pulses.period;
+    sen15901_ctx.wind_pulses.next_high = 0;
 #endif
     // Init PWM timer for wind speed.
-    tim_status = TIM_PWM_init(TIM_INSTANCE_WIND, (TIM_gpio_t*) &TIM_GPIO_WIND);
+    tim_status = TIM_PWM_init(TIM_INSTANCE_WIND, (TIM_gpio_t*) tim_gpio_wind);
     TIM_exit_error(SEN15901_ERROR_BASE_TIM_WIND);
+    // Let the driver enable the channels, then load the idle prescaler and period with preloaded registers (the prescaler of each speed is loaded by the commit).
+    for (idx = 0; idx < (tim_gpio_wind->list_size); idx++) {
+        tim_status = TIM_PWM_set_waveform(TIM_INSTANCE_WIND, (tim_gpio_wind->list[idx])->channel, (MATH_POWER_10[6] / sen15901_ctx.descriptor->wind_speed_1hz_to_mh), 50);
+        TIM_exit_error(SEN15901_ERROR_BASE_TIM_WIND);
+    }
+    TIM22->PSC = sen15901_ctx.active.tim_psc;
+    TIM22->ARR = (sen15901_ctx.active.tim_period - 1);
+    TIM22->CCR1 = 0;
+    TIM22->CCR2 = 0;
+    TIM22->CCMR1 |= (SEN15901_TIM_CCMR1_OC1PE | SEN15901_TIM_CCMR1_OC2PE);
+    TIM22->CR1 |= SEN15901_TIM_CR1_ARPE;
+    TIM22->EGR = SEN15901_TIM_EGR_UG;
     // Init OPM timer for rainfall.
     tim_status = TIM_OPM_init(TIM_INSTANCE_RAINFALL, (TIM_gpio_t*) &TIM_GPIO_RAINFALL);
     TIM_exit_error(SEN15901_ERROR_BASE_TIM_RAINFALL);
@@ -115,9 +737,12 @@ SEN15901_status_t SEN15901_de_init(void) {
     // Local variables.
     SEN15901_status_t status = SEN15901_SUCCESS;
     TIM_status_t tim_status = TIM_SUCCESS;
+    // Discard staged values.
+    sen15901_ctx.shadow_pending = 0;
     // Release PWM timer for wind speed.
-    tim_status = TIM_PWM_de_init(TIM_INSTANCE_WIND, (TIM_gpio_t*) &TIM_GPIO_WIND);
+    tim_status = TIM_PWM_de_init(TIM_INSTANCE_WIND, (TIM_gpio_t*) sen15901_ctx.descriptor->tim_gpio_wind);
     TIM_stack_error(ERROR_BASE_SEN15901 + SEN15901_ERROR_BASE_TIM_WIND);
+    sen15901_ctx.descriptor->release_direction();
     // Release OPM timer for rainfall.
     tim_status = TIM_OPM_de_init(TIM_INSTANCE_RAINFALL, (TIM_gpio_t*) &TIM_GPIO_RAINFALL);
     TIM_stack_error(ERROR_BASE_SEN15901 + SEN15901_ERROR_BASE_TIM_RAINFALL);
@@ -125,85 +750,242 @@ SEN15901_status_t SEN15901_de_init(void) {
 }
 
 /*******************************************************************/
-SEN15901_status_t SEN15901_set_wind_speed(uint32_t wind_speed_kmh) {
+SEN15901_personality_t SEN15901_get_personality(void) {
+    return (sen15901_ctx.personality);
+}
+
+/*******************************************************************/
+uint32_t SEN15901_get_tick_period_ms(void) {
+    return (sen15901_ctx.descriptor->tick_period_ms);
+}
+
+/*******************************************************************/
+uint32_t SEN15901_get_wind_speed_1hz_to_mh(void) {
+    return (sen15901_ctx.descriptor->wind_speed_1hz_to_mh);
+}
+
+/*******************************************************************/
+uint32_t SEN15901_get_classic_wind_speed_ckmh(void) {
+    // Classic anemometer factor applied to the emitted wind frequency.
+    return ((uint32_t) ((((uint64_t) sen15901_ctx.wind_speed_ckmh) * SEN15901_CLASSIC_WIND_SPEED_1HZ_TO_MH) / (sen15901_ctx.descriptor->wind_speed_1hz_to_mh)));
+}
+
+/*******************************************************************/
+SEN15901_commit_cb_t SEN15901_get_commit_callback(void) {
+    return (sen15901_ctx.descriptor->commit);
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_set_wind_speed(uint32_t wind_speed_ckmh) {
     // Local variables.
     SEN15901_status_t status = SEN15901_SUCCESS;
-    TIM_status_t tim_status = TIM_SUCCESS;
-    uint32_t pwm_frequency_mhz = 0;
-    uint8_t pwm_duty_cycle_percent = 50;
-    // Convert speed to PWM frequency.
-    pwm_frequency_mhz = (MATH_POWER_10[6] * wind_speed_kmh) / (SEN15901_WIND_SPEED_1HZ_TO_MH);
-    // Check frequency.
-    if (pwm_frequency_mhz == 0) {
-        // Disable output signal.
-        pwm_frequency_mhz = SEN15901_PWM_FREQUENCY_MHZ_MIN;
-        pwm_duty_cycle_percent = 0;
-    }
-#ifdef SEN15901_MODE_ULTIMETER
-    sen15901_ctx.speed_pwm_frequency_mhz = pwm_frequency_mhz;
-    sen15901_ctx.speed_pwm_duty_cycle = pwm_duty_cycle_percent;
-#endif
-    tim_status = TIM_PWM_set_waveform(TIM_INSTANCE_WIND, TIM_CHANNEL_WIND_SPEED, pwm_frequency_mhz, pwm_duty_cycle_percent);
-    TIM_exit_error(SEN15901_ERROR_BASE_TIM_WIND);
+    SEN15901_shadow_t speed;
+    uint8_t speed_pwm_duty_cycle = (wind_speed_ckmh == 0) ? 0 : 50;
+    uint8_t idx = 0;
+    uint32_t primask = 0;
+    // Compute registers values outside of the critical section.
+    _SEN15901_compute_wind_period(wind_speed_ckmh, &speed);
+    _SEN15901_compute_speed_ccr(&speed, speed_pwm_duty_cycle);
+    // Shadow is also staged by the vane rotation in timer interrupt.
+    IRQ_SAVE(primask);
+    sen15901_ctx.wind_speed_ckmh = wind_speed_ckmh;
+    sen15901_ctx.speed_pwm_duty_cycle = speed_pwm_duty_cycle;
+    sen15901_ctx.shadow.tim_psc = speed.tim_psc;
+    sen15901_ctx.shadow.tim_period = speed.tim_period;
+    sen15901_ctx.shadow.tim_period_dither_q16 = speed.tim_period_dither_q16;
+    sen15901_ctx.shadow.wind_speed_error_ppm = speed.wind_speed_error_ppm;
+    for (idx = 0; idx < SEN15901_DITHER_STATE_NUMBER; idx++) {
+        sen15901_ctx.shadow.tim_ccr_speed[idx] = speed.tim_ccr_speed[idx];
+    }
+    sen15901_ctx.descriptor->stage_direction();
+    sen15901_ctx.shadow_pending = 1;
+    IRQ_RESTORE(primask);
+    TRACE_write(TRACE_EVENT_WIND_SPEED, (uint16_t) (wind_speed_ckmh / SEN15901_WIND_SPEED_CKMH_PER_KMH));
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_get_wind_speed_error(int32_t* wind_speed_error_ppm) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t tim_period = 0;
+    uint32_t tim_period_dither_q16 = 0;
+    uint32_t tick_count = 0;
+    uint32_t carry_count = 0;
+    uint64_t carry_ratio_q16 = 0;
+    int64_t error = 0;
+    uint32_t primask = 0;
+    // Check parameter.
+    if (wind_speed_error_ppm == NULL) {
+        status = SEN15901_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Active values are updated by the commit in timer interrupt.
+    IRQ_SAVE(primask);
+    tim_period = sen15901_ctx.active.tim_period;
+    tim_period_dither_q16 = sen15901_ctx.active.tim_period_dither_q16;
+    error = (int64_t) sen15901_ctx.active.wind_speed_error_ppm;
+    tick_count = sen15901_ctx.dither_tick_count;
+    carry_count = sen15901_ctx.dither_carry_count;
+    IRQ_RESTORE(primask);
+    // Dithering is applied per tick: correct the long-term error with the ratio of (N + 1) ticks actually emitted.
+    if (tick_count != 0) {
+        carry_ratio_q16 = ((((uint64_t) carry_count) << 16) / tick_count);
+        error += (((((int64_t) tim_period_dither_q16) - ((int64_t) carry_ratio_q16)) * MATH_POWER_10[6]) / ((int64_t) ((((uint64_t) (tim_period + 1)) << 16) - tim_period_dither_q16)));
+    }
+    if (error > 0x7FFFFFFF) {
+        error = 0x7FFFFFFF;
+    }
+    if (error < (-0x7FFFFFFF)) {
+        error = (-0x7FFFFFFF);
+    }
+    (*wind_speed_error_ppm) = (int32_t) error;
 errors:
     return status;
 }
 
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+/*******************************************************************/
+RAMFUNC uint32_t SEN15901_get_wind_speed_pulse_count(uint32_t tick_offset_us) {
+    // Local variables.
+    SEN15901_pulse_model_t model;
+    uint32_t primask = 0;
+    // Model is updated by the commit in timer interrupt.
+    IRQ_SAVE(primask);
+    model = sen15901_ctx.wind_pulses;
+    IRQ_RESTORE(primask);
+    // Pulses started during the current tick.
+    _SEN15901_advance_pulses(&model, (tick_offset_us * SEN15901_TIM_CYCLES_PER_US));
+    return (model.pulse_count);
+}
+#endif
+
 /*******************************************************************/
 SEN15901_status_t SEN15901_set_wind_direction(uint32_t wind_direction_degrees) {
     // Local variables.
     SEN15901_status_t status = SEN15901_SUCCESS;
-#ifdef SEN15901_MODE_ULTIMETER
-    TIM_status_t tim_status = TIM_SUCCESS;
-    uint8_t wind_direction_percent = 0;
-    uint8_t pwm_duty_cycle_percent = 0;
-#else
-    uint8_t idx = 0;
-    uint32_t angle_min = 0;
-    uint32_t angle_max = 0;
-    uint8_t state = 0;
-#endif
+    uint32_t primask = 0;
     // Check parameter.
     if (wind_direction_degrees >= MATH_2_PI_DEGREES) {
         status = SEN15901_ERROR_WIND_DIRECTION;
         goto errors;
     }
-#ifdef SEN15901_MODE_ULTIMETER
-    // Convert degrees to percent.
-    wind_direction_percent = ((wind_direction_degrees * MATH_PERCENT_MAX) / (MATH_2_PI_DEGREES));
-    // Compute direction duty cycle.
-    if (sen15901_ctx.speed_pwm_duty_cycle > 0) {
-        pwm_duty_cycle_percent = ((sen15901_ctx.speed_pwm_duty_cycle + MATH_PERCENT_MAX - wind_direction_percent) % MATH_PERCENT_MAX);
-        // Avoid 0 case.
-        if (pwm_duty_cycle_percent == 0) {
-            pwm_duty_cycle_percent = 1;
-        }
+    // Rotation state and shadow are also updated in timer interrupt.
+    IRQ_SAVE(primask);
+    // Stop rotation.
+    sen15901_ctx.wind_direction_velocity_dps = 0;
+    sen15901_ctx.wind_direction_mdeg = (wind_direction_degrees * SEN15901_WIND_DIRECTION_MDEG_PER_DEGREE);
+    sen15901_ctx.wind_direction_target_mdeg = sen15901_ctx.wind_direction_mdeg;
+    // Stage direction output.
+    sen15901_ctx.wind_direction_degrees = wind_direction_degrees;
+    sen15901_ctx.descriptor->stage_direction();
+    sen15901_ctx.shadow_pending = 1;
+    IRQ_RESTORE(primask);
+    TRACE_write(TRACE_EVENT_WIND_DIRECTION, (uint16_t) wind_direction_degrees);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_set_wind_direction_target(uint32_t wind_direction_degrees, uint32_t velocity_dps) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t primask = 0;
+    // Check parameters.
+    if (wind_direction_degrees >= MATH_2_PI_DEGREES) {
+        status = SEN15901_ERROR_WIND_DIRECTION;
+        goto errors;
     }
-    // Set duty cycle.
-    tim_status = TIM_PWM_set_waveform(TIM_INSTANCE_WIND, TIM_CHANNEL_WIND_DIRECTION, sen15901_ctx.speed_pwm_frequency_mhz, pwm_duty_cycle_percent);
-    TIM_exit_error(SEN15901_ERROR_BASE_TIM_WIND);
-#else
-    // Activate required resistors.
-    for (idx = 0; idx < SEN15901_WIND_DIRECTION_RESISTOR_NUMBER; idx++) {
-        // Update variables.
-        angle_min = SEN159001_WIND_DIRECTION_RESISTOR[idx].angle_min;
-        angle_max = SEN159001_WIND_DIRECTION_RESISTOR[idx].angle_max;
-        // Check formula to apply.
-        if (angle_min < angle_max) {
-            // And condition.
-            state = (wind_direction_degrees > angle_min) && (wind_direction_degrees < angle_max) ? 1 : 0;
+    if (velocity_dps > SEN15901_WIND_DIRECTION_VELOCITY_DPS_MAX) {
+        status = SEN15901_ERROR_WIND_DIRECTION_VELOCITY;
+        goto errors;
+    }
+    // Instantaneous jump.
+    if (velocity_dps == 0) {
+        status = SEN15901_set_wind_direction(wind_direction_degrees);
+        goto errors;
+    }
+    // Rotation is started by the velocity update.
+    IRQ_SAVE(primask);
+    sen15901_ctx.wind_direction_target_mdeg = (wind_direction_degrees * SEN15901_WIND_DIRECTION_MDEG_PER_DEGREE);
+    sen15901_ctx.wind_direction_velocity_dps = velocity_dps;
+    IRQ_RESTORE(primask);
+    TRACE_write(TRACE_EVENT_WIND_DIRECTION, (uint16_t) wind_direction_degrees);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+uint8_t SEN15901_is_wind_direction_rotating(void) {
+    return (((sen15901_ctx.wind_direction_velocity_dps != 0) && (sen15901_ctx.wind_direction_mdeg != sen15901_ctx.wind_direction_target_mdeg)) ? 1 : 0);
+}
+
+/*******************************************************************/
+void SEN15901_rotate_wind_direction(uint32_t elapsed_us) {
+    // Local variables.
+    uint32_t position_mdeg = sen15901_ctx.wind_direction_mdeg;
+    uint32_t target_mdeg = sen15901_ctx.wind_direction_target_mdeg;
+    uint32_t distance_mdeg = 0;
+    uint32_t step_mdeg = 0;
+    uint32_t wind_direction_degrees = 0;
+    // Check state.
+    if ((sen15901_ctx.wind_direction_velocity_dps == 0) || (position_mdeg == target_mdeg)) goto errors;
+    // Angular step (velocity and elapsed time are bounded so that the product fits in 32 bits).
+    step_mdeg = ((sen15901_ctx.wind_direction_velocity_dps * elapsed_us) / (SEN15901_US_PER_MS));
+    // Clockwise distance to the target.
+    distance_mdeg = (target_mdeg >= position_mdeg) ? (target_mdeg - position_mdeg) : (target_mdeg + SEN15901_WIND_DIRECTION_MDEG_FULL_SCALE - position_mdeg);
+    if (distance_mdeg <= (SEN15901_WIND_DIRECTION_MDEG_FULL_SCALE >> 1)) {
+        // Clockwise rotation.
+        position_mdeg = (step_mdeg >= distance_mdeg) ? target_mdeg : (position_mdeg + step_mdeg);
+        if (position_mdeg >= SEN15901_WIND_DIRECTION_MDEG_FULL_SCALE) {
+            position_mdeg -= SEN15901_WIND_DIRECTION_MDEG_FULL_SCALE;
         }
-        else {
-            // Or condition.
-            state = (wind_direction_degrees > angle_min) || (wind_direction_degrees < angle_max) ? 1 : 0;
+    }
+    else {
+        // Counter-clockwise rotation.
+        distance_mdeg = (SEN15901_WIND_DIRECTION_MDEG_FULL_SCALE - distance_mdeg);
+        position_mdeg = (step_mdeg >= distance_mdeg) ? target_mdeg : ((position_mdeg >= step_mdeg) ? (position_mdeg - step_mdeg) : (position_mdeg + SEN15901_WIND_DIRECTION_MDEG_FULL_SCALE - step_mdeg));
+    }
+    sen15901_ctx.wind_direction_mdeg = position_mdeg;
+    // Update outputs only when the integer direction changes.
+    wind_direction_degrees = (position_mdeg / SEN15901_WIND_DIRECTION_MDEG_PER_DEGREE);
+    if (wind_direction_degrees == sen15901_ctx.wind_direction_degrees) goto errors;
+    sen15901_ctx.wind_direction_degrees = wind_direction_degrees;
+    sen15901_ctx.descriptor->apply_direction();
+errors:
+    return;
+}
+
+#ifdef SEN15901_EMULATOR_CHECK_INVARIANTS
+/*******************************************************************/
+SEN15901_status_t SEN15901_check_wind_direction(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    uint32_t wind_direction_degrees = 0;
+    uint32_t vane_mask = 0;
+    uint32_t rotated_mask = 0;
+    uint8_t resistor_count = 0;
+    uint8_t idx = 0;
+    // Resistors ranges are only used by the classic vane.
+    if (sen15901_ctx.personality == SEN15901_PERSONALITY_ULTIMETER) goto errors;
+    // Sweep all directions, including the wrap-around ranges of the north resistors.
+    for (wind_direction_degrees = 0; wind_direction_degrees < MATH_2_PI_DEGREES; wind_direction_degrees++) {
+        vane_mask = 0;
+        resistor_count = 0;
+        for (idx = 0; idx < SEN15901_WIND_DIRECTION_RESISTOR_NUMBER; idx++) {
+            vane_mask |= (_SEN15901_classic_get_resistor_state(idx, wind_direction_degrees) << idx);
+            resistor_count += ((vane_mask >> idx) & 0b1);
         }
-        // Write pin.
-        GPIO_write(SEN159001_WIND_DIRECTION_RESISTOR[idx].gpio, state);
+        // Valid combinations are one resistor or two adjacent resistors (circular mask).
+        rotated_mask = (((vane_mask >> 1) | (vane_mask << (SEN15901_WIND_DIRECTION_RESISTOR_NUMBER - 1))) & 0xFF);
+        if ((resistor_count == 1) || ((resistor_count == 2) && ((vane_mask & rotated_mask) != 0))) continue;
+        status = SEN15901_ERROR_WIND_DIRECTION_COMBINATION;
+        goto errors;
     }
-#endif
 errors:
     return status;
 }
+#endif
 
 /*******************************************************************/
 SEN15901_status_t SEN15901_make_rainfall_interrupt(void) {
@@ -211,9 +993,87 @@ SEN15901_status_t SEN15901_make_rainfall_interrupt(void) {
     SEN15901_status_t status = SEN15901_SUCCESS;
     TIM_status_t tim_status = TIM_SUCCESS;
     uint32_t pulse_duration_us = (SEN15901_RAINFALL_PULSE_DURATION_MS * MATH_POWER_10[3]);
+    // Check state.
+    if (sen15901_ctx.rainfall_suspended != 0) {
+        status = SEN15901_ERROR_RAINFALL_SUSPENDED;
+        goto errors;
+    }
     // Make pulse.
     tim_status = TIM_OPM_make_pulse(TIM_INSTANCE_RAINFALL, (0b1 << TIM_CHANNEL_RAINFALL), pulse_duration_us, pulse_duration_us, 0);
     TIM_exit_error(SEN15901_ERROR_BASE_TIM_RAINFALL);
+    TRACE_write(TRACE_EVENT_RAINFALL_PULSE, 0);
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+    CAPTURE_write(CAPTURE_SIGNAL_RAINFALL_PULSE, (((pulse_duration_us / CAPTURE_TICK_US) << 16) | (pulse_duration_us / CAPTURE_TICK_US)));
+#endif
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_set_rainfall_frequency(uint32_t rainfall_frequency_mhz) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    TIM_status_t tim_status = TIM_SUCCESS;
+    uint32_t half_period_us = 0;
+    // Check state.
+    if (sen15901_ctx.rainfall_suspended != 0) {
+        status = SEN15901_ERROR_RAINFALL_SUSPENDED;
+        goto errors;
+    }
+    // Stop request: let the current pulse complete by going back to one pulse mode.
+    if (rainfall_frequency_mhz == 0) {
+        TIM21->CR1 |= SEN15901_TIM_CR1_OPM;
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+        CAPTURE_write(CAPTURE_SIGNAL_RAINFALL_TRAIN, 0);
+#endif
+        goto errors;
+    }
+    // Check parameter.
+    half_period_us = (SEN15901_RAINFALL_HALF_PERIOD_NUMERATOR / rainfall_frequency_mhz);
+    if (half_period_us < SEN15901_RAINFALL_HALF_PERIOD_US_MIN) {
+        status = SEN15901_ERROR_RAINFALL_FREQUENCY;
+        goto errors;
+    }
+    // Restart the pulse generator with the new timings.
+    TIM21->CR1 &= ~(SEN15901_TIM_CR1_CEN);
+    tim_status = TIM_OPM_make_pulse(TIM_INSTANCE_RAINFALL, (0b1 << TIM_CHANNEL_RAINFALL), half_period_us, half_period_us, 0);
+    TIM_exit_error(SEN15901_ERROR_BASE_TIM_RAINFALL);
+    // Disable one pulse mode before the first update event so that the pulse is repeated.
+    TIM21->CR1 &= ~(SEN15901_TIM_CR1_OPM);
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+    CAPTURE_write(CAPTURE_SIGNAL_RAINFALL_TRAIN, half_period_us);
+#endif
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_suspend_rainfall(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    TIM_status_t tim_status = TIM_SUCCESS;
+    // Check state.
+    if (sen15901_ctx.rainfall_suspended != 0) goto errors;
+    // Release timer and hold the output at its idle level.
+    tim_status = TIM_OPM_de_init(TIM_INSTANCE_RAINFALL, (TIM_gpio_t*) &TIM_GPIO_RAINFALL);
+    TIM_exit_error(SEN15901_ERROR_BASE_TIM_RAINFALL);
+    _SEN15901_drive_tim_gpio(&TIM_GPIO_RAINFALL);
+    sen15901_ctx.rainfall_suspended = 1;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SEN15901_status_t SEN15901_resume_rainfall(void) {
+    // Local variables.
+    SEN15901_status_t status = SEN15901_SUCCESS;
+    TIM_status_t tim_status = TIM_SUCCESS;
+    // Check state.
+    if (sen15901_ctx.rainfall_suspended == 0) goto errors;
+    // Init OPM timer for rainfall again.
+    tim_status = TIM_OPM_init(TIM_INSTANCE_RAINFALL, (TIM_gpio_t*) &TIM_GPIO_RAINFALL);
+    TIM_exit_error(SEN15901_ERROR_BASE_TIM_RAINFALL);
+    sen15901_ctx.rainfall_suspended = 0;
 errors:
     return status;
 }
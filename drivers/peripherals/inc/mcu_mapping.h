@@ -34,9 +34,7 @@
  *******************************************************************/
 typedef enum {
     TIM_CHANNEL_INDEX_WIND_SPEED = 0,
-#ifdef SEN15901_MODE_ULTIMETER
     TIM_CHANNEL_INDEX_WIND_DIRECTION,
-#endif
     TIM_CHANNEL_INDEX_WIND_LAST
 } TIM_channel_index_wind_t;
 
@@ -56,7 +54,8 @@ extern const GPIO_pin_t GPIO_BATTERY_CHARGER_DISABLE;
 // TCXO power control.
 extern const GPIO_pin_t GPIO_TCXO_POWER_ENABLE;
 // Wind speed emulation.
-extern const TIM_gpio_t TIM_GPIO_WIND;
+extern const TIM_gpio_t TIM_GPIO_WIND_CLASSIC;
+extern const TIM_gpio_t TIM_GPIO_WIND_ULTIMETER;
 // Wind direction emulation.
 extern const GPIO_pin_t GPIO_WIND_DIRECTION_N;
 extern const GPIO_pin_t GPIO_WIND_DIRECTION_NE;
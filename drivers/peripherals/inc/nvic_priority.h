@@ -18,6 +18,8 @@ typedef enum {
     NVIC_PRIORITY_CLOCK_CALIBRATION = 1,
     NVIC_PRIORITY_SIMULATION_WAVEFORM_TIMER = 0,
     NVIC_PRIORITY_DUT_SYNCHRONIZATION = 1,
+    // Shares the EXTI4_15 vector with the DUT synchronization.
+    NVIC_PRIORITY_USB_DETECT = 1,
     NVIC_PRIORITY_DELAY = 2,
     NVIC_PRIORITY_RTC = 3,
     NVIC_PRIORITY_LOG_USART = 3
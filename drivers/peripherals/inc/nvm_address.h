@@ -0,0 +1,29 @@
+/*
+ * nvm_address.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __NVM_ADDRESS_H__
+#define __NVM_ADDRESS_H__
+
+/*** NVM ADDRESS macros ***/
+
+// Coverage checkpoint size (checked against COVERAGE_CHECKPOINT_SIZE_BYTES in the simulation).
+#define NVM_COVERAGE_SIZE_BYTES     449
+
+/*** NVM ADDRESS structures ***/
+
+/*!******************************************************************
+ * \enum NVM_address_t
+ * \brief NVM addresses mapping.
+ *******************************************************************/
+typedef enum {
+    NVM_ADDRESS_SEN15901_PERSONALITY_HEADER = 0,
+    NVM_ADDRESS_SEN15901_PERSONALITY,
+    NVM_ADDRESS_COVERAGE,
+    NVM_ADDRESS_LAST = (NVM_ADDRESS_COVERAGE + NVM_COVERAGE_SIZE_BYTES)
+} NVM_address_t;
+
+#endif /* __NVM_ADDRESS_H__ */
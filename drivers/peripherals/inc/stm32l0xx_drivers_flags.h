@@ -12,7 +12,7 @@
 
 #define STM32L0XX_DRIVERS_DMA_CHANNEL_MASK              0x00
 
-#define STM32L0XX_DRIVERS_EXTI_GPIO_MASK                0x0080
+#define STM32L0XX_DRIVERS_EXTI_GPIO_MASK                0x0180
 
 //#define STM32L0XX_DRIVERS_I2C_FAST_MODE
 
@@ -0,0 +1,88 @@
+/*
+ * boot.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __BOOT_H__
+#define __BOOT_H__
+
+#include "error.h"
+#include "rcc.h"
+#include "terminal.h"
+#include "types.h"
+
+/*** BOOT structures ***/
+
+/*!******************************************************************
+ * \enum BOOT_status_t
+ * \brief Boot phases timing error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    BOOT_SUCCESS = 0,
+    BOOT_ERROR_PHASE,
+    // Low level driver errors.
+    BOOT_ERROR_BASE_RCC = ERROR_BASE_STEP,
+    BOOT_ERROR_BASE_TERMINAL = (BOOT_ERROR_BASE_RCC + RCC_ERROR_BASE_LAST),
+    // Last base value.
+    BOOT_ERROR_BASE_LAST = (BOOT_ERROR_BASE_TERMINAL + TERMINAL_ERROR_BASE_LAST)
+} BOOT_status_t;
+
+/*!******************************************************************
+ * \enum BOOT_phase_t
+ * \brief Boot phases list (in execution order).
+ *******************************************************************/
+typedef enum {
+    BOOT_PHASE_CORE = 0,
+    BOOT_PHASE_SAFE_OUTPUTS,
+    BOOT_PHASE_HSI,
+    BOOT_PHASE_HSE,
+    BOOT_PHASE_SIMULATION,
+    BOOT_PHASE_FIRST_WAVEFORM,
+    BOOT_PHASE_CALIBRATION,
+    BOOT_PHASE_RTC,
+    BOOT_PHASE_LPTIM,
+    BOOT_PHASE_LAST
+} BOOT_phase_t;
+
+/*** BOOT functions ***/
+
+/*!******************************************************************
+ * \fn void BOOT_start(void)
+ * \brief Start boot phases timing (to be called first in main).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void BOOT_start(void);
+
+/*!******************************************************************
+ * \fn BOOT_status_t BOOT_end_phase(BOOT_phase_t phase)
+ * \brief Record the end of a boot phase (timing is stopped after the last phase).
+ * \param[in]   phase: Completed phase.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+BOOT_status_t BOOT_end_phase(BOOT_phase_t phase);
+
+/*!******************************************************************
+ * \fn BOOT_status_t BOOT_print(uint8_t terminal_instance)
+ * \brief Print boot phases timestamps (only once, after the last phase).
+ * \param[in]   terminal_instance: Terminal to use (must be opened by the caller).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+BOOT_status_t BOOT_print(uint8_t terminal_instance);
+
+/*******************************************************************/
+#define BOOT_exit_error(base) { ERROR_check_exit(boot_status, BOOT_SUCCESS, base) }
+
+/*******************************************************************/
+#define BOOT_stack_error(base) { ERROR_check_stack(boot_status, BOOT_SUCCESS, base) }
+
+/*******************************************************************/
+#define BOOT_stack_exit_error(base, code) { ERROR_check_stack_exit(boot_status, BOOT_SUCCESS, base, code) }
+
+#endif /* __BOOT_H__ */
@@ -0,0 +1,102 @@
+/*
+ * capture.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __CAPTURE_H__
+#define __CAPTURE_H__
+
+#include "error.h"
+#include "terminal.h"
+#include "types.h"
+
+/*** CAPTURE macros ***/
+
+// Timer values are recorded in 100us ticks.
+#define CAPTURE_TICK_US     100
+
+/*** CAPTURE structures ***/
+
+/*!******************************************************************
+ * \enum CAPTURE_status_t
+ * \brief Waveform capture driver error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    CAPTURE_SUCCESS = 0,
+    CAPTURE_ERROR_NULL_PARAMETER,
+    // Low level driver errors.
+    CAPTURE_ERROR_BASE_TERMINAL = ERROR_BASE_STEP,
+    // Last base value.
+    CAPTURE_ERROR_BASE_LAST = (CAPTURE_ERROR_BASE_TERMINAL + TERMINAL_ERROR_BASE_LAST)
+} CAPTURE_status_t;
+
+/*!******************************************************************
+ * \enum CAPTURE_signal_t
+ * \brief Captured signals list.
+ *******************************************************************/
+typedef enum {
+    // Value is ((period_ticks << 16) | high_ticks), applied from the next timer update event or from the next wind timer restart.
+    CAPTURE_SIGNAL_WIND_SPEED = 0,
+    CAPTURE_SIGNAL_WIND_DIRECTION,
+    // Value is the mask of the enabled vane resistors (bit 0 is north, clockwise).
+    CAPTURE_SIGNAL_VANE,
+    // Value is ((delay_ticks << 16) | high_ticks).
+    CAPTURE_SIGNAL_RAINFALL_PULSE,
+    // Value is the pulses train half period in us (0 when the train is stopped).
+    CAPTURE_SIGNAL_RAINFALL_TRAIN,
+    // Value is the input level.
+    CAPTURE_SIGNAL_SYNCHRO,
+    // Wind timer restarted on a new wind period (pulse in progress is cut), value is not used.
+    CAPTURE_SIGNAL_WIND_RESTART,
+    CAPTURE_SIGNAL_LAST
+} CAPTURE_signal_t;
+
+/*!******************************************************************
+ * \fn CAPTURE_get_timestamp_cb_t
+ * \brief Timestamp source callback (must be callable with interrupts disabled).
+ *******************************************************************/
+typedef uint32_t (*CAPTURE_get_timestamp_cb_t)(void);
+
+/*** CAPTURE functions ***/
+
+/*!******************************************************************
+ * \fn CAPTURE_status_t CAPTURE_init(CAPTURE_get_timestamp_cb_t get_timestamp_callback)
+ * \brief Init waveform capture ring.
+ * \param[in]   get_timestamp_callback: Function returning the current timestamp in us.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+CAPTURE_status_t CAPTURE_init(CAPTURE_get_timestamp_cb_t get_timestamp_callback);
+
+/*!******************************************************************
+ * \fn void CAPTURE_write(CAPTURE_signal_t signal, uint32_t value)
+ * \brief Record a new state of an output or input signal (interrupt safe, unchanged states are not recorded).
+ * \param[in]   signal: Signal to record.
+ * \param[in]   value: Signal state.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void CAPTURE_write(CAPTURE_signal_t signal, uint32_t value);
+
+/*!******************************************************************
+ * \fn CAPTURE_status_t CAPTURE_print(uint8_t terminal_instance)
+ * \brief Stream all records written since the previous call.
+ * \param[in]   terminal_instance: Terminal to use (must be opened by the caller).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+CAPTURE_status_t CAPTURE_print(uint8_t terminal_instance);
+
+/*******************************************************************/
+#define CAPTURE_exit_error(base) { ERROR_check_exit(capture_status, CAPTURE_SUCCESS, base) }
+
+/*******************************************************************/
+#define CAPTURE_stack_error(base) { ERROR_check_stack(capture_status, CAPTURE_SUCCESS, base) }
+
+/*******************************************************************/
+#define CAPTURE_stack_exit_error(base, code) { ERROR_check_stack_exit(capture_status, CAPTURE_SUCCESS, base, code) }
+
+#endif /* __CAPTURE_H__ */
@@ -0,0 +1,104 @@
+/*
+ * event_queue.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __EVENT_QUEUE_H__
+#define __EVENT_QUEUE_H__
+
+#include "error.h"
+#include "types.h"
+
+/*** EVENT QUEUE macros ***/
+
+// Must be a power of 2.
+#define EVENT_QUEUE_DEPTH       8
+
+/*** EVENT QUEUE structures ***/
+
+/*!******************************************************************
+ * \enum EVENT_QUEUE_status_t
+ * \brief Event queue driver error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    EVENT_QUEUE_SUCCESS = 0,
+    EVENT_QUEUE_ERROR_NULL_PARAMETER,
+    EVENT_QUEUE_ERROR_FULL,
+    EVENT_QUEUE_ERROR_EMPTY,
+    // Last base value.
+    EVENT_QUEUE_ERROR_BASE_LAST = ERROR_BASE_STEP
+} EVENT_QUEUE_status_t;
+
+/*!******************************************************************
+ * \struct EVENT_QUEUE_event_t
+ * \brief Timestamped event.
+ *******************************************************************/
+typedef struct {
+    uint32_t timestamp_ms;
+    uint32_t data;
+} EVENT_QUEUE_event_t;
+
+/*!******************************************************************
+ * \struct EVENT_QUEUE_t
+ * \brief Single producer single consumer event queue (each counter is only written by one side).
+ *******************************************************************/
+typedef struct {
+    EVENT_QUEUE_event_t events[EVENT_QUEUE_DEPTH];
+    volatile uint32_t write_count;
+    volatile uint32_t read_count;
+    volatile uint32_t overflow_count;
+} EVENT_QUEUE_t;
+
+/*** EVENT QUEUE functions ***/
+
+/*!******************************************************************
+ * \fn EVENT_QUEUE_status_t EVENT_QUEUE_init(EVENT_QUEUE_t* queue)
+ * \brief Empty a queue (to be called when no producer is running).
+ * \param[in]   queue: Pointer to the queue.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+EVENT_QUEUE_status_t EVENT_QUEUE_init(EVENT_QUEUE_t* queue);
+
+/*!******************************************************************
+ * \fn EVENT_QUEUE_status_t EVENT_QUEUE_push(EVENT_QUEUE_t* queue, uint32_t timestamp_ms, uint32_t data)
+ * \brief Add an event to a queue (producer side, lock free).
+ * \param[in]   queue: Pointer to the queue.
+ * \param[in]   timestamp_ms: Event timestamp in ms.
+ * \param[in]   data: Event data.
+ * \param[out]  none
+ * \retval      Function execution status (event is dropped and counted when the queue is full).
+ *******************************************************************/
+EVENT_QUEUE_status_t EVENT_QUEUE_push(EVENT_QUEUE_t* queue, uint32_t timestamp_ms, uint32_t data);
+
+/*!******************************************************************
+ * \fn EVENT_QUEUE_status_t EVENT_QUEUE_pop(EVENT_QUEUE_t* queue, EVENT_QUEUE_event_t* event)
+ * \brief Remove the oldest event of a queue (consumer side, lock free).
+ * \param[in]   queue: Pointer to the queue.
+ * \param[out]  event: Pointer to the removed event.
+ * \retval      Function execution status (EVENT_QUEUE_ERROR_EMPTY when there is no event).
+ *******************************************************************/
+EVENT_QUEUE_status_t EVENT_QUEUE_pop(EVENT_QUEUE_t* queue, EVENT_QUEUE_event_t* event);
+
+/*!******************************************************************
+ * \fn uint32_t EVENT_QUEUE_get_overflow_count(EVENT_QUEUE_t* queue)
+ * \brief Get the number of events dropped because the queue was full.
+ * \param[in]   queue: Pointer to the queue.
+ * \param[out]  none
+ * \retval      Number of dropped events since init.
+ *******************************************************************/
+uint32_t EVENT_QUEUE_get_overflow_count(EVENT_QUEUE_t* queue);
+
+/*******************************************************************/
+#define EVENT_QUEUE_exit_error(base) { ERROR_check_exit(event_queue_status, EVENT_QUEUE_SUCCESS, base) }
+
+/*******************************************************************/
+#define EVENT_QUEUE_stack_error(base) { ERROR_check_stack(event_queue_status, EVENT_QUEUE_SUCCESS, base) }
+
+/*******************************************************************/
+#define EVENT_QUEUE_stack_exit_error(base, code) { ERROR_check_stack_exit(event_queue_status, EVENT_QUEUE_SUCCESS, base, code) }
+
+#endif /* __EVENT_QUEUE_H__ */
@@ -0,0 +1,99 @@
+/*
+ * history.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __HISTORY_H__
+#define __HISTORY_H__
+
+#include "error.h"
+#include "terminal.h"
+#include "types.h"
+
+/*** HISTORY structures ***/
+
+/*!******************************************************************
+ * \enum HISTORY_status_t
+ * \brief History driver error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    HISTORY_SUCCESS = 0,
+    HISTORY_ERROR_NULL_PARAMETER,
+    HISTORY_ERROR_UNINITIALIZED,
+    // Low level driver errors.
+    HISTORY_ERROR_BASE_TERMINAL = ERROR_BASE_STEP,
+    // Last base value.
+    HISTORY_ERROR_BASE_LAST = (HISTORY_ERROR_BASE_TERMINAL + TERMINAL_ERROR_BASE_LAST)
+} HISTORY_status_t;
+
+/*!******************************************************************
+ * \struct HISTORY_record_t
+ * \brief Simulation values of one tick.
+ *******************************************************************/
+typedef struct {
+    uint32_t timestamp_ms;
+    uint32_t wind_speed_ckmh;
+    uint16_t wind_direction_degrees;
+    uint8_t rainfall_irq_count;
+    uint8_t synchro;
+} HISTORY_record_t;
+
+/*!******************************************************************
+ * \fn HISTORY_get_timestamp_cb_t
+ * \brief Timestamp source callback used to bound the replay duration.
+ *******************************************************************/
+typedef uint32_t (*HISTORY_get_timestamp_cb_t)(void);
+
+/*** HISTORY functions ***/
+
+/*!******************************************************************
+ * \fn HISTORY_status_t HISTORY_init(HISTORY_get_timestamp_cb_t get_timestamp_callback)
+ * \brief Init history ring.
+ * \param[in]   get_timestamp_callback: Function returning the current time in ms.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+HISTORY_status_t HISTORY_init(HISTORY_get_timestamp_cb_t get_timestamp_callback);
+
+/*!******************************************************************
+ * \fn HISTORY_status_t HISTORY_write(HISTORY_record_t* record)
+ * \brief Add a record to the history ring, overwriting the oldest one when full (main context only).
+ * \param[in]   record: Pointer to the record to add.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+HISTORY_status_t HISTORY_write(HISTORY_record_t* record);
+
+/*!******************************************************************
+ * \fn void HISTORY_start_replay(uint32_t record_count_max, uint32_t duration_max_ms)
+ * \brief Schedule the replay of the most recent records currently stored in the ring (a null count cancels the pending replay).
+ * \param[in]   record_count_max: Maximum number of records to replay.
+ * \param[in]   duration_max_ms: Duration after which the oldest pending records are skipped.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void HISTORY_start_replay(uint32_t record_count_max, uint32_t duration_max_ms);
+
+/*!******************************************************************
+ * \fn HISTORY_status_t HISTORY_print(uint8_t terminal_instance, uint32_t record_count)
+ * \brief Print the next records of the pending replay, oldest first. Once the replay duration is exhausted, the oldest pending records are skipped so that the newest ones are printed by this call.
+ * \param[in]   terminal_instance: Terminal to use (must be opened by the caller).
+ * \param[in]   record_count: Maximum number of records to print in this call.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+HISTORY_status_t HISTORY_print(uint8_t terminal_instance, uint32_t record_count);
+
+/*******************************************************************/
+#define HISTORY_exit_error(base) { ERROR_check_exit(history_status, HISTORY_SUCCESS, base) }
+
+/*******************************************************************/
+#define HISTORY_stack_error(base) { ERROR_check_stack(history_status, HISTORY_SUCCESS, base) }
+
+/*******************************************************************/
+#define HISTORY_stack_exit_error(base, code) { ERROR_check_stack_exit(history_status, HISTORY_SUCCESS, base, code) }
+
+#endif /* __HISTORY_H__ */
@@ -0,0 +1,33 @@
+/*
+ * irq.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __IRQ_H__
+#define __IRQ_H__
+
+#include "types.h"
+
+/*** IRQ macros ***/
+
+/*!******************************************************************
+ * \fn IRQ_SAVE(primask)
+ * \brief Save the interrupts mask and disable all maskable interrupts (nested sections restore the caller state).
+ * \param[in]   none
+ * \param[out]  primask: uint32_t variable receiving the previous interrupts mask.
+ * \retval      none
+ *******************************************************************/
+#define IRQ_SAVE(primask) { __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (primask) :: "memory"); }
+
+/*!******************************************************************
+ * \fn IRQ_RESTORE(primask)
+ * \brief Restore the interrupts mask saved by IRQ_SAVE().
+ * \param[in]   primask: Interrupts mask returned by IRQ_SAVE().
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+#define IRQ_RESTORE(primask) { __asm volatile ("msr primask, %0" :: "r" (primask) : "memory"); }
+
+#endif /* __IRQ_H__ */
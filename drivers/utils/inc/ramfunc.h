@@ -0,0 +1,24 @@
+/*
+ * ramfunc.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __RAMFUNC_H__
+#define __RAMFUNC_H__
+
+#include "sen15901_emulator_flags.h"
+
+/*** RAMFUNC macros ***/
+
+#ifdef SEN15901_EMULATOR_RAMFUNC
+// Code placed in a sub-section of the initialized data is copied from flash to RAM by the startup code.
+// Calls between flash and RAM are out of the branch range and go through veneers generated by the linker.
+// Callees which are not tagged (IRQ handlers and drivers of the submodules, libgcc helpers) remain executed from flash.
+#define RAMFUNC     __attribute__((section(".data.ramfunc"), noinline))
+#else
+#define RAMFUNC
+#endif
+
+#endif /* __RAMFUNC_H__ */
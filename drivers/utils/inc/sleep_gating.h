@@ -0,0 +1,33 @@
+/*
+ * sleep_gating.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SLEEP_GATING_H__
+#define __SLEEP_GATING_H__
+
+#include "types.h"
+
+/*** SLEEP GATING functions ***/
+
+/*!******************************************************************
+ * \fn void SLEEP_GATING_init(void)
+ * \brief Reduce the clocks of the idle periods (unused peripherals clocks are gated and flash is powered down in sleep mode).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void SLEEP_GATING_init(void);
+
+/*!******************************************************************
+ * \fn void SLEEP_GATING_de_init(void)
+ * \brief Restore the clocks configuration of the sleep mode.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void SLEEP_GATING_de_init(void);
+
+#endif /* __SLEEP_GATING_H__ */
@@ -0,0 +1,121 @@
+/*
+ * timebase.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TIMEBASE_H__
+#define __TIMEBASE_H__
+
+#include "error.h"
+#include "types.h"
+
+/*** TIMEBASE structures ***/
+
+/*!******************************************************************
+ * \enum TIMEBASE_status_t
+ * \brief Timebase driver error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    TIMEBASE_SUCCESS = 0,
+    TIMEBASE_ERROR_PERIOD,
+    // Last base value.
+    TIMEBASE_ERROR_BASE_LAST = ERROR_BASE_STEP
+} TIMEBASE_status_t;
+
+/*** TIMEBASE functions ***/
+
+/*!******************************************************************
+ * \fn void TIMEBASE_init(void)
+ * \brief Reset monotonic time to zero.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TIMEBASE_init(void);
+
+/*!******************************************************************
+ * \fn TIMEBASE_status_t TIMEBASE_start(uint32_t period_us)
+ * \brief Count time from the waveform timer (to be called once the timer is running).
+ * \param[in]   period_us: Timer interrupt period in us.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TIMEBASE_status_t TIMEBASE_start(uint32_t period_us);
+
+/*!******************************************************************
+ * \fn void TIMEBASE_stop(void)
+ * \brief Freeze time before the waveform timer is stopped.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TIMEBASE_stop(void);
+
+/*!******************************************************************
+ * \fn void TIMEBASE_period_elapsed(uint32_t next_period_us)
+ * \brief Account an elapsed timer period (to be called from the timer interrupt).
+ * \param[in]   next_period_us: Duration of the period which has just started in us.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TIMEBASE_period_elapsed(uint32_t next_period_us);
+
+/*!******************************************************************
+ * \fn void TIMEBASE_set_counter(uint32_t counter, uint32_t period_us)
+ * \brief Move the timer phase without time discontinuity (to be called with interrupts disabled).
+ * \param[in]   counter: New timer counter value, within the current period.
+ * \param[in]   period_us: Duration of the current period after the change in us.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TIMEBASE_set_counter(uint32_t counter, uint32_t period_us);
+
+/*!******************************************************************
+ * \fn void TIMEBASE_set_period(uint32_t period_us)
+ * \brief Change the duration of the current timer period (to be called with interrupts disabled, before the counter reaches the new end).
+ * \param[in]   period_us: Duration of the current period after the change in us.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TIMEBASE_set_period(uint32_t period_us);
+
+/*!******************************************************************
+ * \fn uint64_t TIMEBASE_get_time_us(void)
+ * \brief Read monotonic time (interrupt safe).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Time elapsed since init in us.
+ *******************************************************************/
+uint64_t TIMEBASE_get_time_us(void);
+
+/*!******************************************************************
+ * \fn uint32_t TIMEBASE_get_timestamp_us(void)
+ * \brief Read monotonic time truncated to 32 bits (interrupt safe).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Time elapsed since init in us, modulo 2^32.
+ *******************************************************************/
+uint32_t TIMEBASE_get_timestamp_us(void);
+
+/*!******************************************************************
+ * \fn uint32_t TIMEBASE_get_timestamp_ms(void)
+ * \brief Read monotonic time in milliseconds (interrupt safe).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Time elapsed since init in ms.
+ *******************************************************************/
+uint32_t TIMEBASE_get_timestamp_ms(void);
+
+/*******************************************************************/
+#define TIMEBASE_exit_error(base) { ERROR_check_exit(timebase_status, TIMEBASE_SUCCESS, base) }
+
+/*******************************************************************/
+#define TIMEBASE_stack_error(base) { ERROR_check_stack(timebase_status, TIMEBASE_SUCCESS, base) }
+
+/*******************************************************************/
+#define TIMEBASE_stack_exit_error(base, code) { ERROR_check_stack_exit(timebase_status, TIMEBASE_SUCCESS, base, code) }
+
+#endif /* __TIMEBASE_H__ */
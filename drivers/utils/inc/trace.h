@@ -0,0 +1,105 @@
+/*
+ * trace.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include "error.h"
+#include "terminal.h"
+#include "types.h"
+
+/*** TRACE structures ***/
+
+/*!******************************************************************
+ * \enum TRACE_status_t
+ * \brief Trace driver error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    TRACE_SUCCESS = 0,
+    TRACE_ERROR_NULL_PARAMETER,
+    // Low level driver errors.
+    TRACE_ERROR_BASE_TERMINAL = ERROR_BASE_STEP,
+    // Last base value.
+    TRACE_ERROR_BASE_LAST = (TRACE_ERROR_BASE_TERMINAL + TERMINAL_ERROR_BASE_LAST)
+} TRACE_status_t;
+
+/*!******************************************************************
+ * \enum TRACE_event_t
+ * \brief Trace events list.
+ *******************************************************************/
+typedef enum {
+    TRACE_EVENT_SYNCHRO_ACCEPTED = 0,
+    TRACE_EVENT_SYNCHRO_FILTERED,
+    TRACE_EVENT_SYNCHRO_COMMAND,
+    TRACE_EVENT_SYNCHRO_EARLY,
+    TRACE_EVENT_SYNCHRO_MISSED,
+    TRACE_EVENT_TICK,
+    TRACE_EVENT_WIND_SPEED,
+    TRACE_EVENT_WIND_DIRECTION,
+    TRACE_EVENT_RAINFALL_PULSE,
+    TRACE_EVENT_LOG_START,
+    TRACE_EVENT_LOG_END,
+    TRACE_EVENT_ERROR,
+    TRACE_EVENT_LAST
+} TRACE_event_t;
+
+/*!******************************************************************
+ * \fn TRACE_get_timestamp_cb_t
+ * \brief Timestamp source callback (must be callable with interrupts disabled).
+ *******************************************************************/
+typedef uint32_t (*TRACE_get_timestamp_cb_t)(void);
+
+/*** TRACE functions ***/
+
+/*!******************************************************************
+ * \fn TRACE_status_t TRACE_init(TRACE_get_timestamp_cb_t get_timestamp_callback)
+ * \brief Init trace ring.
+ * \param[in]   get_timestamp_callback: Function returning the current timestamp in ms.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TRACE_status_t TRACE_init(TRACE_get_timestamp_cb_t get_timestamp_callback);
+
+/*!******************************************************************
+ * \fn void TRACE_write(TRACE_event_t event, uint16_t data)
+ * \brief Add a timestamped record to the trace ring (interrupt safe).
+ * \param[in]   event: Event to record.
+ * \param[in]   data: Event data.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TRACE_write(TRACE_event_t event, uint16_t data);
+
+/*!******************************************************************
+ * \fn void TRACE_write_error(ERROR_code_t code)
+ * \brief Add a timestamped error record to the trace ring, with the base of the failing driver and its status (interrupt safe).
+ * \param[in]   code: Error code (base + status).
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void TRACE_write_error(ERROR_code_t code);
+
+/*!******************************************************************
+ * \fn TRACE_status_t TRACE_print(uint8_t terminal_instance)
+ * \brief Print all records written since the previous call.
+ * \param[in]   terminal_instance: Terminal to use (must be opened by the caller).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+TRACE_status_t TRACE_print(uint8_t terminal_instance);
+
+/*******************************************************************/
+#define TRACE_exit_error(base) { ERROR_check_exit(trace_status, TRACE_SUCCESS, base) }
+
+/*******************************************************************/
+#define TRACE_stack_error(base) { ERROR_check_stack(trace_status, TRACE_SUCCESS, base) }
+
+/*******************************************************************/
+#define TRACE_stack_exit_error(base, code) { ERROR_check_stack_exit(trace_status, TRACE_SUCCESS, base, code) }
+
+#endif /* __TRACE_H__ */
@@ -0,0 +1,131 @@
+/*
+ * boot.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "boot.h"
+
+#include "error.h"
+#include "rcc.h"
+#include "terminal.h"
+#include "types.h"
+
+/*** BOOT local macros ***/
+
+// SysTick is used as free running down counter clocked by HCLK/8 (no interrupt).
+#define BOOT_SYSTICK_CSR            (*((volatile uint32_t*) 0xE000E010))
+#define BOOT_SYSTICK_RVR            (*((volatile uint32_t*) 0xE000E014))
+#define BOOT_SYSTICK_CVR            (*((volatile uint32_t*) 0xE000E018))
+
+#define BOOT_SYSTICK_CSR_ENABLE     (0b1 << 0)
+#define BOOT_SYSTICK_COUNTER_MASK   0x00FFFFFF
+#define BOOT_SYSTICK_PRESCALER      8
+
+#define BOOT_US_PER_S               1000000
+
+#define BOOT_LINE_END               "\r\n"
+
+/*** BOOT local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t systick_previous;
+    uint32_t timestamp_us[BOOT_PHASE_LAST];
+    BOOT_phase_t next_phase;
+    uint8_t printed;
+} BOOT_context_t;
+
+/*** BOOT local global variables ***/
+
+static const char_t* const BOOT_PHASE_NAME[BOOT_PHASE_LAST] = {
+    "core",
+    "safe_outputs",
+    "hsi",
+    "hse",
+    "simulation",
+    "first_waveform",
+    "calibration",
+    "rtc",
+    "lptim"
+};
+
+static BOOT_context_t boot_ctx = {
+    .systick_previous = BOOT_SYSTICK_COUNTER_MASK,
+    .next_phase = BOOT_PHASE_LAST,
+    .printed = 0
+};
+
+/*** BOOT functions ***/
+
+/*******************************************************************/
+void BOOT_start(void) {
+    // Start counter from its maximum value.
+    BOOT_SYSTICK_CSR = 0;
+    BOOT_SYSTICK_RVR = BOOT_SYSTICK_COUNTER_MASK;
+    BOOT_SYSTICK_CVR = 0;
+    BOOT_SYSTICK_CSR = BOOT_SYSTICK_CSR_ENABLE;
+    boot_ctx.systick_previous = BOOT_SYSTICK_COUNTER_MASK;
+    boot_ctx.next_phase = BOOT_PHASE_CORE;
+    boot_ctx.printed = 0;
+}
+
+/*******************************************************************/
+BOOT_status_t BOOT_end_phase(BOOT_phase_t phase) {
+    // Local variables.
+    BOOT_status_t status = BOOT_SUCCESS;
+    RCC_status_t rcc_status = RCC_SUCCESS;
+    uint32_t systick = BOOT_SYSTICK_CVR;
+    uint32_t elapsed_ticks = ((boot_ctx.systick_previous - systick) & BOOT_SYSTICK_COUNTER_MASK);
+    uint32_t sysclk_frequency_hz = 0;
+    uint32_t previous_us = 0;
+    // Check parameter.
+    if (phase != boot_ctx.next_phase) {
+        status = BOOT_ERROR_PHASE;
+        goto errors;
+    }
+    boot_ctx.systick_previous = systick;
+    // Phase duration is converted with the clock selected at the end of the phase (a phase must not exceed one counter period).
+    rcc_status = RCC_get_frequency_hz(RCC_CLOCK_SYSTEM, &sysclk_frequency_hz);
+    RCC_exit_error(BOOT_ERROR_BASE_RCC);
+    previous_us = (phase == BOOT_PHASE_CORE) ? 0 : boot_ctx.timestamp_us[phase - 1];
+    boot_ctx.timestamp_us[phase] = previous_us + (uint32_t) ((((uint64_t) elapsed_ticks) * BOOT_SYSTICK_PRESCALER * BOOT_US_PER_S) / ((uint64_t) sysclk_frequency_hz));
+errors:
+    // Stop counter after the last phase or on error.
+    boot_ctx.next_phase = (status == BOOT_SUCCESS) ? (phase + 1) : BOOT_PHASE_LAST;
+    if (boot_ctx.next_phase >= BOOT_PHASE_LAST) {
+        BOOT_SYSTICK_CSR = 0;
+    }
+    return status;
+}
+
+/*******************************************************************/
+BOOT_status_t BOOT_print(uint8_t terminal_instance) {
+    // Local variables.
+    BOOT_status_t status = BOOT_SUCCESS;
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    uint8_t idx = 0;
+    // Check state.
+    if ((boot_ctx.printed != 0) || (boot_ctx.next_phase < BOOT_PHASE_LAST)) goto errors;
+    boot_ctx.printed = 1;
+    // Phases loop.
+    for (idx = 0; idx < BOOT_PHASE_LAST; idx++) {
+        terminal_status = TERMINAL_flush_tx_buffer(terminal_instance);
+        TERMINAL_exit_error(BOOT_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "Boot_");
+        TERMINAL_exit_error(BOOT_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, (char_t*) BOOT_PHASE_NAME[idx]);
+        TERMINAL_exit_error(BOOT_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "=");
+        TERMINAL_exit_error(BOOT_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) boot_ctx.timestamp_us[idx], STRING_FORMAT_DECIMAL, 0);
+        TERMINAL_exit_error(BOOT_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "us" BOOT_LINE_END);
+        TERMINAL_exit_error(BOOT_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_send_tx_buffer(terminal_instance);
+        TERMINAL_exit_error(BOOT_ERROR_BASE_TERMINAL);
+    }
+errors:
+    return status;
+}
@@ -0,0 +1,173 @@
+/*
+ * capture.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "capture.h"
+
+#include "error.h"
+#include "irq.h"
+#include "terminal.h"
+#include "types.h"
+
+/*** CAPTURE local macros ***/
+
+// Must be a power of 2.
+#define CAPTURE_DEPTH           128
+#define CAPTURE_INDEX_MASK      (CAPTURE_DEPTH - 1)
+
+#define CAPTURE_LINE_END        "\r\n"
+
+/*** CAPTURE local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t timestamp_us;
+    uint32_t value;
+    uint8_t signal;
+} CAPTURE_record_t;
+
+/*******************************************************************/
+typedef struct {
+    CAPTURE_get_timestamp_cb_t get_timestamp_callback;
+    CAPTURE_record_t records[CAPTURE_DEPTH];
+    uint32_t last_value[CAPTURE_SIGNAL_LAST];
+    uint32_t last_value_valid_mask;
+    volatile uint32_t write_count;
+    uint32_t read_count;
+    uint32_t lost_count;
+} CAPTURE_context_t;
+
+/*** CAPTURE local global variables ***/
+
+static const char_t* const CAPTURE_SIGNAL_NAME[CAPTURE_SIGNAL_LAST] = {
+    "wind_speed",
+    "wind_direction",
+    "vane",
+    "rainfall_pulse",
+    "rainfall_train",
+    "synchro",
+    "wind_restart"
+};
+
+// Events which are recorded even if the value did not change.
+static const uint32_t CAPTURE_SIGNAL_EVENT_MASK = ((0b1 << CAPTURE_SIGNAL_RAINFALL_PULSE) | (0b1 << CAPTURE_SIGNAL_SYNCHRO) | (0b1 << CAPTURE_SIGNAL_WIND_RESTART));
+
+static CAPTURE_context_t capture_ctx = {
+    .get_timestamp_callback = NULL,
+    .last_value_valid_mask = 0,
+    .write_count = 0,
+    .read_count = 0,
+    .lost_count = 0
+};
+
+/*** CAPTURE functions ***/
+
+/*******************************************************************/
+CAPTURE_status_t CAPTURE_init(CAPTURE_get_timestamp_cb_t get_timestamp_callback) {
+    // Local variables.
+    CAPTURE_status_t status = CAPTURE_SUCCESS;
+    // Check parameter.
+    if (get_timestamp_callback == NULL) {
+        status = CAPTURE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Reset context.
+    capture_ctx.get_timestamp_callback = get_timestamp_callback;
+    capture_ctx.last_value_valid_mask = 0;
+    capture_ctx.write_count = 0;
+    capture_ctx.read_count = 0;
+    capture_ctx.lost_count = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+void CAPTURE_write(CAPTURE_signal_t signal, uint32_t value) {
+    // Local variables.
+    CAPTURE_record_t* record = NULL;
+    uint32_t signal_bit = (0b1 << signal);
+    uint32_t primask = 0;
+    // Check driver state.
+    if ((capture_ctx.get_timestamp_callback == NULL) || (signal >= CAPTURE_SIGNAL_LAST)) return;
+    IRQ_SAVE(primask);
+    // Skip unchanged states.
+    if (((CAPTURE_SIGNAL_EVENT_MASK & signal_bit) == 0) && ((capture_ctx.last_value_valid_mask & signal_bit) != 0) && (capture_ctx.last_value[signal] == value)) goto end;
+    capture_ctx.last_value[signal] = value;
+    capture_ctx.last_value_valid_mask |= signal_bit;
+    // Fill slot.
+    record = &(capture_ctx.records[capture_ctx.write_count & CAPTURE_INDEX_MASK]);
+    record->timestamp_us = capture_ctx.get_timestamp_callback();
+    record->value = value;
+    record->signal = (uint8_t) signal;
+    capture_ctx.write_count++;
+end:
+    IRQ_RESTORE(primask);
+}
+
+/*******************************************************************/
+CAPTURE_status_t CAPTURE_print(uint8_t terminal_instance) {
+    // Local variables.
+    CAPTURE_status_t status = CAPTURE_SUCCESS;
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    CAPTURE_record_t record;
+    uint32_t primask = 0;
+    uint32_t write_count = 0;
+    uint8_t record_valid = 0;
+    // Records loop.
+    while (1) {
+        // Copy next record atomically.
+        IRQ_SAVE(primask);
+        write_count = capture_ctx.write_count;
+        // Skip overwritten records.
+        if ((write_count - capture_ctx.read_count) > CAPTURE_DEPTH) {
+            capture_ctx.lost_count += (write_count - capture_ctx.read_count - CAPTURE_DEPTH);
+            capture_ctx.read_count = (write_count - CAPTURE_DEPTH);
+        }
+        record_valid = (capture_ctx.read_count != write_count) ? 1 : 0;
+        if (record_valid != 0) {
+            record = capture_ctx.records[capture_ctx.read_count & CAPTURE_INDEX_MASK];
+            capture_ctx.read_count++;
+        }
+        IRQ_RESTORE(primask);
+        // Exit when the ring is empty.
+        if (record_valid == 0) break;
+        // Print record.
+        terminal_status = TERMINAL_flush_tx_buffer(terminal_instance);
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "Capture=");
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) record.timestamp_us, STRING_FORMAT_DECIMAL, 0);
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "us;");
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, (char_t*) ((record.signal < CAPTURE_SIGNAL_LAST) ? CAPTURE_SIGNAL_NAME[record.signal] : "unknown"));
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, ";");
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) record.value, STRING_FORMAT_HEXADECIMAL, 1);
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, CAPTURE_LINE_END);
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_send_tx_buffer(terminal_instance);
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+    }
+    // Report overflow.
+    if (capture_ctx.lost_count != 0) {
+        terminal_status = TERMINAL_flush_tx_buffer(terminal_instance);
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "Capture_lost=");
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) capture_ctx.lost_count, STRING_FORMAT_DECIMAL, 0);
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, CAPTURE_LINE_END);
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_send_tx_buffer(terminal_instance);
+        TERMINAL_exit_error(CAPTURE_ERROR_BASE_TERMINAL);
+        capture_ctx.lost_count = 0;
+    }
+errors:
+    return status;
+}
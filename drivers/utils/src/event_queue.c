@@ -0,0 +1,97 @@
+/*
+ * event_queue.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "event_queue.h"
+
+#include "error.h"
+#include "ramfunc.h"
+#include "types.h"
+
+/*** EVENT QUEUE local macros ***/
+
+#define EVENT_QUEUE_INDEX_MASK      (EVENT_QUEUE_DEPTH - 1)
+
+// Slot accesses must not be moved across the counter update (single core: no hardware barrier needed).
+#define EVENT_QUEUE_BARRIER() { __asm volatile ("" ::: "memory"); }
+
+/*** EVENT QUEUE functions ***/
+
+/*******************************************************************/
+EVENT_QUEUE_status_t EVENT_QUEUE_init(EVENT_QUEUE_t* queue) {
+    // Local variables.
+    EVENT_QUEUE_status_t status = EVENT_QUEUE_SUCCESS;
+    // Check parameter.
+    if (queue == NULL) {
+        status = EVENT_QUEUE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Reset counters.
+    queue->write_count = 0;
+    queue->read_count = 0;
+    queue->overflow_count = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+RAMFUNC EVENT_QUEUE_status_t EVENT_QUEUE_push(EVENT_QUEUE_t* queue, uint32_t timestamp_ms, uint32_t data) {
+    // Local variables.
+    EVENT_QUEUE_status_t status = EVENT_QUEUE_SUCCESS;
+    EVENT_QUEUE_event_t* event = NULL;
+    uint32_t write_count = 0;
+    // Check parameter.
+    if (queue == NULL) {
+        status = EVENT_QUEUE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Read counter can only increase meanwhile: the free space is never overestimated.
+    write_count = queue->write_count;
+    if ((write_count - queue->read_count) >= EVENT_QUEUE_DEPTH) {
+        queue->overflow_count++;
+        status = EVENT_QUEUE_ERROR_FULL;
+        goto errors;
+    }
+    event = &(queue->events[write_count & EVENT_QUEUE_INDEX_MASK]);
+    event->timestamp_ms = timestamp_ms;
+    event->data = data;
+    // Publish the slot.
+    EVENT_QUEUE_BARRIER();
+    queue->write_count = (write_count + 1);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+EVENT_QUEUE_status_t EVENT_QUEUE_pop(EVENT_QUEUE_t* queue, EVENT_QUEUE_event_t* event) {
+    // Local variables.
+    EVENT_QUEUE_status_t status = EVENT_QUEUE_SUCCESS;
+    uint32_t read_count = 0;
+    // Check parameters.
+    if ((queue == NULL) || (event == NULL)) {
+        status = EVENT_QUEUE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Write counter can only increase meanwhile: a published slot is complete.
+    read_count = queue->read_count;
+    if (read_count == queue->write_count) {
+        status = EVENT_QUEUE_ERROR_EMPTY;
+        goto errors;
+    }
+    EVENT_QUEUE_BARRIER();
+    (*event) = queue->events[read_count & EVENT_QUEUE_INDEX_MASK];
+    // Release the slot.
+    EVENT_QUEUE_BARRIER();
+    queue->read_count = (read_count + 1);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+uint32_t EVENT_QUEUE_get_overflow_count(EVENT_QUEUE_t* queue) {
+    // Check parameter.
+    return ((queue == NULL) ? 0 : queue->overflow_count);
+}
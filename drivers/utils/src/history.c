@@ -0,0 +1,176 @@
+/*
+ * history.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "history.h"
+
+#include "error.h"
+#include "terminal.h"
+#include "types.h"
+
+/*** HISTORY local macros ***/
+
+// Must be a power of 2.
+#define HISTORY_DEPTH           64
+#define HISTORY_INDEX_MASK      (HISTORY_DEPTH - 1)
+
+#define HISTORY_LINE_END        "\r\n"
+
+/*** HISTORY local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    HISTORY_get_timestamp_cb_t get_timestamp_callback;
+    HISTORY_record_t records[HISTORY_DEPTH];
+    uint32_t write_count;
+    uint32_t replay_count;
+    uint32_t replay_end_count;
+    uint32_t replay_start_ms;
+    uint32_t replay_duration_max_ms;
+} HISTORY_context_t;
+
+/*** HISTORY local global variables ***/
+
+static HISTORY_context_t history_ctx = {
+    .get_timestamp_callback = NULL,
+    .write_count = 0,
+    .replay_count = 0,
+    .replay_end_count = 0,
+    .replay_start_ms = 0,
+    .replay_duration_max_ms = 0
+};
+
+/*** HISTORY local functions ***/
+
+/*******************************************************************/
+static HISTORY_status_t _HISTORY_print_record(uint8_t terminal_instance, HISTORY_record_t* record) {
+    // Local variables.
+    HISTORY_status_t status = HISTORY_SUCCESS;
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    // Build line.
+    terminal_status = TERMINAL_flush_tx_buffer(terminal_instance);
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "History=");
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) record->timestamp_ms, STRING_FORMAT_DECIMAL, 0);
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "ms;");
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) record->wind_speed_ckmh, STRING_FORMAT_DECIMAL, 0);
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "ckm/h;");
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) record->wind_direction_degrees, STRING_FORMAT_DECIMAL, 0);
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "d;");
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) record->rainfall_irq_count, STRING_FORMAT_DECIMAL, 0);
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "irq;");
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) record->synchro, STRING_FORMAT_DECIMAL, 0);
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, HISTORY_LINE_END);
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_send_tx_buffer(terminal_instance);
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+errors:
+    return status;
+}
+
+/*** HISTORY functions ***/
+
+/*******************************************************************/
+HISTORY_status_t HISTORY_init(HISTORY_get_timestamp_cb_t get_timestamp_callback) {
+    // Local variables.
+    HISTORY_status_t status = HISTORY_SUCCESS;
+    // Check parameter.
+    if (get_timestamp_callback == NULL) {
+        status = HISTORY_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Reset context.
+    history_ctx.get_timestamp_callback = get_timestamp_callback;
+    history_ctx.write_count = 0;
+    history_ctx.replay_count = 0;
+    history_ctx.replay_end_count = 0;
+    history_ctx.replay_start_ms = 0;
+    history_ctx.replay_duration_max_ms = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+HISTORY_status_t HISTORY_write(HISTORY_record_t* record) {
+    // Local variables.
+    HISTORY_status_t status = HISTORY_SUCCESS;
+    // Check parameter.
+    if (record == NULL) {
+        status = HISTORY_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Single producer and consumer in main context: no masking required.
+    history_ctx.records[history_ctx.write_count & HISTORY_INDEX_MASK] = (*record);
+    history_ctx.write_count++;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+void HISTORY_start_replay(uint32_t record_count_max, uint32_t duration_max_ms) {
+    // Local variables.
+    uint32_t record_count = (history_ctx.write_count > HISTORY_DEPTH) ? HISTORY_DEPTH : history_ctx.write_count;
+    // Keep the most recent records.
+    if (record_count > record_count_max) {
+        record_count = record_count_max;
+    }
+    // Records written after this call are printed by the live logs.
+    history_ctx.replay_end_count = history_ctx.write_count;
+    history_ctx.replay_count = (history_ctx.write_count - record_count);
+    history_ctx.replay_start_ms = (history_ctx.get_timestamp_callback != NULL) ? history_ctx.get_timestamp_callback() : 0;
+    history_ctx.replay_duration_max_ms = duration_max_ms;
+}
+
+/*******************************************************************/
+HISTORY_status_t HISTORY_print(uint8_t terminal_instance, uint32_t record_count) {
+    // Local variables.
+    HISTORY_status_t status = HISTORY_SUCCESS;
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    uint32_t idx = 0;
+    // Check state.
+    if (history_ctx.get_timestamp_callback == NULL) {
+        status = HISTORY_ERROR_UNINITIALIZED;
+        goto errors;
+    }
+    // Nothing to replay.
+    if (history_ctx.replay_count >= history_ctx.replay_end_count) goto errors;
+    // Skip the records which have been overwritten since the replay started.
+    if ((history_ctx.write_count - history_ctx.replay_count) > HISTORY_DEPTH) {
+        history_ctx.replay_count = (history_ctx.write_count - HISTORY_DEPTH);
+    }
+    // Budget exhausted: skip the oldest records so that the newest ones are printed now.
+    if (((history_ctx.get_timestamp_callback() - history_ctx.replay_start_ms) >= history_ctx.replay_duration_max_ms) && ((history_ctx.replay_end_count - history_ctx.replay_count) > record_count)) {
+        history_ctx.replay_count = (history_ctx.replay_end_count - record_count);
+    }
+    // Records loop, oldest first.
+    for (idx = 0; idx < record_count; idx++) {
+        if (history_ctx.replay_count >= history_ctx.replay_end_count) break;
+        status = _HISTORY_print_record(terminal_instance, &(history_ctx.records[history_ctx.replay_count & HISTORY_INDEX_MASK]));
+        if (status != HISTORY_SUCCESS) goto errors;
+        history_ctx.replay_count++;
+    }
+    // Remaining records are printed by the next calls.
+    if (history_ctx.replay_count < history_ctx.replay_end_count) goto errors;
+    // Mark the end of the replay.
+    terminal_status = TERMINAL_flush_tx_buffer(terminal_instance);
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "History_end" HISTORY_LINE_END);
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_send_tx_buffer(terminal_instance);
+    TERMINAL_exit_error(HISTORY_ERROR_BASE_TERMINAL);
+errors:
+    return status;
+}
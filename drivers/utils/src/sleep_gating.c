@@ -0,0 +1,90 @@
+/*
+ * sleep_gating.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "sleep_gating.h"
+
+#include "flash_registers.h"
+#include "rcc_registers.h"
+#include "sen15901_emulator_flags.h"
+#include "types.h"
+
+/*** SLEEP GATING local macros ***/
+
+// System clock is never scaled (no clock governor): it also clocks the waveform timers (TIM2, TIM21 and TIM22), which must keep their timings.
+// Clocks kept in sleep mode: SRAM, waveform timers, log USART (reception of the persistent terminal) and delay timer.
+#define SLEEP_GATING_RCC_AHBSMENR_SRAM      (0b1 << 9)
+#define SLEEP_GATING_RCC_APB2SMENR_TIM21    (0b1 << 2)
+#define SLEEP_GATING_RCC_APB2SMENR_TIM22    (0b1 << 5)
+#define SLEEP_GATING_RCC_APB2SMENR_DBG      (0b1 << 22)
+#define SLEEP_GATING_RCC_APB1SMENR_TIM2     (0b1 << 0)
+#define SLEEP_GATING_RCC_APB1SMENR_USART2   (0b1 << 17)
+#define SLEEP_GATING_RCC_APB1SMENR_LPTIM1   (0b1 << 31)
+
+#define SLEEP_GATING_RCC_AHBSMENR_SLEEP     (SLEEP_GATING_RCC_AHBSMENR_SRAM)
+#ifdef SEN15901_EMULATOR_MODE_DEBUG
+#define SLEEP_GATING_RCC_APB2SMENR_SLEEP    (SLEEP_GATING_RCC_APB2SMENR_TIM21 | SLEEP_GATING_RCC_APB2SMENR_TIM22 | SLEEP_GATING_RCC_APB2SMENR_DBG)
+#else
+#define SLEEP_GATING_RCC_APB2SMENR_SLEEP    (SLEEP_GATING_RCC_APB2SMENR_TIM21 | SLEEP_GATING_RCC_APB2SMENR_TIM22)
+#endif
+#define SLEEP_GATING_RCC_APB1SMENR_SLEEP    (SLEEP_GATING_RCC_APB1SMENR_TIM2 | SLEEP_GATING_RCC_APB1SMENR_USART2 | SLEEP_GATING_RCC_APB1SMENR_LPTIM1)
+
+// Flash is woken up by the first instruction fetch after sleep.
+#define SLEEP_GATING_FLASH_ACR_SLEEP_PD     (0b1 << 3)
+
+/*** SLEEP GATING local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t rcc_ahbsmenr;
+    uint32_t rcc_apb2smenr;
+    uint32_t rcc_apb1smenr;
+    uint32_t flash_acr_sleep_pd;
+    uint8_t enabled;
+} SLEEP_GATING_context_t;
+
+/*** SLEEP GATING local global variables ***/
+
+static SLEEP_GATING_context_t sleep_gating_ctx = {
+    .rcc_ahbsmenr = 0,
+    .rcc_apb2smenr = 0,
+    .rcc_apb1smenr = 0,
+    .flash_acr_sleep_pd = 0,
+    .enabled = 0
+};
+
+/*** SLEEP GATING functions ***/
+
+/*******************************************************************/
+void SLEEP_GATING_init(void) {
+    // Save current configuration once.
+    if (sleep_gating_ctx.enabled == 0) {
+        sleep_gating_ctx.rcc_ahbsmenr = (RCC->AHBSMENR);
+        sleep_gating_ctx.rcc_apb2smenr = (RCC->APB2SMENR);
+        sleep_gating_ctx.rcc_apb1smenr = (RCC->APB1SMENR);
+        sleep_gating_ctx.flash_acr_sleep_pd = ((FLASH->ACR) & SLEEP_GATING_FLASH_ACR_SLEEP_PD);
+        sleep_gating_ctx.enabled = 1;
+    }
+    // Peripheral clocks are active in sleep mode only if they are both enabled and selected here.
+    RCC->AHBSMENR = SLEEP_GATING_RCC_AHBSMENR_SLEEP;
+    RCC->APB2SMENR = SLEEP_GATING_RCC_APB2SMENR_SLEEP;
+    RCC->APB1SMENR = SLEEP_GATING_RCC_APB1SMENR_SLEEP;
+    FLASH->ACR |= SLEEP_GATING_FLASH_ACR_SLEEP_PD;
+}
+
+/*******************************************************************/
+void SLEEP_GATING_de_init(void) {
+    // Check state.
+    if (sleep_gating_ctx.enabled == 0) goto errors;
+    // Restore configuration.
+    FLASH->ACR = (((FLASH->ACR) & (~SLEEP_GATING_FLASH_ACR_SLEEP_PD)) | sleep_gating_ctx.flash_acr_sleep_pd);
+    RCC->AHBSMENR = sleep_gating_ctx.rcc_ahbsmenr;
+    RCC->APB2SMENR = sleep_gating_ctx.rcc_apb2smenr;
+    RCC->APB1SMENR = sleep_gating_ctx.rcc_apb1smenr;
+    sleep_gating_ctx.enabled = 0;
+errors:
+    return;
+}
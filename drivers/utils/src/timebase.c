@@ -0,0 +1,206 @@
+/*
+ * timebase.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "timebase.h"
+
+#include "error.h"
+#include "irq.h"
+#include "ramfunc.h"
+#include "tim_registers.h"
+#include "types.h"
+
+/*** TIMEBASE local macros ***/
+
+// Waveform timer (TIM_INSTANCE_SIMULATION), kept running in sleep mode.
+#define TIMEBASE_TIMER              TIM2
+#define TIMEBASE_TIM_SR_UIF         0x00000001
+
+#define TIMEBASE_US_PER_MS          1000
+// Reciprocal of TIMEBASE_US_PER_MS in Q38 (exact quotient for any 32-bits value).
+#define TIMEBASE_MS_PER_US_Q38      0x10624DD3
+#define TIMEBASE_MS_PER_US_SHIFT    38
+
+/*** TIMEBASE local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    // Time at the start of the current timer period.
+    uint64_t base_us;
+    uint32_t base_ms;
+    uint32_t fraction_us;
+    // Phase shift applied within the current period.
+    int32_t offset_us;
+    uint32_t period_us;
+    uint32_t us_per_count_q8;
+} TIMEBASE_context_t;
+
+/*** TIMEBASE local global variables ***/
+
+static volatile TIMEBASE_context_t timebase_ctx = {
+    .base_us = 0,
+    .base_ms = 0,
+    .fraction_us = 0,
+    .offset_us = 0,
+    .period_us = 0,
+    .us_per_count_q8 = 0
+};
+
+/*** TIMEBASE local functions ***/
+
+/*******************************************************************/
+static uint32_t _TIMEBASE_get_elapsed_us(void) {
+    // Local variables.
+    int32_t elapsed_us = 0;
+    uint32_t counter = 0;
+    // Time is frozen while the timer is stopped.
+    if (timebase_ctx.us_per_count_q8 == 0) goto errors;
+    counter = (TIMEBASE_TIMER->CNT);
+    elapsed_us = timebase_ctx.offset_us;
+    // Called with interrupts disabled: take a pending update event into account.
+    if (((TIMEBASE_TIMER->SR) & TIMEBASE_TIM_SR_UIF) != 0) {
+        counter = (TIMEBASE_TIMER->CNT);
+        elapsed_us += (int32_t) timebase_ctx.period_us;
+    }
+    elapsed_us += (int32_t) ((counter * timebase_ctx.us_per_count_q8) >> 8);
+errors:
+    return ((uint32_t) elapsed_us);
+}
+
+/*******************************************************************/
+RAMFUNC static uint32_t _TIMEBASE_us_to_ms(uint32_t duration_us) {
+    // Multiply-shift instead of a division (no hardware divider on Cortex-M0+, called from interrupts).
+    return ((uint32_t) ((((uint64_t) duration_us) * TIMEBASE_MS_PER_US_Q38) >> TIMEBASE_MS_PER_US_SHIFT));
+}
+
+/*******************************************************************/
+RAMFUNC static void _TIMEBASE_add_us(uint32_t duration_us) {
+    // Local variables.
+    uint32_t fraction_us = (timebase_ctx.fraction_us + duration_us);
+    uint32_t duration_ms = _TIMEBASE_us_to_ms(fraction_us);
+    // Update both representations.
+    timebase_ctx.base_us += duration_us;
+    timebase_ctx.base_ms += duration_ms;
+    timebase_ctx.fraction_us = (fraction_us - (duration_ms * TIMEBASE_US_PER_MS));
+}
+
+/*** TIMEBASE functions ***/
+
+/*******************************************************************/
+void TIMEBASE_init(void) {
+    // Local variables.
+    uint32_t primask = 0;
+    // Reset context.
+    IRQ_SAVE(primask);
+    timebase_ctx.base_us = 0;
+    timebase_ctx.base_ms = 0;
+    timebase_ctx.fraction_us = 0;
+    timebase_ctx.offset_us = 0;
+    timebase_ctx.period_us = 0;
+    timebase_ctx.us_per_count_q8 = 0;
+    IRQ_RESTORE(primask);
+}
+
+/*******************************************************************/
+TIMEBASE_status_t TIMEBASE_start(uint32_t period_us) {
+    // Local variables.
+    TIMEBASE_status_t status = TIMEBASE_SUCCESS;
+    uint32_t primask = 0;
+    // Check parameter.
+    if (period_us == 0) {
+        status = TIMEBASE_ERROR_PERIOD;
+        goto errors;
+    }
+    // Compute resolution from the actual timer configuration.
+    IRQ_SAVE(primask);
+    timebase_ctx.period_us = period_us;
+    timebase_ctx.us_per_count_q8 = ((period_us << 8) / ((TIMEBASE_TIMER->ARR) + 1));
+    // Time goes on from the value frozen when stopped.
+    timebase_ctx.offset_us = (-((int32_t) (((TIMEBASE_TIMER->CNT) * timebase_ctx.us_per_count_q8) >> 8)));
+    IRQ_RESTORE(primask);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+void TIMEBASE_stop(void) {
+    // Local variables.
+    uint32_t primask = 0;
+    // Accumulate the current period.
+    IRQ_SAVE(primask);
+    _TIMEBASE_add_us(_TIMEBASE_get_elapsed_us());
+    timebase_ctx.offset_us = 0;
+    timebase_ctx.us_per_count_q8 = 0;
+    IRQ_RESTORE(primask);
+}
+
+/*******************************************************************/
+RAMFUNC void TIMEBASE_period_elapsed(uint32_t next_period_us) {
+    // Phase shift is always smaller than the period.
+    _TIMEBASE_add_us((uint32_t) (((int32_t) timebase_ctx.period_us) + timebase_ctx.offset_us));
+    timebase_ctx.offset_us = 0;
+    timebase_ctx.period_us = next_period_us;
+}
+
+/*******************************************************************/
+void TIMEBASE_set_counter(uint32_t counter, uint32_t period_us) {
+    // Local variables.
+    uint32_t elapsed_us = 0;
+    // Account a pending update event before it is cleared.
+    if (((TIMEBASE_TIMER->SR) & TIMEBASE_TIM_SR_UIF) != 0) {
+        TIMEBASE_period_elapsed(timebase_ctx.period_us);
+        TIMEBASE_TIMER->SR &= ~(TIMEBASE_TIM_SR_UIF);
+    }
+    elapsed_us = _TIMEBASE_get_elapsed_us();
+    TIMEBASE_TIMER->CNT = counter;
+    // Keep the same time with the new counter value.
+    timebase_ctx.offset_us = ((int32_t) elapsed_us) - ((int32_t) ((counter * timebase_ctx.us_per_count_q8) >> 8));
+    timebase_ctx.period_us = period_us;
+}
+
+/*******************************************************************/
+void TIMEBASE_set_period(uint32_t period_us) {
+    // Counter is not modified: time goes on without discontinuity.
+    timebase_ctx.period_us = period_us;
+}
+
+/*******************************************************************/
+uint64_t TIMEBASE_get_time_us(void) {
+    // Local variables.
+    uint64_t time_us = 0;
+    uint32_t primask = 0;
+    // Read base and timer atomically.
+    IRQ_SAVE(primask);
+    time_us = timebase_ctx.base_us + _TIMEBASE_get_elapsed_us();
+    IRQ_RESTORE(primask);
+    return time_us;
+}
+
+/*******************************************************************/
+uint32_t TIMEBASE_get_timestamp_us(void) {
+    // Local variables.
+    uint32_t timestamp_us = 0;
+    uint32_t primask = 0;
+    // Low word only: no 64-bits addition.
+    IRQ_SAVE(primask);
+    timestamp_us = ((uint32_t) timebase_ctx.base_us) + _TIMEBASE_get_elapsed_us();
+    IRQ_RESTORE(primask);
+    return timestamp_us;
+}
+
+/*******************************************************************/
+uint32_t TIMEBASE_get_timestamp_ms(void) {
+    // Local variables.
+    uint32_t base_ms = 0;
+    uint32_t fraction_us = 0;
+    uint32_t primask = 0;
+    // Millisecond counter avoids a 64-bits division.
+    IRQ_SAVE(primask);
+    base_ms = timebase_ctx.base_ms;
+    fraction_us = timebase_ctx.fraction_us + _TIMEBASE_get_elapsed_us();
+    IRQ_RESTORE(primask);
+    return (base_ms + _TIMEBASE_us_to_ms(fraction_us));
+}
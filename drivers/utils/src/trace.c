@@ -0,0 +1,190 @@
+/*
+ * trace.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "trace.h"
+
+#include "error.h"
+#include "irq.h"
+#include "terminal.h"
+#include "types.h"
+
+/*** TRACE local macros ***/
+
+// Must be a power of 2.
+#define TRACE_DEPTH             64
+#define TRACE_INDEX_MASK        (TRACE_DEPTH - 1)
+
+#define TRACE_LINE_END          "\r\n"
+
+/*** TRACE local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t timestamp_ms;
+    uint16_t data;
+    uint8_t event;
+    // Error base divided by ERROR_BASE_STEP (error records only).
+    uint8_t error_base;
+} TRACE_record_t;
+
+/*******************************************************************/
+typedef struct {
+    TRACE_get_timestamp_cb_t get_timestamp_callback;
+    volatile TRACE_record_t records[TRACE_DEPTH];
+    volatile uint32_t write_count;
+    uint32_t read_count;
+    uint32_t lost_count;
+} TRACE_context_t;
+
+/*** TRACE local global variables ***/
+
+static const char_t* const TRACE_EVENT_NAME[TRACE_EVENT_LAST] = {
+    "synchro_accepted",
+    "synchro_filtered",
+    "synchro_command",
+    "synchro_early",
+    "synchro_missed",
+    "tick",
+    "wind_speed",
+    "wind_direction",
+    "rainfall_pulse",
+    "log_start",
+    "log_end",
+    "error"
+};
+
+static TRACE_context_t trace_ctx = {
+    .get_timestamp_callback = NULL,
+    .write_count = 0,
+    .read_count = 0,
+    .lost_count = 0
+};
+
+/*** TRACE local functions ***/
+
+/*******************************************************************/
+static void _TRACE_write_record(TRACE_event_t event, uint8_t error_base, uint16_t data) {
+    // Local variables.
+    volatile TRACE_record_t* record = NULL;
+    uint32_t timestamp_ms = 0;
+    uint32_t primask = 0;
+    // Check driver state.
+    if (trace_ctx.get_timestamp_callback == NULL) return;
+    // Timestamp is read before the critical section, which only reserves and fills the slot.
+    timestamp_ms = trace_ctx.get_timestamp_callback();
+    // Producers run at several interrupt levels and the Cortex-M0+ has no exclusive access instructions.
+    IRQ_SAVE(primask);
+    record = &(trace_ctx.records[trace_ctx.write_count & TRACE_INDEX_MASK]);
+    record->timestamp_ms = timestamp_ms;
+    record->data = data;
+    record->event = (uint8_t) event;
+    record->error_base = error_base;
+    trace_ctx.write_count++;
+    IRQ_RESTORE(primask);
+}
+
+/*** TRACE functions ***/
+
+/*******************************************************************/
+TRACE_status_t TRACE_init(TRACE_get_timestamp_cb_t get_timestamp_callback) {
+    // Local variables.
+    TRACE_status_t status = TRACE_SUCCESS;
+    // Check parameter.
+    if (get_timestamp_callback == NULL) {
+        status = TRACE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Reset context.
+    trace_ctx.get_timestamp_callback = get_timestamp_callback;
+    trace_ctx.write_count = 0;
+    trace_ctx.read_count = 0;
+    trace_ctx.lost_count = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+void TRACE_write(TRACE_event_t event, uint16_t data) {
+    _TRACE_write_record(event, 0, data);
+}
+
+/*******************************************************************/
+void TRACE_write_error(ERROR_code_t code) {
+    // Error bases are multiples of ERROR_BASE_STEP: the remainder is the status of the failing driver.
+    _TRACE_write_record(TRACE_EVENT_ERROR, (uint8_t) (code / ERROR_BASE_STEP), (uint16_t) (code % ERROR_BASE_STEP));
+}
+
+/*******************************************************************/
+TRACE_status_t TRACE_print(uint8_t terminal_instance) {
+    // Local variables.
+    TRACE_status_t status = TRACE_SUCCESS;
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    volatile TRACE_record_t* slot = NULL;
+    TRACE_record_t record;
+    uint32_t write_count = 0;
+    // Records loop (single reader in main context, writers never wait for it).
+    while (1) {
+        write_count = trace_ctx.write_count;
+        // Skip overwritten records.
+        if ((write_count - trace_ctx.read_count) > TRACE_DEPTH) {
+            trace_ctx.lost_count += (write_count - trace_ctx.read_count - TRACE_DEPTH);
+            trace_ctx.read_count = (write_count - TRACE_DEPTH);
+        }
+        // Exit when the ring is empty.
+        if (trace_ctx.read_count == write_count) break;
+        // Copy record without masking, and drop it if a writer has reused the slot meanwhile.
+        slot = &(trace_ctx.records[trace_ctx.read_count & TRACE_INDEX_MASK]);
+        record.timestamp_ms = slot->timestamp_ms;
+        record.data = slot->data;
+        record.event = slot->event;
+        record.error_base = slot->error_base;
+        if ((trace_ctx.write_count - trace_ctx.read_count) > TRACE_DEPTH) continue;
+        trace_ctx.read_count++;
+        // Print record.
+        terminal_status = TERMINAL_flush_tx_buffer(terminal_instance);
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "Trace=");
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) record.timestamp_ms, STRING_FORMAT_DECIMAL, 0);
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "ms;");
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, (char_t*) ((record.event < TRACE_EVENT_LAST) ? TRACE_EVENT_NAME[record.event] : "unknown"));
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, ";");
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        // Error records: base of the failing driver, then its status.
+        if (record.event == TRACE_EVENT_ERROR) {
+            terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) (record.error_base * ERROR_BASE_STEP), STRING_FORMAT_HEXADECIMAL, 1);
+            TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+            terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, ";");
+            TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        }
+        terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) record.data, STRING_FORMAT_DECIMAL, 0);
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, TRACE_LINE_END);
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_send_tx_buffer(terminal_instance);
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+    }
+    // Report overflow.
+    if (trace_ctx.lost_count != 0) {
+        terminal_status = TERMINAL_flush_tx_buffer(terminal_instance);
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "Trace_lost=");
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) trace_ctx.lost_count, STRING_FORMAT_DECIMAL, 0);
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, TRACE_LINE_END);
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_send_tx_buffer(terminal_instance);
+        TERMINAL_exit_error(TRACE_ERROR_BASE_TERMINAL);
+        trace_ctx.lost_count = 0;
+    }
+errors:
+    return status;
+}
@@ -0,0 +1,128 @@
+/*
+ * cluster.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __CLUSTER_H__
+#define __CLUSTER_H__
+
+#include "error.h"
+#include "types.h"
+
+/*** CLUSTER macros ***/
+
+// Markers are sent by the leader on the log interface, their bytes never collide with ASCII logs:
+//   0b10dddddd             -> TICK: leader tick occurred (d * 200us) before the start bit of the marker.
+//   0b110sssss + 3 * 0b111sssss -> STEP: leader started campaign step s (20 bits, most significant bits first).
+#define CLUSTER_TICK_DELAY_UNIT_US          200
+#define CLUSTER_TICK_DELAY_MAX_US           (63 * CLUSTER_TICK_DELAY_UNIT_US)
+#define CLUSTER_STEP_MARKER_SIZE_BYTES      4
+#define CLUSTER_STEP_MAX                    0x000FFFFF
+
+/*** CLUSTER structures ***/
+
+/*!******************************************************************
+ * \enum CLUSTER_status_t
+ * \brief Cluster markers codec error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    CLUSTER_SUCCESS = 0,
+    CLUSTER_ERROR_NULL_PARAMETER,
+    CLUSTER_ERROR_TICK_DELAY,
+    CLUSTER_ERROR_STEP,
+    // Last base value.
+    CLUSTER_ERROR_BASE_LAST = ERROR_BASE_STEP
+} CLUSTER_status_t;
+
+/*!******************************************************************
+ * \enum CLUSTER_marker_type_t
+ * \brief Cluster markers list.
+ *******************************************************************/
+typedef enum {
+    CLUSTER_MARKER_TYPE_NONE = 0,
+    CLUSTER_MARKER_TYPE_TICK,
+    CLUSTER_MARKER_TYPE_STEP,
+    CLUSTER_MARKER_TYPE_LAST
+} CLUSTER_marker_type_t;
+
+/*!******************************************************************
+ * \struct CLUSTER_marker_t
+ * \brief Decoded cluster marker.
+ *******************************************************************/
+typedef struct {
+    CLUSTER_marker_type_t type;
+    uint32_t value;
+} CLUSTER_marker_t;
+
+/*** CLUSTER functions ***/
+
+/*!******************************************************************
+ * \fn void CLUSTER_init(void)
+ * \brief Reset markers decoder.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void CLUSTER_init(void);
+
+/*!******************************************************************
+ * \fn CLUSTER_status_t CLUSTER_encode_tick_marker(uint32_t delay_us, uint8_t* marker)
+ * \brief Encode a tick marker.
+ * \param[in]   delay_us: Delay between the leader tick and the transmission of the marker in us.
+ * \param[out]  marker: Pointer to the marker byte.
+ * \retval      Function execution status.
+ *******************************************************************/
+CLUSTER_status_t CLUSTER_encode_tick_marker(uint32_t delay_us, uint8_t* marker);
+
+/*!******************************************************************
+ * \fn CLUSTER_status_t CLUSTER_encode_step_marker(uint32_t step, uint8_t* marker)
+ * \brief Encode a campaign step marker.
+ * \param[in]   step: Campaign step started by the leader.
+ * \param[out]  marker: Pointer to the marker bytes (CLUSTER_STEP_MARKER_SIZE_BYTES).
+ * \retval      Function execution status.
+ *******************************************************************/
+CLUSTER_status_t CLUSTER_encode_step_marker(uint32_t step, uint8_t* marker);
+
+/*!******************************************************************
+ * \fn CLUSTER_status_t CLUSTER_decode(uint8_t data, CLUSTER_marker_t* marker)
+ * \brief Decode a byte received from the leader (interrupt safe).
+ * \param[in]   data: Received byte.
+ * \param[out]  marker: Pointer to the completed marker (CLUSTER_MARKER_TYPE_NONE if none).
+ * \retval      Function execution status.
+ *******************************************************************/
+CLUSTER_status_t CLUSTER_decode(uint8_t data, CLUSTER_marker_t* marker);
+
+/*!******************************************************************
+ * \fn int32_t CLUSTER_get_phase_error_us(uint32_t tick_offset_us, uint32_t marker_age_us, uint32_t tick_period_us)
+ * \brief Compute the tick phase error of the follower.
+ * \param[in]   tick_offset_us: Time elapsed since the last follower tick when the marker is received in us.
+ * \param[in]   marker_age_us: Time elapsed since the leader tick when the marker is received in us.
+ * \param[in]   tick_period_us: Tick period in us.
+ * \param[out]  none
+ * \retval      Follower tick advance over the leader in us (negative if late), within half a tick period.
+ *******************************************************************/
+int32_t CLUSTER_get_phase_error_us(uint32_t tick_offset_us, uint32_t marker_age_us, uint32_t tick_period_us);
+
+/*!******************************************************************
+ * \fn int32_t CLUSTER_get_correction_us(volatile int32_t* phase_error_us, uint32_t slew_max_us)
+ * \brief Get the next slice of a phase correction.
+ * \param[in]   phase_error_us: Pointer to the remaining phase error in us.
+ * \param[in]   slew_max_us: Maximum correction in us.
+ * \param[out]  phase_error_us: Pointer to the phase error left after this correction.
+ * \retval      Correction to add to the next timer period in us.
+ *******************************************************************/
+int32_t CLUSTER_get_correction_us(volatile int32_t* phase_error_us, uint32_t slew_max_us);
+
+/*******************************************************************/
+#define CLUSTER_exit_error(base) { ERROR_check_exit(cluster_status, CLUSTER_SUCCESS, base) }
+
+/*******************************************************************/
+#define CLUSTER_stack_error(base) { ERROR_check_stack(cluster_status, CLUSTER_SUCCESS, base) }
+
+/*******************************************************************/
+#define CLUSTER_stack_exit_error(base, code) { ERROR_check_stack_exit(cluster_status, CLUSTER_SUCCESS, base, code) }
+
+#endif /* __CLUSTER_H__ */
@@ -0,0 +1,155 @@
+/*
+ * cluster.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "cluster.h"
+
+#include "error.h"
+#include "types.h"
+
+/*** CLUSTER local macros ***/
+
+#define CLUSTER_MARKER_TICK_HEADER          0x80
+#define CLUSTER_MARKER_TICK_MASK            0xC0
+#define CLUSTER_MARKER_TICK_DATA_MASK       0x3F
+
+#define CLUSTER_MARKER_STEP_HEADER          0xC0
+#define CLUSTER_MARKER_STEP_CONTINUATION    0xE0
+#define CLUSTER_MARKER_STEP_MASK            0xE0
+#define CLUSTER_MARKER_STEP_DATA_MASK       0x1F
+#define CLUSTER_MARKER_STEP_DATA_SIZE_BITS  5
+
+/*** CLUSTER local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t step;
+    uint8_t step_remaining_bytes;
+} CLUSTER_context_t;
+
+/*** CLUSTER local global variables ***/
+
+static CLUSTER_context_t cluster_ctx = {
+    .step = 0,
+    .step_remaining_bytes = 0
+};
+
+/*** CLUSTER functions ***/
+
+/*******************************************************************/
+void CLUSTER_init(void) {
+    // Reset decoder.
+    cluster_ctx.step = 0;
+    cluster_ctx.step_remaining_bytes = 0;
+}
+
+/*******************************************************************/
+CLUSTER_status_t CLUSTER_encode_tick_marker(uint32_t delay_us, uint8_t* marker) {
+    // Local variables.
+    CLUSTER_status_t status = CLUSTER_SUCCESS;
+    // Check parameters.
+    if (marker == NULL) {
+        status = CLUSTER_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (delay_us > CLUSTER_TICK_DELAY_MAX_US) {
+        status = CLUSTER_ERROR_TICK_DELAY;
+        goto errors;
+    }
+    (*marker) = (uint8_t) (CLUSTER_MARKER_TICK_HEADER | ((delay_us + (CLUSTER_TICK_DELAY_UNIT_US >> 1)) / CLUSTER_TICK_DELAY_UNIT_US));
+errors:
+    return status;
+}
+
+/*******************************************************************/
+CLUSTER_status_t CLUSTER_encode_step_marker(uint32_t step, uint8_t* marker) {
+    // Local variables.
+    CLUSTER_status_t status = CLUSTER_SUCCESS;
+    uint8_t idx = 0;
+    // Check parameters.
+    if (marker == NULL) {
+        status = CLUSTER_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (step > CLUSTER_STEP_MAX) {
+        status = CLUSTER_ERROR_STEP;
+        goto errors;
+    }
+    // Most significant bits first.
+    for (idx = 0; idx < CLUSTER_STEP_MARKER_SIZE_BYTES; idx++) {
+        marker[idx] = (uint8_t) ((step >> (CLUSTER_MARKER_STEP_DATA_SIZE_BITS * (CLUSTER_STEP_MARKER_SIZE_BYTES - 1 - idx))) & CLUSTER_MARKER_STEP_DATA_MASK);
+        marker[idx] |= (idx == 0) ? CLUSTER_MARKER_STEP_HEADER : CLUSTER_MARKER_STEP_CONTINUATION;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+CLUSTER_status_t CLUSTER_decode(uint8_t data, CLUSTER_marker_t* marker) {
+    // Local variables.
+    CLUSTER_status_t status = CLUSTER_SUCCESS;
+    // Check parameter.
+    if (marker == NULL) {
+        status = CLUSTER_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    marker->type = CLUSTER_MARKER_TYPE_NONE;
+    marker->value = 0;
+    // Tick marker is a single byte.
+    if ((data & CLUSTER_MARKER_TICK_MASK) == CLUSTER_MARKER_TICK_HEADER) {
+        cluster_ctx.step_remaining_bytes = 0;
+        marker->type = CLUSTER_MARKER_TYPE_TICK;
+        marker->value = ((data & CLUSTER_MARKER_TICK_DATA_MASK) * CLUSTER_TICK_DELAY_UNIT_US);
+    }
+    else if ((data & CLUSTER_MARKER_STEP_MASK) == CLUSTER_MARKER_STEP_HEADER) {
+        // Any header restarts the step decoding.
+        cluster_ctx.step = (data & CLUSTER_MARKER_STEP_DATA_MASK);
+        cluster_ctx.step_remaining_bytes = (CLUSTER_STEP_MARKER_SIZE_BYTES - 1);
+    }
+    else if (((data & CLUSTER_MARKER_STEP_MASK) == CLUSTER_MARKER_STEP_CONTINUATION) && (cluster_ctx.step_remaining_bytes != 0)) {
+        cluster_ctx.step = (cluster_ctx.step << CLUSTER_MARKER_STEP_DATA_SIZE_BITS) | (data & CLUSTER_MARKER_STEP_DATA_MASK);
+        cluster_ctx.step_remaining_bytes--;
+        if (cluster_ctx.step_remaining_bytes == 0) {
+            marker->type = CLUSTER_MARKER_TYPE_STEP;
+            marker->value = cluster_ctx.step;
+        }
+    }
+    // ASCII logs of the leader are ignored.
+errors:
+    return status;
+}
+
+/*******************************************************************/
+int32_t CLUSTER_get_phase_error_us(uint32_t tick_offset_us, uint32_t marker_age_us, uint32_t tick_period_us) {
+    // Local variables.
+    uint32_t offset_us = 0;
+    // Check parameter.
+    if (tick_period_us == 0) goto errors;
+    // Time elapsed since the last follower tick when the leader ticked.
+    offset_us = ((tick_offset_us % tick_period_us) + tick_period_us - (marker_age_us % tick_period_us)) % tick_period_us;
+errors:
+    // Shortest offset in [-T/2, T/2) (rounded up half period for odd periods).
+    return ((offset_us < ((tick_period_us + 1) >> 1)) ? ((int32_t) offset_us) : (((int32_t) offset_us) - ((int32_t) tick_period_us)));
+}
+
+/*******************************************************************/
+int32_t CLUSTER_get_correction_us(volatile int32_t* phase_error_us, uint32_t slew_max_us) {
+    // Local variables.
+    int32_t correction_us = 0;
+    // Check parameter.
+    if (phase_error_us == NULL) goto errors;
+    // Slew the remaining error.
+    correction_us = (*phase_error_us);
+    if (correction_us > ((int32_t) slew_max_us)) {
+        correction_us = ((int32_t) slew_max_us);
+    }
+    if (correction_us < (-((int32_t) slew_max_us))) {
+        correction_us = (-((int32_t) slew_max_us));
+    }
+    (*phase_error_us) -= correction_us;
+errors:
+    return correction_us;
+}
@@ -0,0 +1,132 @@
+/*
+ * coverage.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __COVERAGE_H__
+#define __COVERAGE_H__
+
+#include "error.h"
+#include "nvm.h"
+#include "terminal.h"
+#include "types.h"
+
+/*** COVERAGE macros ***/
+
+// Histograms:
+//   wind_speed     -> ticks per 10km/h wind speed bin (last bin is 150km/h and above).
+//   wind_direction -> ticks per (direction sector * 4 + speed band), with 16 sectors of 22.5 degrees and 40km/h bands.
+//   rainfall       -> DUT periods per bin of 8 rainfall pulses.
+//   synchro        -> DUT synchronization intervals per power of 2 of milliseconds (first bin is below 4096ms).
+#define COVERAGE_WIND_SPEED_BIN_NUMBER          16
+#define COVERAGE_WIND_SPEED_BAND_NUMBER         4
+#define COVERAGE_WIND_DIRECTION_SECTOR_NUMBER   16
+#define COVERAGE_RAINFALL_BIN_NUMBER            16
+#define COVERAGE_SYNCHRO_BIN_NUMBER             16
+
+#define COVERAGE_COUNTER_NUMBER                 (COVERAGE_WIND_SPEED_BIN_NUMBER + (COVERAGE_WIND_DIRECTION_SECTOR_NUMBER * COVERAGE_WIND_SPEED_BAND_NUMBER) + COVERAGE_RAINFALL_BIN_NUMBER + COVERAGE_SYNCHRO_BIN_NUMBER)
+// Checkpoint is a header byte followed by the little endian counters.
+#define COVERAGE_CHECKPOINT_SIZE_BYTES          (1 + (COVERAGE_COUNTER_NUMBER * 4))
+
+/*** COVERAGE structures ***/
+
+/*!******************************************************************
+ * \enum COVERAGE_status_t
+ * \brief Stimulus coverage driver error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    COVERAGE_SUCCESS = 0,
+    // Low level driver errors.
+    COVERAGE_ERROR_BASE_NVM = ERROR_BASE_STEP,
+    COVERAGE_ERROR_BASE_TERMINAL = (COVERAGE_ERROR_BASE_NVM + NVM_ERROR_BASE_LAST),
+    // Last base value.
+    COVERAGE_ERROR_BASE_LAST = (COVERAGE_ERROR_BASE_TERMINAL + TERMINAL_ERROR_BASE_LAST)
+} COVERAGE_status_t;
+
+/*** COVERAGE functions ***/
+
+/*!******************************************************************
+ * \fn void COVERAGE_init(void)
+ * \brief Clear all histograms.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void COVERAGE_init(void);
+
+/*!******************************************************************
+ * \fn void COVERAGE_add_wind_speed(uint32_t wind_speed_ckmh)
+ * \brief Count the wind speed emitted during a tick.
+ * \param[in]   wind_speed_ckmh: Wind speed in ckm/h.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void COVERAGE_add_wind_speed(uint32_t wind_speed_ckmh);
+
+/*!******************************************************************
+ * \fn void COVERAGE_add_wind_direction(uint32_t wind_direction_degrees)
+ * \brief Count the wind direction emitted during a tick, in the band of the last wind speed.
+ * \param[in]   wind_direction_degrees: Wind direction in degrees.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void COVERAGE_add_wind_direction(uint32_t wind_direction_degrees);
+
+/*!******************************************************************
+ * \fn void COVERAGE_add_rainfall_period(uint32_t rainfall_pulse_count)
+ * \brief Count the rainfall pulses emitted during a DUT period.
+ * \param[in]   rainfall_pulse_count: Number of pulses of the period.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void COVERAGE_add_rainfall_period(uint32_t rainfall_pulse_count);
+
+/*!******************************************************************
+ * \fn void COVERAGE_add_synchro_interval(uint32_t interval_ms)
+ * \brief Count an interval between two DUT synchronizations.
+ * \param[in]   interval_ms: Interval in ms.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void COVERAGE_add_synchro_interval(uint32_t interval_ms);
+
+/*!******************************************************************
+ * \fn COVERAGE_status_t COVERAGE_restore(NVM_address_t nvm_address)
+ * \brief Load histograms from the NVM checkpoint (histograms are cleared if there is no valid checkpoint).
+ * \param[in]   nvm_address: Checkpoint address (COVERAGE_CHECKPOINT_SIZE_BYTES bytes).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+COVERAGE_status_t COVERAGE_restore(NVM_address_t nvm_address);
+
+/*!******************************************************************
+ * \fn COVERAGE_status_t COVERAGE_checkpoint(NVM_address_t nvm_address)
+ * \brief Write the next counter of the histograms in NVM (only modified bytes are written).
+ * \param[in]   nvm_address: Checkpoint address (COVERAGE_CHECKPOINT_SIZE_BYTES bytes).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+COVERAGE_status_t COVERAGE_checkpoint(NVM_address_t nvm_address);
+
+/*!******************************************************************
+ * \fn COVERAGE_status_t COVERAGE_print(uint8_t terminal_instance)
+ * \brief Print the non-empty bins of all histograms.
+ * \param[in]   terminal_instance: Terminal to use.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+COVERAGE_status_t COVERAGE_print(uint8_t terminal_instance);
+
+/*******************************************************************/
+#define COVERAGE_exit_error(base) { ERROR_check_exit(coverage_status, COVERAGE_SUCCESS, base) }
+
+/*******************************************************************/
+#define COVERAGE_stack_error(base) { ERROR_check_stack(coverage_status, COVERAGE_SUCCESS, base) }
+
+/*******************************************************************/
+#define COVERAGE_stack_exit_error(base, code) { ERROR_check_stack_exit(coverage_status, COVERAGE_SUCCESS, base, code) }
+
+#endif /* __COVERAGE_H__ */
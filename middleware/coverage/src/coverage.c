@@ -0,0 +1,224 @@
+/*
+ * coverage.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "coverage.h"
+
+#include "error.h"
+#include "nvm.h"
+#include "terminal.h"
+#include "types.h"
+
+/*** COVERAGE local macros ***/
+
+#define COVERAGE_WIND_SPEED_BIN_CKMH            1000
+#define COVERAGE_WIND_SPEED_BAND_SHIFT          2
+#define COVERAGE_RAINFALL_BIN_SHIFT             3
+#define COVERAGE_SYNCHRO_BIN_OFFSET             11
+
+// Counters offsets.
+#define COVERAGE_OFFSET_WIND_SPEED              0
+#define COVERAGE_OFFSET_WIND_DIRECTION          (COVERAGE_OFFSET_WIND_SPEED + COVERAGE_WIND_SPEED_BIN_NUMBER)
+#define COVERAGE_OFFSET_RAINFALL                (COVERAGE_OFFSET_WIND_DIRECTION + (COVERAGE_WIND_DIRECTION_SECTOR_NUMBER * COVERAGE_WIND_SPEED_BAND_NUMBER))
+#define COVERAGE_OFFSET_SYNCHRO                 (COVERAGE_OFFSET_RAINFALL + COVERAGE_RAINFALL_BIN_NUMBER)
+
+#define COVERAGE_COUNTER_MAX                    0xFFFFFFFF
+#define COVERAGE_CHECKPOINT_HEADER              0xC5
+
+#define COVERAGE_LINE_END                       "\r\n"
+
+/*** COVERAGE local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t counters[COVERAGE_COUNTER_NUMBER];
+    uint8_t wind_speed_band;
+    uint8_t checkpoint_index;
+} COVERAGE_context_t;
+
+/*******************************************************************/
+typedef struct {
+    char_t* name;
+    uint8_t offset;
+    uint8_t size;
+} COVERAGE_histogram_t;
+
+/*** COVERAGE local global variables ***/
+
+static const COVERAGE_histogram_t COVERAGE_HISTOGRAMS[] = {
+    { "wind_speed", COVERAGE_OFFSET_WIND_SPEED, COVERAGE_WIND_SPEED_BIN_NUMBER },
+    { "wind_direction", COVERAGE_OFFSET_WIND_DIRECTION, (COVERAGE_WIND_DIRECTION_SECTOR_NUMBER * COVERAGE_WIND_SPEED_BAND_NUMBER) },
+    { "rainfall", COVERAGE_OFFSET_RAINFALL, COVERAGE_RAINFALL_BIN_NUMBER },
+    { "synchro", COVERAGE_OFFSET_SYNCHRO, COVERAGE_SYNCHRO_BIN_NUMBER }
+};
+
+static COVERAGE_context_t coverage_ctx = {
+    .wind_speed_band = 0,
+    .checkpoint_index = 0
+};
+
+/*** COVERAGE local functions ***/
+
+/*******************************************************************/
+static void _COVERAGE_increment(uint32_t offset, uint32_t bin, uint32_t bin_number) {
+    // Last bin collects the values above the range.
+    if (bin >= bin_number) {
+        bin = (bin_number - 1);
+    }
+    if (coverage_ctx.counters[offset + bin] < COVERAGE_COUNTER_MAX) {
+        coverage_ctx.counters[offset + bin]++;
+    }
+}
+
+/*** COVERAGE functions ***/
+
+/*******************************************************************/
+void COVERAGE_init(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Reset context.
+    for (idx = 0; idx < COVERAGE_COUNTER_NUMBER; idx++) {
+        coverage_ctx.counters[idx] = 0;
+    }
+    coverage_ctx.wind_speed_band = 0;
+    coverage_ctx.checkpoint_index = 0;
+}
+
+/*******************************************************************/
+void COVERAGE_add_wind_speed(uint32_t wind_speed_ckmh) {
+    // Local variables.
+    uint32_t bin = (wind_speed_ckmh / COVERAGE_WIND_SPEED_BIN_CKMH);
+    // Update histogram and keep the band for the direction matrix.
+    _COVERAGE_increment(COVERAGE_OFFSET_WIND_SPEED, bin, COVERAGE_WIND_SPEED_BIN_NUMBER);
+    bin >>= COVERAGE_WIND_SPEED_BAND_SHIFT;
+    coverage_ctx.wind_speed_band = (uint8_t) ((bin < COVERAGE_WIND_SPEED_BAND_NUMBER) ? bin : (COVERAGE_WIND_SPEED_BAND_NUMBER - 1));
+}
+
+/*******************************************************************/
+void COVERAGE_add_wind_direction(uint32_t wind_direction_degrees) {
+    // Local variables.
+    uint32_t sector = ((((wind_direction_degrees % 360) << 1) + 22) / 45) % COVERAGE_WIND_DIRECTION_SECTOR_NUMBER;
+    // Update matrix.
+    _COVERAGE_increment(COVERAGE_OFFSET_WIND_DIRECTION, ((sector * COVERAGE_WIND_SPEED_BAND_NUMBER) + coverage_ctx.wind_speed_band), (COVERAGE_WIND_DIRECTION_SECTOR_NUMBER * COVERAGE_WIND_SPEED_BAND_NUMBER));
+}
+
+/*******************************************************************/
+void COVERAGE_add_rainfall_period(uint32_t rainfall_pulse_count) {
+    // Update histogram.
+    _COVERAGE_increment(COVERAGE_OFFSET_RAINFALL, (rainfall_pulse_count >> COVERAGE_RAINFALL_BIN_SHIFT), COVERAGE_RAINFALL_BIN_NUMBER);
+}
+
+/*******************************************************************/
+void COVERAGE_add_synchro_interval(uint32_t interval_ms) {
+    // Local variables.
+    uint32_t bin = 0;
+    // Position of the most significant bit.
+    if (interval_ms != 0) {
+        bin = (uint32_t) (31 - __builtin_clz(interval_ms));
+    }
+    bin = (bin > COVERAGE_SYNCHRO_BIN_OFFSET) ? (bin - COVERAGE_SYNCHRO_BIN_OFFSET) : 0;
+    _COVERAGE_increment(COVERAGE_OFFSET_SYNCHRO, bin, COVERAGE_SYNCHRO_BIN_NUMBER);
+}
+
+/*******************************************************************/
+COVERAGE_status_t COVERAGE_restore(NVM_address_t nvm_address) {
+    // Local variables.
+    COVERAGE_status_t status = COVERAGE_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint32_t idx = 0;
+    uint8_t data = 0;
+    // Clear histograms.
+    COVERAGE_init();
+    // Check header.
+    nvm_status = NVM_read_byte(nvm_address, &data);
+    NVM_exit_error(COVERAGE_ERROR_BASE_NVM);
+    if (data != COVERAGE_CHECKPOINT_HEADER) goto errors;
+    // Read counters.
+    for (idx = 0; idx < (COVERAGE_COUNTER_NUMBER * 4); idx++) {
+        nvm_status = NVM_read_byte((NVM_address_t) (nvm_address + 1 + idx), &data);
+        NVM_exit_error(COVERAGE_ERROR_BASE_NVM);
+        coverage_ctx.counters[idx >> 2] |= (((uint32_t) data) << ((idx & 0x03) << 3));
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+COVERAGE_status_t COVERAGE_checkpoint(NVM_address_t nvm_address) {
+    // Local variables.
+    COVERAGE_status_t status = COVERAGE_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    NVM_address_t address;
+    uint32_t counter = coverage_ctx.counters[coverage_ctx.checkpoint_index];
+    uint8_t data = 0;
+    uint8_t idx = 0;
+    // One counter per call: EEPROM writes take several milliseconds and unmodified bytes are skipped to save endurance.
+    for (idx = 0; idx < 4; idx++) {
+        address = (NVM_address_t) (nvm_address + 1 + (coverage_ctx.checkpoint_index << 2) + idx);
+        nvm_status = NVM_read_byte(address, &data);
+        NVM_exit_error(COVERAGE_ERROR_BASE_NVM);
+        if (data != (uint8_t) (counter >> (idx << 3))) {
+            nvm_status = NVM_write_byte(address, (uint8_t) (counter >> (idx << 3)));
+            NVM_exit_error(COVERAGE_ERROR_BASE_NVM);
+        }
+    }
+    coverage_ctx.checkpoint_index++;
+    if (coverage_ctx.checkpoint_index >= COVERAGE_COUNTER_NUMBER) {
+        coverage_ctx.checkpoint_index = 0;
+        // Checkpoint is valid once all counters have been written.
+        nvm_status = NVM_read_byte(nvm_address, &data);
+        NVM_exit_error(COVERAGE_ERROR_BASE_NVM);
+        if (data != COVERAGE_CHECKPOINT_HEADER) {
+            nvm_status = NVM_write_byte(nvm_address, COVERAGE_CHECKPOINT_HEADER);
+            NVM_exit_error(COVERAGE_ERROR_BASE_NVM);
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+COVERAGE_status_t COVERAGE_print(uint8_t terminal_instance) {
+    // Local variables.
+    COVERAGE_status_t status = COVERAGE_SUCCESS;
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    uint8_t histogram_idx = 0;
+    uint8_t bin = 0;
+    uint32_t counter = 0;
+    // Histograms loop.
+    for (histogram_idx = 0; histogram_idx < (sizeof(COVERAGE_HISTOGRAMS) / sizeof(COVERAGE_histogram_t)); histogram_idx++) {
+        for (bin = 0; bin < COVERAGE_HISTOGRAMS[histogram_idx].size; bin++) {
+            counter = coverage_ctx.counters[COVERAGE_HISTOGRAMS[histogram_idx].offset + bin];
+            // Empty bins are not printed.
+            if (counter == 0) continue;
+            terminal_status = TERMINAL_flush_tx_buffer(terminal_instance);
+            TERMINAL_exit_error(COVERAGE_ERROR_BASE_TERMINAL);
+            terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, "Coverage=");
+            TERMINAL_exit_error(COVERAGE_ERROR_BASE_TERMINAL);
+            terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, COVERAGE_HISTOGRAMS[histogram_idx].name);
+            TERMINAL_exit_error(COVERAGE_ERROR_BASE_TERMINAL);
+            terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, ";");
+            TERMINAL_exit_error(COVERAGE_ERROR_BASE_TERMINAL);
+            terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) bin, STRING_FORMAT_DECIMAL, 0);
+            TERMINAL_exit_error(COVERAGE_ERROR_BASE_TERMINAL);
+            terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, ";");
+            TERMINAL_exit_error(COVERAGE_ERROR_BASE_TERMINAL);
+            // Counters are unsigned: print the tens and the last digit separately to fit the signed conversion.
+            if (counter >= 10) {
+                terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) (counter / 10), STRING_FORMAT_DECIMAL, 0);
+                TERMINAL_exit_error(COVERAGE_ERROR_BASE_TERMINAL);
+            }
+            terminal_status = TERMINAL_tx_buffer_add_integer(terminal_instance, (int32_t) (counter % 10), STRING_FORMAT_DECIMAL, 0);
+            TERMINAL_exit_error(COVERAGE_ERROR_BASE_TERMINAL);
+            terminal_status = TERMINAL_tx_buffer_add_string(terminal_instance, COVERAGE_LINE_END);
+            TERMINAL_exit_error(COVERAGE_ERROR_BASE_TERMINAL);
+            terminal_status = TERMINAL_send_tx_buffer(terminal_instance);
+            TERMINAL_exit_error(COVERAGE_ERROR_BASE_TERMINAL);
+        }
+    }
+errors:
+    return status;
+}
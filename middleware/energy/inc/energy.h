@@ -0,0 +1,120 @@
+/*
+ * energy.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __ENERGY_H__
+#define __ENERGY_H__
+
+#include "error.h"
+#include "types.h"
+
+/*** ENERGY structures ***/
+
+/*!******************************************************************
+ * \enum ENERGY_status_t
+ * \brief Energy accounting error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    ENERGY_SUCCESS = 0,
+    ENERGY_ERROR_NULL_PARAMETER,
+    ENERGY_ERROR_STATE,
+    // Last base value.
+    ENERGY_ERROR_BASE_LAST = ERROR_BASE_STEP
+} ENERGY_status_t;
+
+/*!******************************************************************
+ * \enum ENERGY_state_t
+ * \brief Board power states (run residency is computed as the complement of sleep).
+ *******************************************************************/
+typedef enum {
+    ENERGY_STATE_RUN = 0,
+    ENERGY_STATE_SLEEP,
+    ENERGY_STATE_TCXO,
+    ENERGY_STATE_TERMINAL,
+    ENERGY_STATE_LED_RUN,
+    ENERGY_STATE_LED_SYNCHRO,
+    ENERGY_STATE_LED_FAULT,
+    ENERGY_STATE_CHARGER_DISABLED,
+    ENERGY_STATE_LAST
+} ENERGY_state_t;
+
+/*!******************************************************************
+ * \fn ENERGY_get_timestamp_cb_t
+ * \brief Timestamp source callback (must be callable with interrupts disabled).
+ *******************************************************************/
+typedef uint32_t (*ENERGY_get_timestamp_cb_t)(void);
+
+/*!******************************************************************
+ * \struct ENERGY_report_t
+ * \brief Energy breakdown of a period.
+ *******************************************************************/
+typedef struct {
+    uint32_t period_ms;
+    uint32_t residency_ms[ENERGY_STATE_LAST];
+    uint32_t charge_uas[ENERGY_STATE_LAST];
+    uint32_t charge_total_uas;
+    uint32_t energy_total_uj;
+} ENERGY_report_t;
+
+/*** ENERGY functions ***/
+
+/*!******************************************************************
+ * \fn ENERGY_status_t ENERGY_init(ENERGY_get_timestamp_cb_t get_timestamp_callback)
+ * \brief Start residency accounting (states set before this call are taken into account from now).
+ * \param[in]   get_timestamp_callback: Function returning the current timestamp in us.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+ENERGY_status_t ENERGY_init(ENERGY_get_timestamp_cb_t get_timestamp_callback);
+
+/*!******************************************************************
+ * \fn void ENERGY_set_state(ENERGY_state_t state, uint8_t enable)
+ * \brief Signal a power state change (interrupt safe).
+ * \param[in]   state: Power state to update.
+ * \param[in]   enable: 0 when the state is left, the state is entered otherwise.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void ENERGY_set_state(ENERGY_state_t state, uint8_t enable);
+
+/*!******************************************************************
+ * \fn void ENERGY_process(void)
+ * \brief Accumulate residency of active states (must be called at least once per hour to avoid timestamp wrapping).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void ENERGY_process(void);
+
+/*!******************************************************************
+ * \fn ENERGY_status_t ENERGY_new_period(ENERGY_report_t* report)
+ * \brief Close current period and compute its energy breakdown from the board calibration table.
+ * \param[in]   none
+ * \param[out]  report: Pointer to the energy breakdown of the closed period.
+ * \retval      Function execution status.
+ *******************************************************************/
+ENERGY_status_t ENERGY_new_period(ENERGY_report_t* report);
+
+/*!******************************************************************
+ * \fn char_t* ENERGY_get_state_name(ENERGY_state_t state)
+ * \brief Get printable name of a power state.
+ * \param[in]   state: Power state.
+ * \param[out]  none
+ * \retval      Name of the state.
+ *******************************************************************/
+char_t* ENERGY_get_state_name(ENERGY_state_t state);
+
+/*******************************************************************/
+#define ENERGY_exit_error(base) { ERROR_check_exit(energy_status, ENERGY_SUCCESS, base) }
+
+/*******************************************************************/
+#define ENERGY_stack_error(base) { ERROR_check_stack(energy_status, ENERGY_SUCCESS, base) }
+
+/*******************************************************************/
+#define ENERGY_stack_exit_error(base, code) { ERROR_check_stack_exit(energy_status, ENERGY_SUCCESS, base, code) }
+
+#endif /* __ENERGY_H__ */
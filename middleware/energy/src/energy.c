@@ -0,0 +1,199 @@
+/*
+ * energy.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "energy.h"
+
+#include "error.h"
+#include "irq.h"
+#include "sen15901_emulator_flags.h"
+#include "types.h"
+
+/*** ENERGY local macros ***/
+
+#define ENERGY_US_PER_MS    1000
+#define ENERGY_US_PER_S     1000000
+
+/*** ENERGY local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t supply_voltage_mv;
+    uint32_t current_ua[ENERGY_STATE_LAST];
+} ENERGY_calibration_t;
+
+/*******************************************************************/
+typedef struct {
+    ENERGY_get_timestamp_cb_t get_timestamp_callback;
+    volatile uint32_t state_mask;
+    uint32_t state_timestamp_us[ENERGY_STATE_LAST];
+    uint64_t residency_us[ENERGY_STATE_LAST];
+    uint32_t period_start_us;
+} ENERGY_context_t;
+
+/*** ENERGY local global variables ***/
+
+// Typical board currents, to be updated with the measurements of each board revision.
+#ifdef HW1_0
+static const ENERGY_calibration_t ENERGY_CALIBRATION = {
+    .supply_voltage_mv = 3300,
+    .current_ua = {
+        1500, // Run (HSE, 16MHz).
+        600,  // Sleep (typical without sleep gating, the gated current has not been measured).
+        1500, // TCXO.
+        300,  // Terminal (USART).
+        2000, // LED run.
+        2000, // LED synchro.
+        2000, // LED fault.
+        50    // Charger disabled (control pin pull-up).
+    }
+};
+#endif
+
+static const char_t* const ENERGY_STATE_NAME[ENERGY_STATE_LAST] = {
+    "run",
+    "sleep",
+    "tcxo",
+    "terminal",
+    "led_run",
+    "led_synchro",
+    "led_fault",
+    "charger_disabled"
+};
+
+static ENERGY_context_t energy_ctx = {
+    .get_timestamp_callback = NULL,
+    .state_mask = 0,
+    .period_start_us = 0
+};
+
+/*** ENERGY local functions ***/
+
+/*******************************************************************/
+static void _ENERGY_accumulate(uint32_t timestamp_us) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Move elapsed time of active states to the accumulators (called with interrupts disabled).
+    for (idx = 0; idx < ENERGY_STATE_LAST; idx++) {
+        if ((energy_ctx.state_mask & (0b1 << idx)) == 0) continue;
+        energy_ctx.residency_us[idx] += (uint32_t) (timestamp_us - energy_ctx.state_timestamp_us[idx]);
+        energy_ctx.state_timestamp_us[idx] = timestamp_us;
+    }
+}
+
+/*** ENERGY functions ***/
+
+/*******************************************************************/
+ENERGY_status_t ENERGY_init(ENERGY_get_timestamp_cb_t get_timestamp_callback) {
+    // Local variables.
+    ENERGY_status_t status = ENERGY_SUCCESS;
+    uint32_t primask = 0;
+    uint32_t timestamp_us = 0;
+    uint8_t idx = 0;
+    // Check parameter.
+    if (get_timestamp_callback == NULL) {
+        status = ENERGY_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Reset accumulators.
+    IRQ_SAVE(primask);
+    energy_ctx.get_timestamp_callback = get_timestamp_callback;
+    timestamp_us = energy_ctx.get_timestamp_callback();
+    for (idx = 0; idx < ENERGY_STATE_LAST; idx++) {
+        energy_ctx.state_timestamp_us[idx] = timestamp_us;
+        energy_ctx.residency_us[idx] = 0;
+    }
+    energy_ctx.period_start_us = timestamp_us;
+    IRQ_RESTORE(primask);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+void ENERGY_set_state(ENERGY_state_t state, uint8_t enable) {
+    // Local variables.
+    uint32_t primask = 0;
+    uint32_t timestamp_us = 0;
+    uint32_t state_bit = (0b1 << state);
+    // Check parameter.
+    if (state >= ENERGY_STATE_LAST) return;
+    IRQ_SAVE(primask);
+    // Check transition.
+    if (((energy_ctx.state_mask & state_bit) != 0) != (enable != 0)) {
+        if (energy_ctx.get_timestamp_callback != NULL) {
+            timestamp_us = energy_ctx.get_timestamp_callback();
+            if (enable == 0) {
+                energy_ctx.residency_us[state] += (uint32_t) (timestamp_us - energy_ctx.state_timestamp_us[state]);
+            }
+            else {
+                energy_ctx.state_timestamp_us[state] = timestamp_us;
+            }
+        }
+        energy_ctx.state_mask ^= state_bit;
+    }
+    IRQ_RESTORE(primask);
+}
+
+/*******************************************************************/
+void ENERGY_process(void) {
+    // Local variables.
+    uint32_t primask = 0;
+    // Check state.
+    if (energy_ctx.get_timestamp_callback == NULL) return;
+    IRQ_SAVE(primask);
+    _ENERGY_accumulate(energy_ctx.get_timestamp_callback());
+    IRQ_RESTORE(primask);
+}
+
+/*******************************************************************/
+ENERGY_status_t ENERGY_new_period(ENERGY_report_t* report) {
+    // Local variables.
+    ENERGY_status_t status = ENERGY_SUCCESS;
+    uint64_t residency_us[ENERGY_STATE_LAST];
+    uint64_t charge_total_uas = 0;
+    uint32_t period_us = 0;
+    uint32_t timestamp_us = 0;
+    uint32_t primask = 0;
+    uint8_t idx = 0;
+    // Check parameters.
+    if (report == NULL) {
+        status = ENERGY_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (energy_ctx.get_timestamp_callback == NULL) {
+        status = ENERGY_ERROR_STATE;
+        goto errors;
+    }
+    // Snapshot and reset accumulators.
+    IRQ_SAVE(primask);
+    timestamp_us = energy_ctx.get_timestamp_callback();
+    _ENERGY_accumulate(timestamp_us);
+    for (idx = 0; idx < ENERGY_STATE_LAST; idx++) {
+        residency_us[idx] = energy_ctx.residency_us[idx];
+        energy_ctx.residency_us[idx] = 0;
+    }
+    period_us = (timestamp_us - energy_ctx.period_start_us);
+    energy_ctx.period_start_us = timestamp_us;
+    IRQ_RESTORE(primask);
+    // Run residency is the complement of sleep.
+    residency_us[ENERGY_STATE_RUN] = (residency_us[ENERGY_STATE_SLEEP] < period_us) ? (period_us - residency_us[ENERGY_STATE_SLEEP]) : 0;
+    // Compute breakdown.
+    report->period_ms = (period_us / ENERGY_US_PER_MS);
+    for (idx = 0; idx < ENERGY_STATE_LAST; idx++) {
+        report->residency_ms[idx] = (uint32_t) (residency_us[idx] / ENERGY_US_PER_MS);
+        report->charge_uas[idx] = (uint32_t) ((residency_us[idx] * ENERGY_CALIBRATION.current_ua[idx]) / ENERGY_US_PER_S);
+        charge_total_uas += report->charge_uas[idx];
+    }
+    report->charge_total_uas = (uint32_t) charge_total_uas;
+    report->energy_total_uj = (uint32_t) ((charge_total_uas * ENERGY_CALIBRATION.supply_voltage_mv) / ENERGY_US_PER_MS);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+char_t* ENERGY_get_state_name(ENERGY_state_t state) {
+    return ((char_t*) ((state < ENERGY_STATE_LAST) ? ENERGY_STATE_NAME[state] : "unknown"));
+}
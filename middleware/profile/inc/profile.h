@@ -0,0 +1,113 @@
+/*
+ * profile.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+#include "error.h"
+#include "types.h"
+
+/*** PROFILE macros ***/
+
+// Output is (base + amplitude * shape) with a normalized shape, amplitude is limited to keep the product on 32 bits.
+#define PROFILE_AMPLITUDE_CKMH_MAX      0xFFFF
+
+/*** PROFILE structures ***/
+
+/*!******************************************************************
+ * \enum PROFILE_status_t
+ * \brief Wind profiles library error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    PROFILE_SUCCESS = 0,
+    PROFILE_ERROR_NULL_PARAMETER,
+    PROFILE_ERROR_TYPE,
+    PROFILE_ERROR_PERIOD,
+    PROFILE_ERROR_AMPLITUDE,
+    // Last base value.
+    PROFILE_ERROR_BASE_LAST = ERROR_BASE_STEP
+} PROFILE_status_t;
+
+/*!******************************************************************
+ * \enum PROFILE_type_t
+ * \brief Wind profiles list.
+ *******************************************************************/
+typedef enum {
+    PROFILE_TYPE_STEP = 0,
+    PROFILE_TYPE_RAMP,
+    PROFILE_TYPE_SINE,
+    PROFILE_TYPE_GUST_BURST,
+    PROFILE_TYPE_EXPONENTIAL_DECAY,
+    PROFILE_TYPE_SQUARE_GUSTS,
+    PROFILE_TYPE_LAST
+} PROFILE_type_t;
+
+/*!******************************************************************
+ * \struct PROFILE_configuration_t
+ * \brief Wind profile parameters.
+ *******************************************************************/
+typedef struct {
+    PROFILE_type_t type;
+    uint32_t base_ckmh;
+    uint32_t amplitude_ckmh;
+    // Base wind speed is held during the delay.
+    uint32_t delay_ticks;
+    // Shape duration (cycle of periodic profiles), not used by the step profile.
+    uint32_t period_ticks;
+    // High time of square gusts in 1/256 of the period.
+    uint8_t duty_q8;
+} PROFILE_configuration_t;
+
+/*** PROFILE functions ***/
+
+/*!******************************************************************
+ * \fn void PROFILE_init(void)
+ * \brief Stop current profile (output is 0 until the next start).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void PROFILE_init(void);
+
+/*!******************************************************************
+ * \fn PROFILE_status_t PROFILE_start(const PROFILE_configuration_t* configuration)
+ * \brief Start a wind profile from its first tick.
+ * \param[in]   configuration: Pointer to the profile parameters.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+PROFILE_status_t PROFILE_start(const PROFILE_configuration_t* configuration);
+
+/*!******************************************************************
+ * \fn void PROFILE_seek(uint32_t tick_count)
+ * \brief Move the current profile as if it had been processed during the given number of ticks (constant time).
+ * \param[in]   tick_count: Number of ticks elapsed since the profile start.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void PROFILE_seek(uint32_t tick_count);
+
+/*!******************************************************************
+ * \fn PROFILE_status_t PROFILE_process(uint32_t* wind_speed_ckmh)
+ * \brief Compute the wind speed of the current tick and move to the next one.
+ * \param[in]   none
+ * \param[out]  wind_speed_ckmh: Pointer to the wind speed in ckm/h.
+ * \retval      Function execution status.
+ *******************************************************************/
+PROFILE_status_t PROFILE_process(uint32_t* wind_speed_ckmh);
+
+/*******************************************************************/
+#define PROFILE_exit_error(base) { ERROR_check_exit(profile_status, PROFILE_SUCCESS, base) }
+
+/*******************************************************************/
+#define PROFILE_stack_error(base) { ERROR_check_stack(profile_status, PROFILE_SUCCESS, base) }
+
+/*******************************************************************/
+#define PROFILE_stack_exit_error(base, code) { ERROR_check_stack_exit(profile_status, PROFILE_SUCCESS, base, code) }
+
+#endif /* __PROFILE_H__ */
@@ -0,0 +1,48 @@
+/*
+ * profile_tables.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+// Generated by script/profile_tables.py, do not edit. Included by profile.c only.
+
+#ifndef __PROFILE_TABLES_H__
+#define __PROFILE_TABLES_H__
+
+#include "types.h"
+
+/*** PROFILE tables ***/
+
+#define PROFILE_TABLE_SIZE          64
+#define PROFILE_TABLE_SIZE_BITS     6
+#define PROFILE_Q                   16
+
+// Sine wave (1 + sin(2.pi.x)) / 2 for x=i/64 in Q16 format.
+static const uint16_t PROFILE_TABLE_SINE[PROFILE_TABLE_SIZE + 1] = {
+    32768, 35980, 39161, 42280, 45308, 48215, 50973, 53556, 55938, 58098, 60014, 61667, 63042, 64125, 64906, 65378,
+    65535, 65378, 64906, 64125, 63042, 61667, 60014, 58098, 55938, 53556, 50973, 48215, 45308, 42280, 39161, 35980,
+    32768, 29556, 26375, 23256, 20228, 17321, 14563, 11980, 9598, 7438, 5522, 3869, 2494, 1411, 630, 158,
+    0, 158, 630, 1411, 2494, 3869, 5522, 7438, 9598, 11980, 14563, 17321, 20228, 23256, 26375, 29556,
+    32768
+};
+
+// Gust burst (1 - cos(2.pi.x)) / 2 for x=i/64 in Q16 format.
+static const uint16_t PROFILE_TABLE_GUST_BURST[PROFILE_TABLE_SIZE + 1] = {
+    0, 158, 630, 1411, 2494, 3869, 5522, 7438, 9598, 11980, 14563, 17321, 20228, 23256, 26375, 29556,
+    32768, 35980, 39161, 42280, 45308, 48215, 50973, 53556, 55938, 58098, 60014, 61667, 63042, 64125, 64906, 65378,
+    65535, 65378, 64906, 64125, 63042, 61667, 60014, 58098, 55938, 53556, 50973, 48215, 45308, 42280, 39161, 35980,
+    32768, 29556, 26375, 23256, 20228, 17321, 14563, 11980, 9598, 7438, 5522, 3869, 2494, 1411, 630, 158,
+    0
+};
+
+// Exponential decay exp(-4.x) for x=i/64 in Q16 format.
+static const uint16_t PROFILE_TABLE_EXPONENTIAL_DECAY[PROFILE_TABLE_SIZE + 1] = {
+    65535, 61565, 57835, 54331, 51039, 47947, 45042, 42313, 39750, 37341, 35079, 32954, 30957, 29081, 27319, 25664,
+    24109, 22649, 21276, 19987, 18776, 17639, 16570, 15566, 14623, 13737, 12905, 12123, 11388, 10698, 10050, 9441,
+    8869, 8332, 7827, 7353, 6907, 6489, 6096, 5726, 5380, 5054, 4747, 4460, 4190, 3936, 3697, 3473,
+    3263, 3065, 2879, 2705, 2541, 2387, 2243, 2107, 1979, 1859, 1746, 1641, 1541, 1448, 1360, 1278,
+    1200
+};
+
+#endif /* __PROFILE_TABLES_H__ */
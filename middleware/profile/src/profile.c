@@ -0,0 +1,227 @@
+/*
+ * profile.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "profile.h"
+
+#include "error.h"
+#include "profile_tables.h"
+#include "types.h"
+
+/*** PROFILE local macros ***/
+
+// Profile phase is a 24 bits fraction of the period: table index on the upper bits, interpolation fraction on the next 8 bits.
+#define PROFILE_PHASE_SIZE_BITS         24
+#define PROFILE_PHASE_FULL              (1UL << PROFILE_PHASE_SIZE_BITS)
+#define PROFILE_PHASE_HALF              (PROFILE_PHASE_FULL >> 1)
+#define PROFILE_PHASE_INDEX_SHIFT       (PROFILE_PHASE_SIZE_BITS - PROFILE_TABLE_SIZE_BITS)
+#define PROFILE_PHASE_FRACTION_SHIFT    (PROFILE_PHASE_INDEX_SHIFT - 8)
+#define PROFILE_PHASE_FRACTION_MASK     0xFF
+#define PROFILE_DUTY_SHIFT              (PROFILE_PHASE_SIZE_BITS - 8)
+
+#define PROFILE_SHAPE_FULL_SCALE        (1UL << PROFILE_Q)
+// Rising half of the ramp goes from 0 to full scale.
+#define PROFILE_RAMP_SHIFT              (PROFILE_PHASE_SIZE_BITS - PROFILE_Q - 1)
+
+/*** PROFILE local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    PROFILE_type_t type;
+    uint32_t base_ckmh;
+    uint32_t amplitude_ckmh;
+    uint32_t delay_ticks;
+    uint32_t period_ticks;
+    uint32_t duty_phase;
+    // Phase increment per tick is (PROFILE_PHASE_FULL / period_ticks), the remainder is spread over the period.
+    uint32_t phase;
+    uint32_t phase_step;
+    uint32_t phase_remainder;
+    uint32_t phase_error;
+} PROFILE_context_t;
+
+/*** PROFILE local global variables ***/
+
+static PROFILE_context_t profile_ctx = {
+    .type = PROFILE_TYPE_LAST,
+    .base_ckmh = 0,
+    .amplitude_ckmh = 0,
+    .delay_ticks = 0,
+    .period_ticks = 0,
+    .duty_phase = 0,
+    .phase = 0,
+    .phase_step = 0,
+    .phase_remainder = 0,
+    .phase_error = 0
+};
+
+/*** PROFILE local functions ***/
+
+/*******************************************************************/
+static uint32_t _PROFILE_interpolate(const uint16_t* table, uint32_t phase) {
+    // Local variables.
+    uint32_t idx = (phase >> PROFILE_PHASE_INDEX_SHIFT);
+    int32_t fraction = (int32_t) ((phase >> PROFILE_PHASE_FRACTION_SHIFT) & PROFILE_PHASE_FRACTION_MASK);
+    uint32_t value = 0;
+    // End of one-shot profiles gives the guard value.
+    if (idx >= PROFILE_TABLE_SIZE) {
+        value = table[PROFILE_TABLE_SIZE];
+    }
+    else {
+        value = (uint32_t) (((int32_t) table[idx]) + (((((int32_t) table[idx + 1]) - ((int32_t) table[idx])) * fraction) >> 8));
+    }
+    return value;
+}
+
+/*** PROFILE functions ***/
+
+/*******************************************************************/
+void PROFILE_init(void) {
+    // Reset context.
+    profile_ctx.type = PROFILE_TYPE_LAST;
+    profile_ctx.base_ckmh = 0;
+    profile_ctx.amplitude_ckmh = 0;
+    profile_ctx.delay_ticks = 0;
+    profile_ctx.period_ticks = 0;
+    profile_ctx.duty_phase = 0;
+    profile_ctx.phase = 0;
+    profile_ctx.phase_step = 0;
+    profile_ctx.phase_remainder = 0;
+    profile_ctx.phase_error = 0;
+}
+
+/*******************************************************************/
+PROFILE_status_t PROFILE_start(const PROFILE_configuration_t* configuration) {
+    // Local variables.
+    PROFILE_status_t status = PROFILE_SUCCESS;
+    // Check parameters.
+    if (configuration == NULL) {
+        status = PROFILE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if (configuration->type >= PROFILE_TYPE_LAST) {
+        status = PROFILE_ERROR_TYPE;
+        goto errors;
+    }
+    if ((configuration->type != PROFILE_TYPE_STEP) && ((configuration->period_ticks == 0) || (configuration->period_ticks > PROFILE_PHASE_FULL))) {
+        status = PROFILE_ERROR_PERIOD;
+        goto errors;
+    }
+    if (configuration->amplitude_ckmh > PROFILE_AMPLITUDE_CKMH_MAX) {
+        status = PROFILE_ERROR_AMPLITUDE;
+        goto errors;
+    }
+    // Store parameters.
+    profile_ctx.type = configuration->type;
+    profile_ctx.base_ckmh = configuration->base_ckmh;
+    profile_ctx.amplitude_ckmh = configuration->amplitude_ckmh;
+    profile_ctx.delay_ticks = configuration->delay_ticks;
+    profile_ctx.period_ticks = configuration->period_ticks;
+    profile_ctx.duty_phase = (((uint32_t) configuration->duty_q8) << PROFILE_DUTY_SHIFT);
+    // Only divisions of the profile, done once per period.
+    profile_ctx.phase = 0;
+    profile_ctx.phase_step = (configuration->period_ticks == 0) ? 0 : (PROFILE_PHASE_FULL / configuration->period_ticks);
+    profile_ctx.phase_remainder = (configuration->period_ticks == 0) ? 0 : (PROFILE_PHASE_FULL % configuration->period_ticks);
+    profile_ctx.phase_error = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+void PROFILE_seek(uint32_t tick_count) {
+    // Local variables.
+    uint32_t ticks = tick_count;
+    // No profile started.
+    if (profile_ctx.type >= PROFILE_TYPE_LAST) goto errors;
+    // Initial delay (also applies to the step profile).
+    if (ticks < profile_ctx.delay_ticks) {
+        profile_ctx.delay_ticks -= ticks;
+        goto errors;
+    }
+    ticks -= profile_ctx.delay_ticks;
+    profile_ctx.delay_ticks = 0;
+    // Step profile has no phase.
+    if (profile_ctx.period_ticks == 0) goto errors;
+    // End of one-shot profiles.
+    if (((profile_ctx.type == PROFILE_TYPE_GUST_BURST) || (profile_ctx.type == PROFILE_TYPE_EXPONENTIAL_DECAY)) && (ticks >= profile_ctx.period_ticks)) {
+        profile_ctx.phase = PROFILE_PHASE_FULL;
+        profile_ctx.phase_step = 0;
+        profile_ctx.phase_remainder = 0;
+        goto errors;
+    }
+    // Phase and remainder reached after the given number of ticks within the cycle.
+    ticks %= profile_ctx.period_ticks;
+    profile_ctx.phase = (ticks * profile_ctx.phase_step) + (uint32_t) ((((uint64_t) ticks) * profile_ctx.phase_remainder) / profile_ctx.period_ticks);
+    profile_ctx.phase_error = (uint32_t) ((((uint64_t) ticks) * profile_ctx.phase_remainder) % profile_ctx.period_ticks);
+errors:
+    return;
+}
+
+/*******************************************************************/
+PROFILE_status_t PROFILE_process(uint32_t* wind_speed_ckmh) {
+    // Local variables.
+    PROFILE_status_t status = PROFILE_SUCCESS;
+    uint32_t shape_q16 = 0;
+    // Check parameter.
+    if (wind_speed_ckmh == NULL) {
+        status = PROFILE_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*wind_speed_ckmh) = 0;
+    // No profile started.
+    if (profile_ctx.type >= PROFILE_TYPE_LAST) goto errors;
+    // Initial delay.
+    if (profile_ctx.delay_ticks != 0) {
+        profile_ctx.delay_ticks--;
+        (*wind_speed_ckmh) = profile_ctx.base_ckmh;
+        goto errors;
+    }
+    // Evaluate normalized shape.
+    switch (profile_ctx.type) {
+    case PROFILE_TYPE_STEP:
+        shape_q16 = PROFILE_SHAPE_FULL_SCALE;
+        break;
+    case PROFILE_TYPE_RAMP:
+        // Triangle: up during the first half of the period, down during the second one.
+        shape_q16 = (profile_ctx.phase < PROFILE_PHASE_HALF) ? (profile_ctx.phase >> PROFILE_RAMP_SHIFT) : ((PROFILE_PHASE_FULL - profile_ctx.phase) >> PROFILE_RAMP_SHIFT);
+        break;
+    case PROFILE_TYPE_SINE:
+        shape_q16 = _PROFILE_interpolate(PROFILE_TABLE_SINE, profile_ctx.phase);
+        break;
+    case PROFILE_TYPE_GUST_BURST:
+        shape_q16 = _PROFILE_interpolate(PROFILE_TABLE_GUST_BURST, profile_ctx.phase);
+        break;
+    case PROFILE_TYPE_EXPONENTIAL_DECAY:
+        shape_q16 = _PROFILE_interpolate(PROFILE_TABLE_EXPONENTIAL_DECAY, profile_ctx.phase);
+        break;
+    case PROFILE_TYPE_SQUARE_GUSTS:
+        shape_q16 = (profile_ctx.phase < profile_ctx.duty_phase) ? PROFILE_SHAPE_FULL_SCALE : 0;
+        break;
+    default:
+        break;
+    }
+    (*wind_speed_ckmh) = profile_ctx.base_ckmh + (((profile_ctx.amplitude_ckmh * shape_q16) + (PROFILE_SHAPE_FULL_SCALE >> 1)) >> PROFILE_Q);
+    // Move to next tick.
+    profile_ctx.phase += profile_ctx.phase_step;
+    profile_ctx.phase_error += profile_ctx.phase_remainder;
+    if ((profile_ctx.phase_remainder != 0) && (profile_ctx.phase_error >= profile_ctx.period_ticks)) {
+        profile_ctx.phase_error -= profile_ctx.period_ticks;
+        profile_ctx.phase++;
+    }
+    if (profile_ctx.phase >= PROFILE_PHASE_FULL) {
+        // Burst and decay are played once, the other profiles are periodic.
+        if ((profile_ctx.type == PROFILE_TYPE_GUST_BURST) || (profile_ctx.type == PROFILE_TYPE_EXPONENTIAL_DECAY)) {
+            profile_ctx.phase = PROFILE_PHASE_FULL;
+            profile_ctx.phase_step = 0;
+            profile_ctx.phase_remainder = 0;
+        }
+        else {
+            profile_ctx.phase -= PROFILE_PHASE_FULL;
+        }
+    }
+errors:
+    return status;
+}
@@ -8,11 +8,18 @@
 #ifndef __SIMULATION_H__
 #define __SIMULATION_H__
 
+#include "cluster.h"
+#include "coverage.h"
+#include "energy.h"
 #include "error.h"
+#include "nvm.h"
+#include "profile.h"
 #include "sen15901.h"
+#include "stress.h"
 #include "tim.h"
 #include "types.h"
 #include "usart.h"
+#include "weather.h"
 
 /*** SIMULATION structures ***/
 
@@ -23,11 +30,25 @@
 typedef enum {
     // Driver errors.
     SIMULATION_SUCCESS = 0,
+    SIMULATION_ERROR_PERSONALITY,
+    SIMULATION_ERROR_INVARIANT_WIND_SPEED_PEAK,
+    SIMULATION_ERROR_INVARIANT_WIND_SPEED_RAMP,
+    SIMULATION_ERROR_INVARIANT_RAINFALL_PEAK,
+    SIMULATION_ERROR_INVARIANT_SYNCHRO_WINDOW,
+    SIMULATION_ERROR_SEEK_TICK,
+    SIMULATION_ERROR_TIMER_RESOLUTION,
     // Low level driver errors.
     SIMULATION_ERROR_BASE_WAVEFORM_TIMER = ERROR_BASE_STEP,
     SIMULATION_ERROR_BASE_SEN15901 = (SIMULATION_ERROR_BASE_WAVEFORM_TIMER + TIM_ERROR_BASE_LAST),
+    SIMULATION_ERROR_BASE_WEATHER = (SIMULATION_ERROR_BASE_SEN15901 + SEN15901_ERROR_BASE_LAST),
+    SIMULATION_ERROR_BASE_STRESS = (SIMULATION_ERROR_BASE_WEATHER + WEATHER_ERROR_BASE_LAST),
+    SIMULATION_ERROR_BASE_ENERGY = (SIMULATION_ERROR_BASE_STRESS + STRESS_ERROR_BASE_LAST),
+    SIMULATION_ERROR_BASE_NVM = (SIMULATION_ERROR_BASE_ENERGY + ENERGY_ERROR_BASE_LAST),
+    SIMULATION_ERROR_BASE_CLUSTER = (SIMULATION_ERROR_BASE_NVM + NVM_ERROR_BASE_LAST),
+    SIMULATION_ERROR_BASE_PROFILE = (SIMULATION_ERROR_BASE_CLUSTER + CLUSTER_ERROR_BASE_LAST),
+    SIMULATION_ERROR_BASE_COVERAGE = (SIMULATION_ERROR_BASE_PROFILE + PROFILE_ERROR_BASE_LAST),
     // Last base value.
-    SIMULATION_ERROR_BASE_LAST = (SIMULATION_ERROR_BASE_SEN15901 + SEN15901_ERROR_BASE_LAST)
+    SIMULATION_ERROR_BASE_LAST = (SIMULATION_ERROR_BASE_COVERAGE + COVERAGE_ERROR_BASE_LAST)
 } SIMULATION_status_t;
 
 /*** SIMULATION functions ***/
@@ -68,6 +89,26 @@ SIMULATION_status_t SIMULATION_start(void);
  *******************************************************************/
 SIMULATION_status_t SIMULATION_stop(void);
 
+/*!******************************************************************
+ * \fn SIMULATION_status_t SIMULATION_set_personality(SEN15901_personality_t personality)
+ * \brief Switch the emulated sensor variant and store it as boot personality (the simulation is restarted if running).
+ * \param[in]   personality: Sensor variant to emulate.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SIMULATION_status_t SIMULATION_set_personality(SEN15901_personality_t personality);
+
+/*!******************************************************************
+ * \fn SIMULATION_status_t SIMULATION_seek(uint32_t step, uint32_t tick)
+ * \brief Move the simulation to a tick of any campaign step in constant time (ramps, rainfall and profile are positioned, weather and stress models keep their state).
+ * \note        Called on the SEEK command, once the DUT period has been restarted.
+ * \param[in]   step: Campaign step to reach.
+ * \param[in]   tick: Number of ticks elapsed since the synchronization which started the step.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+SIMULATION_status_t SIMULATION_seek(uint32_t step, uint32_t tick);
+
 /*!******************************************************************
  * \fn SIMULATION_status_t SIMULATION_process(void)
  * \brief Process SEN15901 simulation.
@@ -7,19 +7,39 @@
 
 #include "simulation.h"
 
+#include "energy.h"
+#include "boot.h"
+#include "capture.h"
+#include "cluster.h"
+#include "coverage.h"
 #include "error.h"
 #include "error_base.h"
+#include "event_queue.h"
 #include "exti.h"
 #include "nvic_priority.h"
 #include "gpio.h"
+#include "history.h"
+#include "irq.h"
 #include "mcu_mapping.h"
+#include "nvm.h"
+#include "nvm_address.h"
+#include "profile.h"
+#include "ramfunc.h"
 #include "rtc.h"
 #include "sen15901.h"
 #include "sen15901_emulator_flags.h"
+#include "stress.h"
+#include "synchro.h"
 #include "terminal.h"
+#include "terminal_hw.h"
 #include "tim.h"
+#include "tim_registers.h"
+#include "timebase.h"
+#include "trace.h"
 #include "types.h"
+#include "usart_registers.h"
 #include "version.h"
+#include "weather.h"
 
 /*** SIMULATION local macros ***/
 
@@ -28,78 +48,835 @@
 #define SIMULATION_RAINFALL_IRQ_COUNT_MAX       110
 #define SIMULATION_RAINFALL_TIMESTAMP_MS        180000
 
-#ifdef SEN15901_MODE_ULTIMETER
-#define SIMULATION_WAVEFORM_TIMER_PERIOD_MS     6001
-#else
-#define SIMULATION_WAVEFORM_TIMER_PERIOD_MS     3001
-#endif
-
 #define SIMULATION_DUT_SYNCHRO_IRQ_FILTER_MS    60000
 
 #define SIMULATION_LOG_BAUD_RATE                9600
 #define SIMULATION_LOG_LINE_END                 "\r\n"
+// History is replayed on attach, one record per pass (about 50ms at 9600 bauds), the newest records are kept when the budget is exhausted.
+#define SIMULATION_HISTORY_REPLAY_RECORDS       32
+#define SIMULATION_HISTORY_REPLAY_PASS_RECORDS  1
+#define SIMULATION_HISTORY_REPLAY_BUDGET_MS     2000
 
 #define SIMULATION_FAULT_TIME_THRESHOLD_MS      3900000
+// Erased NVM reads 0x00: the boot personality is valid only when preceded by this header.
+#define SIMULATION_PERSONALITY_HEADER           0xA3
+
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+#define SIMULATION_DUT_SYNCHRO_TRIGGER          EXTI_TRIGGER_ANY_EDGE
+#else
+#define SIMULATION_DUT_SYNCHRO_TRIGGER          EXTI_TRIGGER_RISING_EDGE
+#endif
+
+#define SIMULATION_TIM_SR_UIF                   0x00000001
+// Synchronization event data is ((command << 28) | (tick << 16) | argument), or the leader step in cluster follower mode.
+#define SIMULATION_SYNCHRO_EVENT_COMMAND_SHIFT  28
+#define SIMULATION_SYNCHRO_EVENT_TICK_SHIFT     16
+#define SIMULATION_SYNCHRO_EVENT_TICK_MASK      0x0FFF
+#define SIMULATION_SYNCHRO_EVENT_ARGUMENT_MASK  0xFFFF
+#define SIMULATION_US_PER_MS                    1000
+
+// Ticks are divided in sub-ticks of (tick_period_ms / SIMULATION_SUBTICK_NUMBER), an integer number of microseconds.
+// The waveform timer interrupts on each sub-tick during a vane rotation (or in cluster follower mode), and once per tick otherwise.
+#define SIMULATION_SUBTICK_NUMBER               250
+
+#if ((defined SEN15901_EMULATOR_MODE_WEATHER) && (defined SEN15901_EMULATOR_MODE_STRESS))
+#error "Weather and stress modes are mutually exclusive"
+#endif
+#if ((defined SEN15901_EMULATOR_MODE_PROFILE) && ((defined SEN15901_EMULATOR_MODE_WEATHER) || (defined SEN15901_EMULATOR_MODE_STRESS)))
+#error "Profile mode is not compatible with weather and stress modes"
+#endif
+#if ((defined SEN15901_EMULATOR_CLUSTER_LEADER) && (defined SEN15901_EMULATOR_CLUSTER_FOLLOWER))
+#error "Cluster leader and follower modes are mutually exclusive"
+#endif
+#if (((defined SEN15901_EMULATOR_CLUSTER_LEADER) || (defined SEN15901_EMULATOR_CLUSTER_FOLLOWER)) && (defined SEN15901_EMULATOR_MODE_STRESS))
+#error "Cluster modes use the log interface and are not compatible with stress mode"
+#endif
+#if ((defined SEN15901_EMULATOR_CLUSTER_FOLLOWER) && (defined SEN15901_EMULATOR_SYNCHRO_COMMAND))
+#error "Cluster follower takes its campaign steps from the leader"
+#endif
+#if ((defined SEN15901_EMULATOR_COVERAGE_CHECKPOINT) && !(defined SEN15901_EMULATOR_COVERAGE))
+#error "Coverage checkpoint requires coverage histograms"
+#endif
+#ifdef SEN15901_EMULATOR_COVERAGE_CHECKPOINT
+_Static_assert((NVM_ADDRESS_LAST - NVM_ADDRESS_COVERAGE) == COVERAGE_CHECKPOINT_SIZE_BYTES, "NVM coverage area does not match the checkpoint size");
+#endif
+
+// Log terminal is kept opened to exchange data with the test bench or the other emulators.
+#if ((defined SEN15901_EMULATOR_MODE_STRESS) || (defined SEN15901_EMULATOR_CLUSTER_LEADER) || (defined SEN15901_EMULATOR_CLUSTER_FOLLOWER))
+#define SIMULATION_TERMINAL_PERSISTENT
+#endif
+#if ((defined SEN15901_EMULATOR_MODE_STRESS) || (defined SEN15901_EMULATOR_CLUSTER_FOLLOWER))
+#define SIMULATION_LOG_RX_CALLBACK              &_SIMULATION_log_rx_callback
+#else
+#define SIMULATION_LOG_RX_CALLBACK              NULL
+#endif
+
+#ifdef SEN15901_EMULATOR_CLUSTER_LEADER
+#define SIMULATION_USART_ISR_TC                 0x00000040
+#define SIMULATION_USART_TC_TIMEOUT_COUNT       100000
+#endif
+#ifdef SEN15901_EMULATOR_CLUSTER_FOLLOWER
+// Received byte is available in the middle of the stop bit (9.5 bits after the start bit).
+#define SIMULATION_CLUSTER_RX_LATENCY_US        ((95 * 100000) / SIMULATION_LOG_BAUD_RATE)
+// Phase is stepped when not locked or above (tick_period / 16), and slewed by (subtick_period / 16) per timer interrupt otherwise.
+#define SIMULATION_CLUSTER_PHASE_STEP_SHIFT     4
+#define SIMULATION_CLUSTER_SLEW_SHIFT           4
+#endif
+
+#ifdef SEN15901_EMULATOR_MODE_WEATHER
+#define SIMULATION_WEATHER_WIND_SPEED_SCALE_CKMH    2500
+#define SIMULATION_WEATHER_GUST_INTENSITY_Q8        64
+#define SIMULATION_WEATHER_GUST_FILTER_SHIFT        2
+#define SIMULATION_WEATHER_WIND_DIRECTION_DEGREES   225
+#define SIMULATION_WEATHER_WIND_DIRECTION_STEP      10
+#define SIMULATION_WEATHER_WIND_DIRECTION_SHIFT     4
+#define SIMULATION_WEATHER_RAIN_START_PROBABILITY   328
+#define SIMULATION_WEATHER_RAIN_STOP_PROBABILITY    1638
+#define SIMULATION_WEATHER_RAIN_PULSE_PROBABILITY   16384
+#endif
+
+#ifdef SEN15901_EMULATOR_MODE_PROFILE
+#define SIMULATION_PROFILE_SCHEDULE_SIZE            6
+#endif
+
+#define SIMULATION_SIGNATURE_CRC32_INIT             0xFFFFFFFF
+#define SIMULATION_SIGNATURE_CRC32_TABLE_SIZE       16
 
 /*** SIMULATION local structures ***/
 
+/*******************************************************************/
+typedef enum {
+    SIMULATION_SIGNATURE_OUTPUT_WIND_SPEED = 0,
+    SIMULATION_SIGNATURE_OUTPUT_WIND_DIRECTION,
+    SIMULATION_SIGNATURE_OUTPUT_RAINFALL_PULSE,
+    SIMULATION_SIGNATURE_OUTPUT_STRESS_FREQUENCY,
+    SIMULATION_SIGNATURE_OUTPUT_LAST
+} SIMULATION_signature_output_t;
+
 /*******************************************************************/
 typedef union {
     uint8_t all;
     struct {
         unsigned wind_speed_down :1;
-        unsigned timer :1;
-        unsigned synchro :1;
-        unsigned first_synchro :1;
-        unsigned synchro_irq_enable :1;
+        unsigned energy_report :1;
+        unsigned running :1;
+        unsigned synchro_missed :1;
+        unsigned log_attached :1;
     } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
 } SIMULATION_flags_t;
 
 /*******************************************************************/
 typedef struct {
-    // State machine.
+    // State machine (flags are only written by the main context).
     volatile SIMULATION_flags_t flags;
     volatile uint32_t time_ms;
+    // Interrupts to main context.
+    EVENT_QUEUE_t timer_queue;
+    EVENT_QUEUE_t synchro_queue;
+    volatile uint8_t first_synchro;
+    volatile uint8_t synchro_irq_enable;
+    volatile uint8_t usb_detect_event;
+    // Personality.
+    uint32_t tick_period_ms;
+    SEN15901_commit_cb_t sen15901_commit;
+    // Tick phase.
+    volatile uint32_t tick_count;
+    volatile uint32_t subtick_count;
+    uint32_t subtick_period_us;
+    uint32_t timer_us_per_count_q8;
+    uint32_t timer_tick_counts;
+    uint32_t timer_subtick_counts;
+    // Current waveform timer period.
+    volatile uint32_t period_subtick_number;
+    volatile uint32_t period_us;
     // Amplitudes.
     uint32_t wind_speed_peak_kmh;
     uint32_t wind_direction_table_index;
     uint32_t rainfall_peak_irq_count;
+    uint32_t campaign_step;
     // Values within period.
     uint32_t wind_speed_kmh;
     uint32_t rainfall_irq_count;
+#ifdef SEN15901_EMULATOR_CHECK_INVARIANTS
+    uint32_t wind_speed_previous_kmh;
+#endif
+#ifdef SEN15901_EMULATOR_MODE_WEATHER
+    WEATHER_output_t weather_output;
+#endif
+#ifdef SEN15901_EMULATOR_MODE_PROFILE
+    uint32_t profile_wind_speed_ckmh;
+#endif
+    // Energy breakdown of the last period.
+    ENERGY_report_t energy_report;
+    // Period dependent thresholds.
+    volatile uint32_t synchro_filter_ms;
+    volatile uint32_t fault_threshold_ms;
+    volatile uint32_t rainfall_timestamp_ms;
+    // DUT period learning.
+    uint32_t synchro_previous_timestamp_ms;
+    uint32_t synchro_pulse_timestamp_ms;
+    uint32_t synchro_count;
+    uint32_t synchro_missed_count;
+    volatile uint32_t synchro_early_count;
+    volatile uint32_t synchro_early_timestamp_ms;
+    volatile uint8_t synchro_early_event;
+    volatile uint8_t synchro_locked;
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+    // DUT commands.
+    uint32_t synchro_rising_timestamp_us;
+#endif
+    // Outputs signature.
+    uint32_t signature;
+    uint32_t signature_tick;
+    uint32_t signature_last;
+    uint32_t signature_period;
+#ifdef SEN15901_EMULATOR_CLUSTER_FOLLOWER
+    // Lockstep with the leader.
+    volatile int32_t cluster_phase_error_us;
+    volatile int32_t cluster_skew_us;
+    volatile uint8_t cluster_locked;
+#endif
+#ifdef SEN15901_EMULATOR_COVERAGE
+    // Histograms dump requested by the DUT.
+    volatile uint8_t coverage_request;
+    // Values staged for the next tick (bit field of the staged outputs).
+    uint32_t coverage_wind_speed_ckmh;
+    uint32_t coverage_wind_direction_degrees;
+    uint8_t coverage_staged;
+#endif
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+    // Personality switch requested by the DUT (SEN15901_PERSONALITY_LAST if none).
+    volatile uint8_t personality_request;
+#endif
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+    // Wind speed pulse count at the last accepted synchronization.
+    volatile uint32_t stress_pulse_origin;
+#endif
 } SIMULATION_context_t;
 
 /*** SIMULATION local global variables ***/
 
+// CRC32 (IEEE 802.3 reflected polynomial) nibble table.
+static const uint32_t SIMULATION_SIGNATURE_CRC32_TABLE[SIMULATION_SIGNATURE_CRC32_TABLE_SIZE] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
 static const uint32_t SIMULATION_WIND_DIRECTION_TABLE[SEN15901_WIND_DIRECTION_NUMBER] = { 0, 22, 45, 67, 90, 112, 135, 157, 180, 202, 225, 247, 270, 292, 315, 337 };
 
+#ifdef SEN15901_EMULATOR_MODE_WEATHER
+static const WEATHER_configuration_t SIMULATION_WEATHER_CONFIGURATION = {
+    .seed = SEN15901_EMULATOR_WEATHER_SEED,
+    .wind_speed_scale_ckmh = SIMULATION_WEATHER_WIND_SPEED_SCALE_CKMH,
+    .gust_intensity_q8 = SIMULATION_WEATHER_GUST_INTENSITY_Q8,
+    .gust_filter_shift = SIMULATION_WEATHER_GUST_FILTER_SHIFT,
+    .wind_direction_prevailing_degrees = SIMULATION_WEATHER_WIND_DIRECTION_DEGREES,
+    .wind_direction_step_degrees = SIMULATION_WEATHER_WIND_DIRECTION_STEP,
+    .wind_direction_return_shift = SIMULATION_WEATHER_WIND_DIRECTION_SHIFT,
+    .rainfall_cluster_start_probability = SIMULATION_WEATHER_RAIN_START_PROBABILITY,
+    .rainfall_cluster_stop_probability = SIMULATION_WEATHER_RAIN_STOP_PROBABILITY,
+    .rainfall_pulse_probability = SIMULATION_WEATHER_RAIN_PULSE_PROBABILITY
+};
+#endif
+
+#ifdef SEN15901_EMULATOR_MODE_PROFILE
+// Profile played during each DUT period, selected by the campaign step (tick period is 3 or 6 seconds).
+static const PROFILE_configuration_t SIMULATION_PROFILE_SCHEDULE[SIMULATION_PROFILE_SCHEDULE_SIZE] = {
+    { .type = PROFILE_TYPE_STEP, .base_ckmh = 0, .amplitude_ckmh = 3000, .delay_ticks = 20, .period_ticks = 0, .duty_q8 = 0 },
+    { .type = PROFILE_TYPE_RAMP, .base_ckmh = 0, .amplitude_ckmh = 6000, .delay_ticks = 0, .period_ticks = 40, .duty_q8 = 0 },
+    { .type = PROFILE_TYPE_SINE, .base_ckmh = 1500, .amplitude_ckmh = 3000, .delay_ticks = 0, .period_ticks = 30, .duty_q8 = 0 },
+    { .type = PROFILE_TYPE_GUST_BURST, .base_ckmh = 1000, .amplitude_ckmh = 5000, .delay_ticks = 10, .period_ticks = 8, .duty_q8 = 0 },
+    { .type = PROFILE_TYPE_EXPONENTIAL_DECAY, .base_ckmh = 500, .amplitude_ckmh = 6000, .delay_ticks = 0, .period_ticks = 40, .duty_q8 = 0 },
+    { .type = PROFILE_TYPE_SQUARE_GUSTS, .base_ckmh = 1000, .amplitude_ckmh = 4000, .delay_ticks = 0, .period_ticks = 10, .duty_q8 = 64 }
+};
+#endif
+
 static SIMULATION_context_t simulation_ctx = {
     .flags.all = 0,
     .time_ms = 0,
+    .first_synchro = 0,
+    .synchro_irq_enable = 0,
+    .usb_detect_event = 0,
+    .tick_period_ms = 0,
+    .sen15901_commit = NULL,
+    .tick_count = 0,
+    .subtick_count = 0,
+    .subtick_period_us = 0,
+    .timer_us_per_count_q8 = 0,
+    .timer_tick_counts = 0,
+    .timer_subtick_counts = 0,
+    .period_subtick_number = 0,
+    .period_us = 0,
     .wind_speed_peak_kmh = 0,
     .wind_direction_table_index = (SEN15901_WIND_DIRECTION_NUMBER - 1),
     .rainfall_peak_irq_count = 0,
+    .campaign_step = 0,
     .wind_speed_kmh = 0,
-    .rainfall_irq_count = 0
+    .rainfall_irq_count = 0,
+    .synchro_filter_ms = SIMULATION_DUT_SYNCHRO_IRQ_FILTER_MS,
+    .fault_threshold_ms = SIMULATION_FAULT_TIME_THRESHOLD_MS,
+    .rainfall_timestamp_ms = SIMULATION_RAINFALL_TIMESTAMP_MS,
+    .synchro_previous_timestamp_ms = 0,
+    .synchro_pulse_timestamp_ms = 0,
+    .synchro_count = 0,
+    .synchro_missed_count = 0,
+    .synchro_early_count = 0,
+    .synchro_early_timestamp_ms = 0,
+    .synchro_early_event = 0,
+    .synchro_locked = 0,
+    .signature = SIMULATION_SIGNATURE_CRC32_INIT,
+    .signature_tick = 0,
+    .signature_last = 0,
+    .signature_period = 0
 };
 
 /*** SIMULATION local functions ***/
 
 /*******************************************************************/
-static void _SIMULATION_dut_synchro_callback(void) {
-    // Set flags.
-    simulation_ctx.flags.first_synchro = 1;
-    simulation_ctx.flags.synchro = simulation_ctx.flags.synchro_irq_enable;
+RAMFUNC static uint32_t _SIMULATION_get_subtick_offset_us(uint32_t subtick_count) {
+    // Time elapsed between the tick and the start of the sub-tick, derived from the timer counts.
+    return (((subtick_count * simulation_ctx.timer_subtick_counts) * simulation_ctx.timer_us_per_count_q8) >> 8);
+}
+
+/*******************************************************************/
+RAMFUNC static uint32_t _SIMULATION_set_timer_period(uint32_t subtick_number) {
+    // Local variables.
+    uint32_t counts = (subtick_number * simulation_ctx.timer_subtick_counts);
+    uint32_t period_us = 0;
+    // Called from the timer interrupt or with interrupts disabled: the current period starts at sub-tick (subtick_count).
+    if ((simulation_ctx.subtick_count + subtick_number) >= SIMULATION_SUBTICK_NUMBER) {
+        // Last period of the tick absorbs the counter rounding.
+        counts = (simulation_ctx.timer_tick_counts - (simulation_ctx.subtick_count * simulation_ctx.timer_subtick_counts));
+        period_us = ((simulation_ctx.tick_period_ms * SIMULATION_US_PER_MS) - _SIMULATION_get_subtick_offset_us(simulation_ctx.subtick_count));
+    }
+    else {
+        period_us = (_SIMULATION_get_subtick_offset_us(simulation_ctx.subtick_count + subtick_number) - _SIMULATION_get_subtick_offset_us(simulation_ctx.subtick_count));
+    }
+    TIM2->ARR = (counts - 1);
+    simulation_ctx.period_subtick_number = subtick_number;
+    simulation_ctx.period_us = period_us;
+    return period_us;
+}
+
+/*******************************************************************/
+RAMFUNC static uint32_t _SIMULATION_get_period_subtick_number(void) {
+#ifdef SEN15901_EMULATOR_CLUSTER_FOLLOWER
+    // Phase is slewed on each sub-tick.
+    return 1;
+#else
+    // Sub-tick interrupts are only required during a vane rotation.
+    return ((SEN15901_is_wind_direction_rotating() != 0) ? 1 : (SIMULATION_SUBTICK_NUMBER - simulation_ctx.subtick_count));
+#endif
+}
+
+/*******************************************************************/
+static void _SIMULATION_update_timer_period(void) {
+    // Local variables.
+    uint32_t subtick_number = 0;
+    uint32_t primask = 0;
+    // Check if a vane rotation has been started during a tick period.
+    if ((simulation_ctx.flags.running == 0) || (SEN15901_is_wind_direction_rotating() == 0)) goto errors;
+    IRQ_SAVE(primask);
+    // Pending update event: the next period is selected by the timer interrupt.
+    if (((TIM2->SR) & SIMULATION_TIM_SR_UIF) != 0) goto end;
+    // End the current period on the second next sub-tick boundary, so that the counter is always below the new reload value.
+    subtick_number = (((TIM2->CNT) / simulation_ctx.timer_subtick_counts) + 2);
+    if (subtick_number >= simulation_ctx.period_subtick_number) goto end;
+    TIMEBASE_set_period(_SIMULATION_set_timer_period(subtick_number));
+end:
+    IRQ_RESTORE(primask);
+errors:
+    return;
+}
+
+/*******************************************************************/
+RAMFUNC static uint32_t _SIMULATION_get_tick_offset_us(void) {
+    // Local variables.
+    uint32_t subtick_count = simulation_ctx.subtick_count;
+    uint32_t counter = (TIM2->CNT);
+    // Called with interrupts disabled: take a pending update event into account.
+    if (((TIM2->SR) & SIMULATION_TIM_SR_UIF) != 0) {
+        counter = (TIM2->CNT);
+        subtick_count += simulation_ctx.period_subtick_number;
+        if (subtick_count >= SIMULATION_SUBTICK_NUMBER) {
+            subtick_count = 0;
+        }
+    }
+    return (_SIMULATION_get_subtick_offset_us(subtick_count) + ((counter * simulation_ctx.timer_us_per_count_q8) >> 8));
+}
+
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+/*******************************************************************/
+RAMFUNC static uint32_t _SIMULATION_get_stress_pulse_count(void) {
+    // Local variables.
+    uint32_t pulse_count = 0;
+    uint32_t primask = 0;
+    // Pulses emitted until now, including the ones of the current tick.
+    IRQ_SAVE(primask);
+    pulse_count = SEN15901_get_wind_speed_pulse_count(_SIMULATION_get_tick_offset_us());
+    IRQ_RESTORE(primask);
+    return pulse_count;
+}
+#endif
+
+/*******************************************************************/
+static void _SIMULATION_update_signature(SIMULATION_signature_output_t output, uint32_t value) {
+    // Local variables.
+    uint32_t crc = simulation_ctx.signature;
+    uint32_t data = 0;
+#ifdef SEN15901_EMULATOR_COVERAGE
+    uint32_t value_emitted = value;
+#endif
+    uint8_t idx = 0;
+    // Output identifier and tick on which the value is committed (independent of the DUT period phase), then value (little endian).
+    data = ((simulation_ctx.signature_tick << 8) | (uint32_t) output);
+    for (idx = 0; idx < 8; idx++) {
+        crc = (crc >> 4) ^ SIMULATION_SIGNATURE_CRC32_TABLE[(crc ^ data) & 0x0F];
+        data >>= 4;
+    }
+    for (idx = 0; idx < 8; idx++) {
+        crc = (crc >> 4) ^ SIMULATION_SIGNATURE_CRC32_TABLE[(crc ^ value) & 0x0F];
+        value >>= 4;
+    }
+    simulation_ctx.signature = crc;
+#ifdef SEN15901_EMULATOR_COVERAGE
+    // Keep the staged values, they are counted once committed.
+    if (output == SIMULATION_SIGNATURE_OUTPUT_WIND_SPEED) {
+        simulation_ctx.coverage_wind_speed_ckmh = value_emitted;
+        simulation_ctx.coverage_staged |= (0b1 << output);
+    }
+    if (output == SIMULATION_SIGNATURE_OUTPUT_WIND_DIRECTION) {
+        simulation_ctx.coverage_wind_direction_degrees = value_emitted;
+        simulation_ctx.coverage_staged |= (0b1 << output);
+    }
+#endif
+}
+
+/*******************************************************************/
+static void _SIMULATION_write_output(const GPIO_pin_t* gpio, ENERGY_state_t energy_state, uint8_t state) {
+    // Update pin and power state.
+    GPIO_write(gpio, state);
+    ENERGY_set_state(energy_state, state);
+}
+
+/*******************************************************************/
+static void _SIMULATION_update_synchro_window(void) {
+    // Local variables.
+    SYNCHRO_estimation_t estimation;
+    uint32_t filter_min_ms = 0;
+    // Use the learned acceptance window once the estimation is locked.
+    SYNCHRO_get_estimation(&estimation);
+    if (estimation.locked != 0) {
+        // Window may start at 0 with a large jitter: keep the default debouncing, within the first half of short announced periods.
+        filter_min_ms = (estimation.period_ms >> 1);
+        if (filter_min_ms > SIMULATION_DUT_SYNCHRO_IRQ_FILTER_MS) {
+            filter_min_ms = SIMULATION_DUT_SYNCHRO_IRQ_FILTER_MS;
+        }
+        simulation_ctx.synchro_filter_ms = (estimation.window_min_ms < filter_min_ms) ? filter_min_ms : estimation.window_min_ms;
+        simulation_ctx.fault_threshold_ms = estimation.window_max_ms;
+    }
+    else {
+        simulation_ctx.synchro_filter_ms = SIMULATION_DUT_SYNCHRO_IRQ_FILTER_MS;
+        simulation_ctx.fault_threshold_ms = SIMULATION_FAULT_TIME_THRESHOLD_MS;
+    }
+    simulation_ctx.synchro_locked = estimation.locked;
+}
+
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+/*******************************************************************/
+static void _SIMULATION_set_period(uint32_t period_ms) {
+    // Announced period replaces the learned one.
+    SYNCHRO_reset_estimation(period_ms);
+    _SIMULATION_update_synchro_window();
+    // Rainfall default start time is kept as upper bound.
+    simulation_ctx.rainfall_timestamp_ms = ((period_ms >> 2) < SIMULATION_RAINFALL_TIMESTAMP_MS) ? (period_ms >> 2) : SIMULATION_RAINFALL_TIMESTAMP_MS;
+}
+#endif
+
+/*******************************************************************/
+static void _SIMULATION_set_campaign_step(uint32_t step) {
+    // Amplitudes reached after the given number of synchronization pulses.
+    simulation_ctx.campaign_step = step;
+    simulation_ctx.wind_speed_peak_kmh = (step % (SIMULATION_WIND_SPEED_KMH_MAX + 1));
+    simulation_ctx.wind_direction_table_index = ((step + SEN15901_WIND_DIRECTION_NUMBER - 1) % SEN15901_WIND_DIRECTION_NUMBER);
+    simulation_ctx.rainfall_peak_irq_count = (step % (SIMULATION_RAINFALL_IRQ_COUNT_MAX + 1));
+}
+
+#if !((defined SEN15901_EMULATOR_MODE_WEATHER) || (defined SEN15901_EMULATOR_MODE_STRESS) || (defined SEN15901_EMULATOR_MODE_PROFILE))
+/*******************************************************************/
+static void _SIMULATION_set_period_tick(uint32_t tick) {
+    // Local variables.
+    uint32_t ramp_phase = 0;
+    uint32_t rainfall_first_tick = 0;
+    // Ramp is a triangle of (2 * peak) stages, staged once per tick from the synchronization.
+    simulation_ctx.wind_speed_kmh = 0;
+    simulation_ctx.flags.wind_speed_down = 0;
+    if (simulation_ctx.wind_speed_peak_kmh > 0) {
+        ramp_phase = (tick % (simulation_ctx.wind_speed_peak_kmh << 1));
+        simulation_ctx.wind_speed_kmh = (ramp_phase <= simulation_ctx.wind_speed_peak_kmh) ? ramp_phase : ((simulation_ctx.wind_speed_peak_kmh << 1) - ramp_phase);
+        simulation_ctx.flags.wind_speed_down = ((ramp_phase == 0) || (ramp_phase > simulation_ctx.wind_speed_peak_kmh)) ? 1 : 0;
+    }
+#ifdef SEN15901_EMULATOR_CHECK_INVARIANTS
+    simulation_ctx.wind_speed_previous_kmh = simulation_ctx.wind_speed_kmh;
+#endif
+    // One rainfall pulse per tick from the rainfall timestamp, up to the peak.
+    rainfall_first_tick = ((simulation_ctx.rainfall_timestamp_ms + simulation_ctx.tick_period_ms - 1) / simulation_ctx.tick_period_ms);
+    if (rainfall_first_tick == 0) {
+        rainfall_first_tick = 1;
+    }
+    simulation_ctx.rainfall_irq_count = (tick >= rainfall_first_tick) ? (tick - rainfall_first_tick + 1) : 0;
+    if (simulation_ctx.rainfall_irq_count > simulation_ctx.rainfall_peak_irq_count) {
+        simulation_ctx.rainfall_irq_count = simulation_ctx.rainfall_peak_irq_count;
+    }
+}
+#endif
+
+/*******************************************************************/
+RAMFUNC static void _SIMULATION_dut_synchro_callback(void) {
+    // Local variables.
+    uint32_t timestamp_ms = TIMEBASE_get_timestamp_ms();
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+    SYNCHRO_frame_t frame;
+    uint32_t timestamp_us = TIMEBASE_get_timestamp_us();
+#endif
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+    CAPTURE_write(CAPTURE_SIGNAL_SYNCHRO, GPIO_read(&GPIO_DUT_SYNCHRO));
+#else
+    CAPTURE_write(CAPTURE_SIGNAL_SYNCHRO, 1);
+#endif
+#endif
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+    // Pulse width is measured on the falling edge.
+    if (GPIO_read(&GPIO_DUT_SYNCHRO) != 0) {
+        simulation_ctx.synchro_rising_timestamp_us = timestamp_us;
+        return;
+    }
+    SYNCHRO_decode((timestamp_us - simulation_ctx.synchro_rising_timestamp_us), &frame);
+    if (frame.command != SYNCHRO_COMMAND_LEGACY) {
+        // Trace event.
+        TRACE_write(TRACE_EVENT_SYNCHRO_COMMAND, (uint16_t) ((frame.command << 12) | (frame.argument & 0x0FFF)));
+        // Period announcement does not start a new period.
+        if (frame.command == SYNCHRO_COMMAND_PERIOD) {
+            _SIMULATION_set_period(frame.argument * SYNCHRO_PERIOD_UNIT_MS);
+            return;
+        }
+        // Prefix only extends the argument of the next command.
+        if (frame.command == SYNCHRO_COMMAND_PREFIX) {
+            return;
+        }
+        // Coverage dump request does not start a new period either.
+        if (frame.command == SYNCHRO_COMMAND_COVERAGE) {
+#ifdef SEN15901_EMULATOR_COVERAGE
+            simulation_ctx.coverage_request = 1;
+#endif
+            return;
+        }
+        // Personality switch requires to restart the waveform timer: it is applied by the main context.
+        if (frame.command == SYNCHRO_COMMAND_PERSONALITY) {
+            simulation_ctx.personality_request = (uint8_t) frame.argument;
+            return;
+        }
+        // Commands are not filtered.
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+        simulation_ctx.stress_pulse_origin = _SIMULATION_get_stress_pulse_count();
+#endif
+        EVENT_QUEUE_push(&(simulation_ctx.synchro_queue), timestamp_ms, ((((uint32_t) frame.command) << SIMULATION_SYNCHRO_EVENT_COMMAND_SHIFT) | (((uint32_t) frame.tick) << SIMULATION_SYNCHRO_EVENT_TICK_SHIFT) | frame.argument));
+        simulation_ctx.first_synchro = 1;
+        simulation_ctx.synchro_irq_enable = 0;
+        return;
+    }
+#endif
+    // Trace event.
+    if (simulation_ctx.synchro_irq_enable != 0) {
+        TRACE_write(TRACE_EVENT_SYNCHRO_ACCEPTED, 0);
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+        simulation_ctx.stress_pulse_origin = _SIMULATION_get_stress_pulse_count();
+#endif
+        EVENT_QUEUE_push(&(simulation_ctx.synchro_queue), timestamp_ms, 0);
+    }
+    else if (simulation_ctx.synchro_locked != 0) {
+        // Pulse received before the learned acceptance window: interval is learned by the main context.
+        TRACE_write(TRACE_EVENT_SYNCHRO_EARLY, (uint16_t) simulation_ctx.synchro_early_count);
+        simulation_ctx.synchro_early_count++;
+        simulation_ctx.synchro_early_timestamp_ms = timestamp_ms;
+        simulation_ctx.synchro_early_event = 1;
+    }
+    else {
+        TRACE_write(TRACE_EVENT_SYNCHRO_FILTERED, 0);
+    }
+    simulation_ctx.first_synchro = 1;
     // Disable interrupt for debouncing.
-    simulation_ctx.flags.synchro_irq_enable = 0;
+    simulation_ctx.synchro_irq_enable = 0;
+}
+
+/*******************************************************************/
+static void _SIMULATION_usb_detect_callback(void) {
+    // Attach state is read by the main context.
+    simulation_ctx.usb_detect_event = 1;
+}
+
+#ifdef SEN15901_EMULATOR_CLUSTER_FOLLOWER
+/*******************************************************************/
+static void _SIMULATION_set_tick_offset_us(uint32_t tick_offset_us) {
+    // Local variables.
+    uint32_t counts = 0;
+    uint32_t period_us = 0;
+    // Called with interrupts disabled: move the tick phase so that the given time has elapsed since the last tick.
+    tick_offset_us %= (simulation_ctx.tick_period_ms * SIMULATION_US_PER_MS);
+    counts = ((tick_offset_us << 8) / simulation_ctx.timer_us_per_count_q8);
+    simulation_ctx.subtick_count = (counts / simulation_ctx.timer_subtick_counts);
+    if (simulation_ctx.subtick_count >= SIMULATION_SUBTICK_NUMBER) {
+        simulation_ctx.subtick_count = (SIMULATION_SUBTICK_NUMBER - 1);
+    }
+    period_us = _SIMULATION_set_timer_period(1);
+    TIMEBASE_set_counter((counts - (simulation_ctx.subtick_count * simulation_ctx.timer_subtick_counts)), period_us);
+    simulation_ctx.cluster_phase_error_us = 0;
+}
+#endif
+
+/*******************************************************************/
+RAMFUNC static void _SIMULATION_timer_callback(void) {
+    // Local variables.
+    uint32_t elapsed_us = simulation_ctx.period_us;
+    uint32_t period_us = 0;
+#ifdef SEN15901_EMULATOR_CLUSTER_FOLLOWER
+    int32_t correction_us = 0;
+#endif
+    // A rotation started during a longer period has only been running for one sub-tick.
+    if (simulation_ctx.period_subtick_number > 1) {
+        elapsed_us = simulation_ctx.subtick_period_us;
+    }
+    // Select next period.
+    simulation_ctx.subtick_count += simulation_ctx.period_subtick_number;
+    if (simulation_ctx.subtick_count >= SIMULATION_SUBTICK_NUMBER) {
+        simulation_ctx.subtick_count = 0;
+    }
+    period_us = _SIMULATION_set_timer_period(_SIMULATION_get_period_subtick_number());
+#ifdef SEN15901_EMULATOR_CLUSTER_FOLLOWER
+    // Spread the phase correction over the next timer periods.
+    correction_us = CLUSTER_get_correction_us(&(simulation_ctx.cluster_phase_error_us), (simulation_ctx.subtick_period_us >> SIMULATION_CLUSTER_SLEW_SHIFT));
+    TIM2->ARR = (uint32_t) (((int32_t) (TIM2->ARR)) + ((correction_us * 256) / ((int32_t) simulation_ctx.timer_us_per_count_q8)));
+    period_us = (uint32_t) (((int32_t) period_us) + correction_us);
+#endif
+    // Update monotonic time.
+    TIMEBASE_period_elapsed(period_us);
+    // Check tick boundary.
+    if (simulation_ctx.subtick_count == 0) {
+        // Apply waveforms staged during previous period.
+        simulation_ctx.sen15901_commit();
+        simulation_ctx.time_ms += simulation_ctx.tick_period_ms;
+        simulation_ctx.tick_count++;
+        EVENT_QUEUE_push(&(simulation_ctx.timer_queue), TIMEBASE_get_timestamp_ms(), simulation_ctx.tick_count);
+        // Trace event.
+        TRACE_write(TRACE_EVENT_TICK, (uint16_t) simulation_ctx.tick_count);
+    }
+    // Vane rotation between ticks.
+    SEN15901_rotate_wind_direction(elapsed_us);
+}
+
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+/*******************************************************************/
+static void _SIMULATION_log_rx_callback(uint8_t data) {
+    // Decode verdict sent by the test bench after comparing the DUT counts.
+    if ((data == 'P') || (data == 'p')) {
+        STRESS_set_verdict(STRESS_VERDICT_PASS);
+    }
+    if ((data == 'F') || (data == 'f')) {
+        STRESS_set_verdict(STRESS_VERDICT_FAIL);
+    }
+}
+#endif
+
+#ifdef SEN15901_EMULATOR_CLUSTER_FOLLOWER
+/*******************************************************************/
+static void _SIMULATION_log_rx_callback(uint8_t data) {
+    // Local variables.
+    CLUSTER_marker_t marker;
+    uint32_t timestamp_ms = 0;
+    uint32_t tick_offset_us = 0;
+    uint32_t marker_age_us = 0;
+    uint32_t primask = 0;
+    int32_t phase_error_us = 0;
+    // Timer interrupt has a higher priority.
+    IRQ_SAVE(primask);
+    tick_offset_us = _SIMULATION_get_tick_offset_us();
+    timestamp_ms = TIMEBASE_get_timestamp_ms();
+    CLUSTER_decode(data, &marker);
+    if ((marker.type == CLUSTER_MARKER_TYPE_TICK) && (simulation_ctx.flags.running != 0)) {
+        // Compare the local tick phase with the leader one.
+        marker_age_us = (SIMULATION_CLUSTER_RX_LATENCY_US + marker.value);
+        phase_error_us = CLUSTER_get_phase_error_us(tick_offset_us, marker_age_us, (simulation_ctx.tick_period_ms * SIMULATION_US_PER_MS));
+        simulation_ctx.cluster_skew_us = phase_error_us;
+        if (phase_error_us < 0) {
+            phase_error_us = (-phase_error_us);
+        }
+        if ((simulation_ctx.cluster_locked == 0) || (((uint32_t) phase_error_us) > ((simulation_ctx.tick_period_ms * SIMULATION_US_PER_MS) >> SIMULATION_CLUSTER_PHASE_STEP_SHIFT))) {
+            _SIMULATION_set_tick_offset_us(marker_age_us);
+            simulation_ctx.cluster_locked = 1;
+        }
+        else {
+            simulation_ctx.cluster_phase_error_us = simulation_ctx.cluster_skew_us;
+        }
+    }
+    IRQ_RESTORE(primask);
+    if (marker.type == CLUSTER_MARKER_TYPE_STEP) {
+        // Leader step marker replaces the DUT synchronization pulse.
+        TRACE_write(TRACE_EVENT_SYNCHRO_ACCEPTED, 0);
+        EVENT_QUEUE_push(&(simulation_ctx.synchro_queue), timestamp_ms, marker.value);
+        simulation_ctx.first_synchro = 1;
+    }
+}
+#endif
+
+#ifdef SEN15901_EMULATOR_CLUSTER_LEADER
+/*******************************************************************/
+static void _SIMULATION_send_tick_marker(void) {
+    // Local variables.
+    CLUSTER_status_t cluster_status = CLUSTER_SUCCESS;
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    uint32_t delay_us = 0;
+    uint32_t primask = 0;
+    uint32_t loop_count = 0;
+    uint8_t marker = 0;
+    // Wait for the end of the previous transmission so that the marker starts immediately.
+    while (((USART2->ISR) & SIMULATION_USART_ISR_TC) == 0) {
+        loop_count++;
+        if (loop_count > SIMULATION_USART_TC_TIMEOUT_COUNT) goto errors;
+    }
+    IRQ_SAVE(primask);
+    delay_us = _SIMULATION_get_tick_offset_us();
+    IRQ_RESTORE(primask);
+    // Late markers are dropped: followers keep their phase until the next tick.
+    cluster_status = CLUSTER_encode_tick_marker(delay_us, &marker);
+    if (cluster_status != CLUSTER_SUCCESS) goto errors;
+    terminal_status = TERMINAL_HW_write(0, &marker, 1);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+errors:
+    return;
 }
+#endif
 
+#ifdef SEN15901_EMULATOR_CLUSTER_LEADER
 /*******************************************************************/
-static void _SIMULATION_timer_callback(void) {
-    // Set flags.
-    simulation_ctx.flags.timer = 1;
-    simulation_ctx.time_ms += SIMULATION_WAVEFORM_TIMER_PERIOD_MS;
+static void _SIMULATION_send_step_marker(void) {
+    // Local variables.
+    CLUSTER_status_t cluster_status = CLUSTER_SUCCESS;
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    uint8_t marker[CLUSTER_STEP_MARKER_SIZE_BYTES];
+    // Broadcast the step started by this period.
+    cluster_status = CLUSTER_encode_step_marker((simulation_ctx.campaign_step & CLUSTER_STEP_MAX), marker);
+    CLUSTER_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_CLUSTER);
+    if (cluster_status != CLUSTER_SUCCESS) goto errors;
+    terminal_status = TERMINAL_HW_write(0, marker, CLUSTER_STEP_MARKER_SIZE_BYTES);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+errors:
+    return;
 }
+#endif
+
+/*******************************************************************/
+static SIMULATION_status_t _SIMULATION_stage_waveforms(void) {
+    // Local variables.
+    SIMULATION_status_t status = SIMULATION_SUCCESS;
+    SEN15901_status_t sen15901_status = SEN15901_SUCCESS;
+#ifdef SEN15901_EMULATOR_MODE_WEATHER
+    WEATHER_status_t weather_status = WEATHER_SUCCESS;
+#endif
+#ifdef SEN15901_EMULATOR_MODE_PROFILE
+    PROFILE_status_t profile_status = PROFILE_SUCCESS;
+#endif
+#ifdef SEN15901_EMULATOR_MODE_WEATHER
+    // Compute next tick values.
+    weather_status = WEATHER_process(&(simulation_ctx.weather_output));
+    WEATHER_exit_error(SIMULATION_ERROR_BASE_WEATHER);
+    sen15901_status = SEN15901_set_wind_speed(simulation_ctx.weather_output.wind_speed_ckmh);
+    SEN15901_exit_error(SIMULATION_ERROR_BASE_SEN15901);
+    sen15901_status = SEN15901_set_wind_direction_target(simulation_ctx.weather_output.wind_direction_degrees, SEN15901_EMULATOR_VANE_VELOCITY_DPS);
+    SEN15901_exit_error(SIMULATION_ERROR_BASE_SEN15901);
+    _SIMULATION_update_signature(SIMULATION_SIGNATURE_OUTPUT_WIND_SPEED, simulation_ctx.weather_output.wind_speed_ckmh);
+    _SIMULATION_update_signature(SIMULATION_SIGNATURE_OUTPUT_WIND_DIRECTION, simulation_ctx.weather_output.wind_direction_degrees);
+#elif (defined SEN15901_EMULATOR_MODE_PROFILE)
+    // Wind speed.
+    profile_status = PROFILE_process(&(simulation_ctx.profile_wind_speed_ckmh));
+    PROFILE_exit_error(SIMULATION_ERROR_BASE_PROFILE);
+    sen15901_status = SEN15901_set_wind_speed(simulation_ctx.profile_wind_speed_ckmh);
+    SEN15901_exit_error(SIMULATION_ERROR_BASE_SEN15901);
+    // Wind direction.
+    sen15901_status = SEN15901_set_wind_direction_target(SIMULATION_WIND_DIRECTION_TABLE[simulation_ctx.wind_direction_table_index], SEN15901_EMULATOR_VANE_VELOCITY_DPS);
+    SEN15901_exit_error(SIMULATION_ERROR_BASE_SEN15901);
+    _SIMULATION_update_signature(SIMULATION_SIGNATURE_OUTPUT_WIND_SPEED, simulation_ctx.profile_wind_speed_ckmh);
+    _SIMULATION_update_signature(SIMULATION_SIGNATURE_OUTPUT_WIND_DIRECTION, SIMULATION_WIND_DIRECTION_TABLE[simulation_ctx.wind_direction_table_index]);
+#elif (defined SEN15901_EMULATOR_MODE_STRESS)
+    // Wind speed is driven by the capacity search.
+    sen15901_status = SEN15901_set_wind_direction_target(SIMULATION_WIND_DIRECTION_TABLE[simulation_ctx.wind_direction_table_index], SEN15901_EMULATOR_VANE_VELOCITY_DPS);
+    SEN15901_exit_error(SIMULATION_ERROR_BASE_SEN15901);
+    _SIMULATION_update_signature(SIMULATION_SIGNATURE_OUTPUT_WIND_DIRECTION, SIMULATION_WIND_DIRECTION_TABLE[simulation_ctx.wind_direction_table_index]);
+#else
+    // Wind speed.
+    if (simulation_ctx.wind_speed_peak_kmh > 0) {
+        if (simulation_ctx.wind_speed_kmh >= simulation_ctx.wind_speed_peak_kmh) {
+            // Clamp speed and start ramp down.
+            simulation_ctx.wind_speed_kmh = (simulation_ctx.wind_speed_peak_kmh - 1);
+            simulation_ctx.flags.wind_speed_down = 1;
+        }
+        else {
+            if (simulation_ctx.wind_speed_kmh == 0) {
+                // Clamp speed and start ramp up.
+                simulation_ctx.wind_speed_kmh = 1;
+                simulation_ctx.flags.wind_speed_down = 0;
+            }
+            else {
+                if (simulation_ctx.flags.wind_speed_down == 0) {
+                    simulation_ctx.wind_speed_kmh++;
+                }
+                else {
+                    simulation_ctx.wind_speed_kmh--;
+                }
+            }
+        }
+    }
+    else {
+        simulation_ctx.wind_speed_kmh = 0;
+    }
+    sen15901_status = SEN15901_set_wind_speed(simulation_ctx.wind_speed_kmh * SEN15901_WIND_SPEED_CKMH_PER_KMH);
+    SEN15901_exit_error(SIMULATION_ERROR_BASE_SEN15901);
+    // Wind direction.
+    sen15901_status = SEN15901_set_wind_direction_target(SIMULATION_WIND_DIRECTION_TABLE[simulation_ctx.wind_direction_table_index], SEN15901_EMULATOR_VANE_VELOCITY_DPS);
+    SEN15901_exit_error(SIMULATION_ERROR_BASE_SEN15901);
+    _SIMULATION_update_signature(SIMULATION_SIGNATURE_OUTPUT_WIND_SPEED, (simulation_ctx.wind_speed_kmh * SEN15901_WIND_SPEED_CKMH_PER_KMH));
+    _SIMULATION_update_signature(SIMULATION_SIGNATURE_OUTPUT_WIND_DIRECTION, SIMULATION_WIND_DIRECTION_TABLE[simulation_ctx.wind_direction_table_index]);
+#endif
+errors:
+    return status;
+}
+
+#ifdef SEN15901_EMULATOR_CHECK_INVARIANTS
+/*******************************************************************/
+static void _SIMULATION_check_invariants(void) {
+    // Acceptance window must open before the fault threshold.
+    if (simulation_ctx.synchro_filter_ms > simulation_ctx.fault_threshold_ms) {
+        ERROR_stack_add(ERROR_BASE_SIMULATION + SIMULATION_ERROR_INVARIANT_SYNCHRO_WINDOW);
+    }
+#if !((defined SEN15901_EMULATOR_MODE_WEATHER) || (defined SEN15901_EMULATOR_MODE_STRESS) || (defined SEN15901_EMULATOR_MODE_PROFILE))
+    // Wind speed ramp never exceeds its peak.
+    if (simulation_ctx.wind_speed_kmh > simulation_ctx.wind_speed_peak_kmh) {
+        ERROR_stack_add(ERROR_BASE_SIMULATION + SIMULATION_ERROR_INVARIANT_WIND_SPEED_PEAK);
+    }
+    // Ramp moves by at most 1km/h per tick.
+    if ((simulation_ctx.wind_speed_kmh > (simulation_ctx.wind_speed_previous_kmh + 1)) || ((simulation_ctx.wind_speed_kmh + 1) < simulation_ctx.wind_speed_previous_kmh)) {
+        ERROR_stack_add(ERROR_BASE_SIMULATION + SIMULATION_ERROR_INVARIANT_WIND_SPEED_RAMP);
+    }
+    simulation_ctx.wind_speed_previous_kmh = simulation_ctx.wind_speed_kmh;
+#endif
+#if !((defined SEN15901_EMULATOR_MODE_WEATHER) || (defined SEN15901_EMULATOR_MODE_STRESS))
+    // Rain count never exceeds its peak.
+    if (simulation_ctx.rainfall_irq_count > simulation_ctx.rainfall_peak_irq_count) {
+        ERROR_stack_add(ERROR_BASE_SIMULATION + SIMULATION_ERROR_INVARIANT_RAINFALL_PEAK);
+    }
+#endif
+}
+#endif
 
 /*******************************************************************/
 static void _SIMULATION_print_sw_version(void) {
@@ -172,6 +949,167 @@ static void _SIMULATION_print_value(char_t* name, int32_t value, char_t* unit) {
     return;
 }
 
+/*******************************************************************/
+static void _SIMULATION_print_synchro_report(void) {
+    // Local variables.
+    SYNCHRO_estimation_t estimation;
+    // Print learned DUT period.
+    SYNCHRO_get_estimation(&estimation);
+    _SIMULATION_print_value("DUT_period=", (int32_t) estimation.period_ms, "ms");
+    _SIMULATION_print_value("DUT_jitter=", (int32_t) estimation.jitter_ms, "ms");
+    _SIMULATION_print_value("DUT_window_min=", (int32_t) estimation.window_min_ms, "ms");
+    _SIMULATION_print_value("DUT_window_max=", (int32_t) estimation.window_max_ms, "ms");
+    _SIMULATION_print_value("DUT_synchro_missed=", (int32_t) simulation_ctx.synchro_missed_count, NULL);
+    _SIMULATION_print_value("DUT_synchro_early=", (int32_t) simulation_ctx.synchro_early_count, NULL);
+    // Events dropped before being processed.
+    _SIMULATION_print_value("Synchro_events_lost=", (int32_t) EVENT_QUEUE_get_overflow_count(&(simulation_ctx.synchro_queue)), NULL);
+    _SIMULATION_print_value("Tick_events_lost=", (int32_t) EVENT_QUEUE_get_overflow_count(&(simulation_ctx.timer_queue)), NULL);
+}
+
+/*******************************************************************/
+static void _SIMULATION_print_signature(void) {
+    // Local variables.
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    // Signature of the last completed period.
+    terminal_status = TERMINAL_flush_tx_buffer(0);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(0, "Signature=");
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_integer(0, (int32_t) simulation_ctx.signature_period, STRING_FORMAT_DECIMAL, 0);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(0, ";");
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_integer(0, (int32_t) simulation_ctx.signature_last, STRING_FORMAT_HEXADECIMAL, 1);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_tx_buffer_add_string(0, SIMULATION_LOG_LINE_END);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    terminal_status = TERMINAL_send_tx_buffer(0);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+}
+
+/*******************************************************************/
+static void _SIMULATION_print_energy_report(void) {
+    // Local variables.
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    uint8_t idx = 0;
+    // Period summary.
+    _SIMULATION_print_value("Energy_period=", (int32_t) simulation_ctx.energy_report.period_ms, "ms");
+    _SIMULATION_print_value("Energy_total=", (int32_t) simulation_ctx.energy_report.energy_total_uj, "uJ");
+    _SIMULATION_print_value("Charge_total=", (int32_t) simulation_ctx.energy_report.charge_total_uas, "uAs");
+    // Breakdown.
+    for (idx = 0; idx < ENERGY_STATE_LAST; idx++) {
+        terminal_status = TERMINAL_flush_tx_buffer(0);
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(0, "Energy_");
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(0, ENERGY_get_state_name(idx));
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(0, "=");
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_integer(0, (int32_t) simulation_ctx.energy_report.residency_ms[idx], STRING_FORMAT_DECIMAL, 0);
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(0, "ms;");
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_integer(0, (int32_t) simulation_ctx.energy_report.charge_uas[idx], STRING_FORMAT_DECIMAL, 0);
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_tx_buffer_add_string(0, "uAs" SIMULATION_LOG_LINE_END);
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+        terminal_status = TERMINAL_send_tx_buffer(0);
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    }
+}
+
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+/*******************************************************************/
+static void _SIMULATION_print_stress_report(void) {
+    // Local variables.
+    STRESS_status_t stress_status = STRESS_SUCCESS;
+    STRESS_report_t report;
+    STRESS_channel_t channel = STRESS_get_channel();
+    uint32_t pulse_count = 0;
+    uint32_t half_period_us = 0;
+    uint8_t idx = 0;
+    // Channel under test.
+    if (channel < STRESS_CHANNEL_LAST) {
+        stress_status = STRESS_get_report(channel, &report);
+        STRESS_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_STRESS);
+        _SIMULATION_print_value("Stress_channel=", (int32_t) channel, NULL);
+        _SIMULATION_print_value("Stress_step=", (int32_t) report.step_count, NULL);
+        _SIMULATION_print_value("Stress_frequency=", (int32_t) report.frequency_mhz, "mHz");
+        // Pulses generated since the last synchronization, to be compared with the DUT count.
+        if (channel == STRESS_CHANNEL_WIND_SPEED) {
+            // Counted from the timer periods committed on each tick (quantization, dithering and commit delay).
+            pulse_count = (_SIMULATION_get_stress_pulse_count() - simulation_ctx.stress_pulse_origin);
+        }
+        else {
+            // Rainfall train runs freely with the half period rounded down to the microsecond.
+            half_period_us = (report.frequency_mhz != 0) ? ((MATH_POWER_10[9] >> 1) / report.frequency_mhz) : 0;
+            pulse_count = (half_period_us != 0) ? (uint32_t) ((((uint64_t) simulation_ctx.time_ms) * MATH_POWER_10[3]) / (half_period_us << 1)) : 0;
+        }
+        _SIMULATION_print_value("Stress_pulses=", (int32_t) pulse_count, NULL);
+    }
+    // Capacity of completed channels.
+    for (idx = 0; idx < STRESS_CHANNEL_LAST; idx++) {
+        stress_status = STRESS_get_report(idx, &report);
+        STRESS_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_STRESS);
+        if (report.done == 0) continue;
+        _SIMULATION_print_value(((idx == STRESS_CHANNEL_WIND_SPEED) ? "Stress_capacity_wind_speed=" : "Stress_capacity_rainfall="), (int32_t) report.pass_frequency_mhz, "mHz");
+    }
+}
+#endif
+
+/*******************************************************************/
+static void _SIMULATION_update_log_interface(void) {
+    // Local variables.
+#ifndef SIMULATION_TERMINAL_PERSISTENT
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+#endif
+    uint8_t log_attached = GPIO_read(&GPIO_USB_DETECT);
+    // Ignore bounces.
+    if (log_attached == simulation_ctx.flags.log_attached) goto errors;
+#ifndef SIMULATION_TERMINAL_PERSISTENT
+    // Terminal is opened once per attach.
+    if (log_attached != 0) {
+        terminal_status = TERMINAL_open(0, SIMULATION_LOG_BAUD_RATE, NULL);
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    }
+    else {
+        terminal_status = TERMINAL_close(0);
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    }
+    ENERGY_set_state(ENERGY_STATE_TERMINAL, log_attached);
+#endif
+    simulation_ctx.flags.log_attached = log_attached;
+    // Show the previous ticks to the new host, the replay is cancelled on detach.
+    HISTORY_start_replay(((log_attached != 0) ? SIMULATION_HISTORY_REPLAY_RECORDS : 0), SIMULATION_HISTORY_REPLAY_BUDGET_MS);
+errors:
+    return;
+}
+
+/*******************************************************************/
+static void _SIMULATION_write_history(uint8_t synchro_event) {
+    // Local variables.
+    HISTORY_status_t history_status = HISTORY_SUCCESS;
+    HISTORY_record_t record;
+    // Same values as the tick logs.
+    record.timestamp_ms = TIMEBASE_get_timestamp_ms();
+#ifdef SEN15901_EMULATOR_MODE_WEATHER
+    record.wind_speed_ckmh = simulation_ctx.weather_output.wind_speed_ckmh;
+    record.wind_direction_degrees = (uint16_t) simulation_ctx.weather_output.wind_direction_degrees;
+#else
+#ifdef SEN15901_EMULATOR_MODE_PROFILE
+    record.wind_speed_ckmh = simulation_ctx.profile_wind_speed_ckmh;
+#else
+    record.wind_speed_ckmh = (simulation_ctx.wind_speed_kmh * SEN15901_WIND_SPEED_CKMH_PER_KMH);
+#endif
+    record.wind_direction_degrees = (uint16_t) SIMULATION_WIND_DIRECTION_TABLE[simulation_ctx.wind_direction_table_index];
+#endif
+    record.rainfall_irq_count = (simulation_ctx.rainfall_irq_count > 0xFF) ? 0xFF : ((uint8_t) simulation_ctx.rainfall_irq_count);
+    record.synchro = synchro_event;
+    history_status = HISTORY_write(&record);
+    HISTORY_stack_error(ERROR_BASE_HISTORY);
+}
+
 /*** SIMULATION functions ***/
 
 /*******************************************************************/
@@ -180,14 +1118,100 @@ SIMULATION_status_t SIMULATION_init(void) {
     SIMULATION_status_t status = SIMULATION_SUCCESS;
     SEN15901_status_t sen15901_status = SEN15901_SUCCESS;
     TIM_status_t tim_status = TIM_SUCCESS;
+    TRACE_status_t trace_status = TRACE_SUCCESS;
+    HISTORY_status_t history_status = HISTORY_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    EVENT_QUEUE_status_t event_queue_status = EVENT_QUEUE_SUCCESS;
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+    CAPTURE_status_t capture_status = CAPTURE_SUCCESS;
+#endif
+#ifdef SEN15901_EMULATOR_COVERAGE_CHECKPOINT
+    COVERAGE_status_t coverage_status = COVERAGE_SUCCESS;
+#endif
+    uint8_t personality = SEN15901_PERSONALITY_DEFAULT;
+    uint8_t personality_header = 0;
+#ifdef SEN15901_EMULATOR_MODE_WEATHER
+    WEATHER_status_t weather_status = WEATHER_SUCCESS;
+#endif
     // Reset context.
     simulation_ctx.flags.all = 0;
     simulation_ctx.time_ms = 0;
+    simulation_ctx.first_synchro = 0;
+    simulation_ctx.synchro_irq_enable = 0;
+    simulation_ctx.usb_detect_event = 0;
+    simulation_ctx.tick_count = 0;
+    simulation_ctx.subtick_count = 0;
+    simulation_ctx.subtick_period_us = 0;
+    simulation_ctx.timer_us_per_count_q8 = 0;
+    simulation_ctx.timer_tick_counts = 0;
+    simulation_ctx.timer_subtick_counts = 0;
+    simulation_ctx.period_subtick_number = 0;
+    simulation_ctx.period_us = 0;
     simulation_ctx.wind_speed_peak_kmh = 0;
     simulation_ctx.wind_direction_table_index = (SEN15901_WIND_DIRECTION_NUMBER - 1);
     simulation_ctx.rainfall_peak_irq_count = 0;
+    simulation_ctx.campaign_step = 0;
     simulation_ctx.wind_speed_kmh = 0;
     simulation_ctx.rainfall_irq_count = 0;
+#ifdef SEN15901_EMULATOR_CHECK_INVARIANTS
+    simulation_ctx.wind_speed_previous_kmh = 0;
+#endif
+#ifdef SEN15901_EMULATOR_MODE_PROFILE
+    simulation_ctx.profile_wind_speed_ckmh = 0;
+#endif
+    simulation_ctx.synchro_filter_ms = SIMULATION_DUT_SYNCHRO_IRQ_FILTER_MS;
+    simulation_ctx.fault_threshold_ms = SIMULATION_FAULT_TIME_THRESHOLD_MS;
+    simulation_ctx.rainfall_timestamp_ms = SIMULATION_RAINFALL_TIMESTAMP_MS;
+    simulation_ctx.synchro_previous_timestamp_ms = 0;
+    simulation_ctx.synchro_pulse_timestamp_ms = 0;
+    simulation_ctx.synchro_count = 0;
+    simulation_ctx.synchro_missed_count = 0;
+    simulation_ctx.synchro_early_count = 0;
+    simulation_ctx.synchro_early_timestamp_ms = 0;
+    simulation_ctx.synchro_early_event = 0;
+    simulation_ctx.synchro_locked = 0;
+    simulation_ctx.signature = SIMULATION_SIGNATURE_CRC32_INIT;
+    simulation_ctx.signature_tick = 0;
+    simulation_ctx.signature_last = 0;
+    simulation_ctx.signature_period = 0;
+    SYNCHRO_reset_estimation(0);
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+    simulation_ctx.synchro_rising_timestamp_us = 0;
+#endif
+#ifdef SEN15901_EMULATOR_CLUSTER_FOLLOWER
+    simulation_ctx.cluster_phase_error_us = 0;
+    simulation_ctx.cluster_skew_us = 0;
+    simulation_ctx.cluster_locked = 0;
+#endif
+#ifdef SEN15901_EMULATOR_COVERAGE
+    simulation_ctx.coverage_request = 0;
+    simulation_ctx.coverage_wind_speed_ckmh = 0;
+    simulation_ctx.coverage_wind_direction_degrees = 0;
+    simulation_ctx.coverage_staged = 0;
+#endif
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+    simulation_ctx.personality_request = SEN15901_PERSONALITY_LAST;
+#endif
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+    simulation_ctx.stress_pulse_origin = 0;
+#endif
+    event_queue_status = EVENT_QUEUE_init(&(simulation_ctx.timer_queue));
+    EVENT_QUEUE_stack_error(ERROR_BASE_EVENT_QUEUE);
+    event_queue_status = EVENT_QUEUE_init(&(simulation_ctx.synchro_queue));
+    EVENT_QUEUE_stack_error(ERROR_BASE_EVENT_QUEUE);
+    // Init monotonic time.
+    TIMEBASE_init();
+    // Init trace ring.
+    trace_status = TRACE_init(&TIMEBASE_get_timestamp_ms);
+    TRACE_stack_error(ERROR_BASE_TRACE);
+    // Init ticks history ring.
+    history_status = HISTORY_init(&TIMEBASE_get_timestamp_ms);
+    HISTORY_stack_error(ERROR_BASE_HISTORY);
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+    // Init waveform capture ring.
+    capture_status = CAPTURE_init(&TIMEBASE_get_timestamp_us);
+    CAPTURE_stack_error(ERROR_BASE_CAPTURE);
+#endif
     // Init battery charger control pin.
     GPIO_configure(&GPIO_BATTERY_CHARGER_DISABLE, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
     // Init status LEDs.
@@ -195,15 +1219,51 @@ SIMULATION_status_t SIMULATION_init(void) {
     GPIO_configure(&GPIO_LED_SYNCHRO, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
     GPIO_configure(&GPIO_LED_FAULT, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
     // Init synchronization signal.
-    EXTI_configure_gpio(&GPIO_DUT_SYNCHRO, GPIO_PULL_NONE, EXTI_TRIGGER_RISING_EDGE, &_SIMULATION_dut_synchro_callback, NVIC_PRIORITY_DUT_SYNCHRONIZATION);
+    EXTI_configure_gpio(&GPIO_DUT_SYNCHRO, GPIO_PULL_NONE, SIMULATION_DUT_SYNCHRO_TRIGGER, &_SIMULATION_dut_synchro_callback, NVIC_PRIORITY_DUT_SYNCHRONIZATION);
     // Init waveform timer.
     tim_status = TIM_STD_init(TIM_INSTANCE_SIMULATION, NVIC_PRIORITY_SIMULATION_WAVEFORM_TIMER);
     TIM_exit_error(SIMULATION_ERROR_BASE_WAVEFORM_TIMER);
+    // Read boot personality (erased or corrupted memory gives the default one).
+    nvm_status = NVM_read_byte(NVM_ADDRESS_SEN15901_PERSONALITY_HEADER, &personality_header);
+    NVM_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_NVM);
+    if ((nvm_status == NVM_SUCCESS) && (personality_header == SIMULATION_PERSONALITY_HEADER)) {
+        nvm_status = NVM_read_byte(NVM_ADDRESS_SEN15901_PERSONALITY, &personality);
+        NVM_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_NVM);
+    }
+    if ((nvm_status != NVM_SUCCESS) || (personality_header != SIMULATION_PERSONALITY_HEADER) || (personality >= SEN15901_PERSONALITY_LAST)) {
+        personality = SEN15901_PERSONALITY_DEFAULT;
+    }
     // Init SEN15901 emulator.
-    sen15901_status = SEN15901_init();
+    sen15901_status = SEN15901_init((SEN15901_personality_t) personality);
     SEN15901_exit_error(SIMULATION_ERROR_BASE_SEN15901);
-    // Init USB detect pin.
-    GPIO_configure(&GPIO_USB_DETECT, GPIO_MODE_INPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
+#ifdef SEN15901_EMULATOR_CHECK_INVARIANTS
+    sen15901_status = SEN15901_check_wind_direction();
+    SEN15901_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_SEN15901);
+#endif
+    simulation_ctx.tick_period_ms = SEN15901_get_tick_period_ms();
+    simulation_ctx.sen15901_commit = SEN15901_get_commit_callback();
+#ifdef SEN15901_EMULATOR_MODE_WEATHER
+    // Init weather model.
+    weather_status = WEATHER_init(&SIMULATION_WEATHER_CONFIGURATION);
+    WEATHER_exit_error(SIMULATION_ERROR_BASE_WEATHER);
+#endif
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+    // Init capacity search.
+    STRESS_init();
+#endif
+#ifdef SEN15901_EMULATOR_MODE_PROFILE
+    // No profile before the first DUT synchronization.
+    PROFILE_init();
+#endif
+#ifdef SEN15901_EMULATOR_COVERAGE_CHECKPOINT
+    // Resume histograms of the previous runs (erased or corrupted memory gives empty histograms).
+    coverage_status = COVERAGE_restore(NVM_ADDRESS_COVERAGE);
+    COVERAGE_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_COVERAGE);
+#elif (defined SEN15901_EMULATOR_COVERAGE)
+    COVERAGE_init();
+#endif
+    // Init USB detect pin (both edges to manage attach and detach).
+    EXTI_configure_gpio(&GPIO_USB_DETECT, GPIO_PULL_NONE, EXTI_TRIGGER_ANY_EDGE, &_SIMULATION_usb_detect_callback, NVIC_PRIORITY_USB_DETECT);
 errors:
     return status;
 }
@@ -219,7 +1279,7 @@ SIMULATION_status_t SIMULATION_de_init(void) {
     sen15901_status = SEN15901_de_init();
     SEN15901_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_SEN15901);
     // Release USB detect pin.
-    GPIO_configure(&GPIO_USB_DETECT, GPIO_MODE_ANALOG, GPIO_TYPE_OPEN_DRAIN, GPIO_SPEED_LOW, GPIO_PULL_NONE);
+    EXTI_release_gpio(&GPIO_USB_DETECT, GPIO_MODE_ANALOG);
     return status;
 }
 
@@ -228,14 +1288,57 @@ SIMULATION_status_t SIMULATION_start(void) {
     // Local variables.
     SIMULATION_status_t status = SIMULATION_SUCCESS;
     TIM_status_t tim_status = TIM_SUCCESS;
+    TIMEBASE_status_t timebase_status = TIMEBASE_SUCCESS;
+    ENERGY_status_t energy_status = ENERGY_SUCCESS;
+#ifdef SIMULATION_TERMINAL_PERSISTENT
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+#ifdef SEN15901_EMULATOR_CLUSTER_FOLLOWER
+    CLUSTER_init();
+#endif
+    // Keep terminal opened to receive the test bench verdicts or exchange the cluster markers.
+    terminal_status = TERMINAL_open(0, SIMULATION_LOG_BAUD_RATE, SIMULATION_LOG_RX_CALLBACK);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    ENERGY_set_state(ENERGY_STATE_TERMINAL, 1);
+#endif
+    // Enable USB detect interrupt and read the current attach state on next process.
+    simulation_ctx.usb_detect_event = 1;
+    EXTI_enable_gpio_interrupt(&GPIO_USB_DETECT);
     // Enable synchronization interrupt.
-    simulation_ctx.flags.synchro_irq_enable = 1;
+    simulation_ctx.synchro_irq_enable = 1;
+#ifndef SEN15901_EMULATOR_CLUSTER_FOLLOWER
+    // Follower periods are started by the leader markers.
     EXTI_enable_gpio_interrupt(&GPIO_DUT_SYNCHRO);
+#endif
     // Reset time.
     simulation_ctx.time_ms = 0;
-    // Start timer.
-    tim_status = TIM_STD_start(TIM_INSTANCE_SIMULATION, SIMULATION_WAVEFORM_TIMER_PERIOD_MS, TIM_UNIT_MS, &_SIMULATION_timer_callback);
+    simulation_ctx.subtick_count = 0;
+    simulation_ctx.subtick_period_us = ((simulation_ctx.tick_period_ms * SIMULATION_US_PER_MS) / (SIMULATION_SUBTICK_NUMBER));
+    // Start timer on the tick period, sub-ticks are derived from its counter.
+    tim_status = TIM_STD_start(TIM_INSTANCE_SIMULATION, simulation_ctx.tick_period_ms, TIM_UNIT_MS, &_SIMULATION_timer_callback);
     TIM_exit_error(SIMULATION_ERROR_BASE_WAVEFORM_TIMER);
+    // Compute timestamp resolution from the actual timer configuration.
+    simulation_ctx.timer_tick_counts = ((TIM2->ARR) + 1);
+    simulation_ctx.timer_subtick_counts = (simulation_ctx.timer_tick_counts / SIMULATION_SUBTICK_NUMBER);
+    simulation_ctx.timer_us_per_count_q8 = (((simulation_ctx.tick_period_ms * SIMULATION_US_PER_MS) << 8) / simulation_ctx.timer_tick_counts);
+    simulation_ctx.period_subtick_number = SIMULATION_SUBTICK_NUMBER;
+    simulation_ctx.period_us = (simulation_ctx.tick_period_ms * SIMULATION_US_PER_MS);
+    if (simulation_ctx.timer_subtick_counts == 0) {
+        status = SIMULATION_ERROR_TIMER_RESOLUTION;
+        goto errors;
+    }
+    timebase_status = TIMEBASE_start(simulation_ctx.period_us);
+    TIMEBASE_stack_error(ERROR_BASE_TIMEBASE);
+#ifdef SEN15901_EMULATOR_CLUSTER_FOLLOWER
+    // Tick phase is locked on the first leader marker.
+    simulation_ctx.cluster_phase_error_us = 0;
+    simulation_ctx.cluster_locked = 0;
+#endif
+    simulation_ctx.flags.running = 1;
+    // Start residency accounting.
+    energy_status = ENERGY_init(&TIMEBASE_get_timestamp_us);
+    ENERGY_exit_error(SIMULATION_ERROR_BASE_ENERGY);
+    // Rotation may have been staged before start.
+    _SIMULATION_update_timer_period();
 errors:
     return status;
 }
@@ -245,115 +1348,427 @@ SIMULATION_status_t SIMULATION_stop(void) {
     // Local variables.
     SIMULATION_status_t status = SIMULATION_SUCCESS;
     TIM_status_t tim_status = TIM_SUCCESS;
-    // Enable synchronization interrupt.
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+#ifdef SIMULATION_TERMINAL_PERSISTENT
+    // Close persistent terminal.
+    terminal_status = TERMINAL_close(0);
+    TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+    ENERGY_set_state(ENERGY_STATE_TERMINAL, 0);
+#else
+    // Close the terminal of the attached host.
+    if (simulation_ctx.flags.log_attached != 0) {
+        terminal_status = TERMINAL_close(0);
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+        ENERGY_set_state(ENERGY_STATE_TERMINAL, 0);
+    }
+#endif
+    // Disable USB detect interrupt (attach state is read again on next start).
+    EXTI_disable_gpio_interrupt(&GPIO_USB_DETECT);
+    simulation_ctx.flags.log_attached = 0;
+    // Disable synchronization interrupt.
     EXTI_disable_gpio_interrupt(&GPIO_DUT_SYNCHRO);
-    simulation_ctx.flags.synchro_irq_enable = 0;
-    // Stop timer.
+    simulation_ctx.synchro_irq_enable = 0;
+    // Stop timer (time is frozen until next start).
+    simulation_ctx.flags.running = 0;
+    TIMEBASE_stop();
     tim_status = TIM_STD_stop(TIM_INSTANCE_SIMULATION);
     TIM_exit_error(SIMULATION_ERROR_BASE_WAVEFORM_TIMER);
 errors:
     return status;
 }
 
+/*******************************************************************/
+SIMULATION_status_t SIMULATION_set_personality(SEN15901_personality_t personality) {
+    // Local variables.
+    SIMULATION_status_t status = SIMULATION_SUCCESS;
+    SEN15901_status_t sen15901_status = SEN15901_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint8_t running = simulation_ctx.flags.running;
+    // Check parameter.
+    if (personality >= SEN15901_PERSONALITY_LAST) {
+        status = SIMULATION_ERROR_PERSONALITY;
+        goto errors;
+    }
+    // Stop waveform tick before switching the commit function.
+    if (running != 0) {
+        status = SIMULATION_stop();
+        if (status != SIMULATION_SUCCESS) goto errors;
+    }
+    // Re-init emulator with the new personality.
+    sen15901_status = SEN15901_de_init();
+    SEN15901_exit_error(SIMULATION_ERROR_BASE_SEN15901);
+    sen15901_status = SEN15901_init(personality);
+    SEN15901_exit_error(SIMULATION_ERROR_BASE_SEN15901);
+#ifdef SEN15901_EMULATOR_CHECK_INVARIANTS
+    sen15901_status = SEN15901_check_wind_direction();
+    SEN15901_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_SEN15901);
+#endif
+    simulation_ctx.tick_period_ms = SEN15901_get_tick_period_ms();
+    simulation_ctx.sen15901_commit = SEN15901_get_commit_callback();
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+    // Wind speed search bound depends on the personality.
+    STRESS_init();
+#endif
+    // Store boot personality, then its header which validates it.
+    nvm_status = NVM_write_byte(NVM_ADDRESS_SEN15901_PERSONALITY, (uint8_t) personality);
+    NVM_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_NVM);
+    if (nvm_status == NVM_SUCCESS) {
+        nvm_status = NVM_write_byte(NVM_ADDRESS_SEN15901_PERSONALITY_HEADER, SIMULATION_PERSONALITY_HEADER);
+        NVM_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_NVM);
+    }
+    // Restart simulation.
+    if (running != 0) {
+        status = SIMULATION_start();
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SIMULATION_status_t SIMULATION_seek(uint32_t step, uint32_t tick) {
+    // Local variables.
+    SIMULATION_status_t status = SIMULATION_SUCCESS;
+#ifdef SEN15901_EMULATOR_MODE_PROFILE
+    PROFILE_status_t profile_status = PROFILE_SUCCESS;
+#endif
+    uint32_t primask = 0;
+    // Check parameter.
+    if (tick > (simulation_ctx.fault_threshold_ms / simulation_ctx.tick_period_ms)) {
+        status = SIMULATION_ERROR_SEEK_TICK;
+        goto errors;
+    }
+    // Closed-form state of the step, no replay of the previous periods.
+    IRQ_SAVE(primask);
+    _SIMULATION_set_campaign_step(step);
+    simulation_ctx.time_ms = (tick * simulation_ctx.tick_period_ms);
+#if !((defined SEN15901_EMULATOR_MODE_WEATHER) || (defined SEN15901_EMULATOR_MODE_STRESS) || (defined SEN15901_EMULATOR_MODE_PROFILE))
+    _SIMULATION_set_period_tick(tick);
+#endif
+    IRQ_RESTORE(primask);
+#ifdef SEN15901_EMULATOR_MODE_PROFILE
+    // Profile is processed from the tick on next staging.
+    profile_status = PROFILE_start(&(SIMULATION_PROFILE_SCHEDULE[step % SIMULATION_PROFILE_SCHEDULE_SIZE]));
+    PROFILE_exit_error(SIMULATION_ERROR_BASE_PROFILE);
+    PROFILE_seek(tick);
+#endif
+errors:
+    return status;
+}
+
 /*******************************************************************/
 SIMULATION_status_t SIMULATION_process(void) {
     // Local variables.
     SIMULATION_status_t status = SIMULATION_SUCCESS;
     SEN15901_status_t sen15901_status = SEN15901_SUCCESS;
-    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    TRACE_status_t trace_status = TRACE_SUCCESS;
+    BOOT_status_t boot_status = BOOT_SUCCESS;
+    HISTORY_status_t history_status = HISTORY_SUCCESS;
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+    CAPTURE_status_t capture_status = CAPTURE_SUCCESS;
+#endif
+    int32_t wind_speed_error_ppm = 0;
+    EVENT_QUEUE_event_t event;
     uint8_t synchro_event = 0;
-    uint8_t log_enable = GPIO_read(&GPIO_USB_DETECT);
+    uint8_t timer_event = 0;
+    uint8_t next_step = 1;
+    ENERGY_status_t energy_status = ENERGY_SUCCESS;
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+    STRESS_status_t stress_status = STRESS_SUCCESS;
+    STRESS_channel_t stress_channel = STRESS_CHANNEL_LAST;
+    STRESS_report_t stress_report;
+#endif
+#ifdef SEN15901_EMULATOR_MODE_PROFILE
+    PROFILE_status_t profile_status = PROFILE_SUCCESS;
+#endif
+#ifdef SEN15901_EMULATOR_COVERAGE
+    COVERAGE_status_t coverage_status = COVERAGE_SUCCESS;
+#endif
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+    SYNCHRO_frame_t synchro_frame = { SYNCHRO_COMMAND_LEGACY, 0, 0 };
+    SIMULATION_status_t simulation_status = SIMULATION_SUCCESS;
+    SEN15901_personality_t personality = SEN15901_PERSONALITY_DEFAULT;
+#if (defined SEN15901_EMULATOR_MODE_WEATHER)
+    WEATHER_status_t weather_status = WEATHER_SUCCESS;
+#endif
+#endif
+    // Manage log interface attach and detach.
+    if (simulation_ctx.usb_detect_event != 0) {
+        simulation_ctx.usb_detect_event = 0;
+        _SIMULATION_update_log_interface();
+    }
+    // Continue the history replay without blocking the simulation.
+    if (simulation_ctx.flags.log_attached != 0) {
+        history_status = HISTORY_print(0, SIMULATION_HISTORY_REPLAY_PASS_RECORDS);
+        HISTORY_stack_error(ERROR_BASE_HISTORY);
+    }
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+    // Apply the personality switch requested by the DUT.
+    if (simulation_ctx.personality_request < SEN15901_PERSONALITY_LAST) {
+        personality = (SEN15901_personality_t) simulation_ctx.personality_request;
+        simulation_ctx.personality_request = SEN15901_PERSONALITY_LAST;
+        status = SIMULATION_set_personality(personality);
+        if (status != SIMULATION_SUCCESS) goto errors;
+    }
+#endif
     // Check fault condition.
-    GPIO_write(&GPIO_LED_FAULT, ((simulation_ctx.time_ms > SIMULATION_FAULT_TIME_THRESHOLD_MS) ? 1 : 0));
+    _SIMULATION_write_output(&GPIO_LED_FAULT, ENERGY_STATE_LED_FAULT, ((simulation_ctx.time_ms > simulation_ctx.fault_threshold_ms) ? 1 : 0));
     // Do not start before first DUT synchronization.
-    if (simulation_ctx.flags.first_synchro == 0) goto errors;
-    // Check synchronization flag.
-    if (simulation_ctx.flags.synchro != 0) {
-        // Clear flag.
-        simulation_ctx.flags.synchro = 0;
+    if (simulation_ctx.first_synchro == 0) goto errors;
+    // Early pulses do not start a new period, but their interval is learned so that a shorter DUT period is detected.
+    if (simulation_ctx.synchro_early_event != 0) {
+        simulation_ctx.synchro_early_event = 0;
+        SYNCHRO_add_interval(simulation_ctx.synchro_early_timestamp_ms - simulation_ctx.synchro_pulse_timestamp_ms);
+        _SIMULATION_update_synchro_window();
+        simulation_ctx.synchro_pulse_timestamp_ms = simulation_ctx.synchro_early_timestamp_ms;
+    }
+    // Process one synchronization event per call, the next ones are kept in the queue.
+    if (EVENT_QUEUE_pop(&(simulation_ctx.synchro_queue), &event) == EVENT_QUEUE_SUCCESS) {
+        simulation_ctx.flags.synchro_missed = 0;
         synchro_event = 1;
+        // Learn DUT period.
+        if (simulation_ctx.synchro_count != 0) {
+            SYNCHRO_add_interval(event.timestamp_ms - simulation_ctx.synchro_previous_timestamp_ms);
+            _SIMULATION_update_synchro_window();
+#ifdef SEN15901_EMULATOR_COVERAGE
+            // Account the period which has just ended.
+            COVERAGE_add_synchro_interval(event.timestamp_ms - simulation_ctx.synchro_previous_timestamp_ms);
+            COVERAGE_add_rainfall_period(simulation_ctx.rainfall_irq_count);
+#endif
+        }
+        simulation_ctx.synchro_previous_timestamp_ms = event.timestamp_ms;
+        simulation_ctx.synchro_pulse_timestamp_ms = event.timestamp_ms;
+        simulation_ctx.synchro_count++;
+        // Close energy accounting period.
+        energy_status = ENERGY_new_period(&(simulation_ctx.energy_report));
+        ENERGY_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_ENERGY);
+        simulation_ctx.flags.energy_report = 1;
+        // Close outputs signature.
+        simulation_ctx.signature_last = (simulation_ctx.signature ^ SIMULATION_SIGNATURE_CRC32_INIT);
+        simulation_ctx.signature_period = simulation_ctx.synchro_count;
+        simulation_ctx.signature = SIMULATION_SIGNATURE_CRC32_INIT;
         // Reset current values.
         simulation_ctx.time_ms = 0;
         simulation_ctx.wind_speed_kmh = 0;
+#ifdef SEN15901_EMULATOR_CHECK_INVARIANTS
+        simulation_ctx.wind_speed_previous_kmh = 0;
+#endif
         simulation_ctx.flags.wind_speed_down = 0;
         simulation_ctx.rainfall_irq_count = 0;
-        // Increment amplitudes.
-        simulation_ctx.wind_speed_peak_kmh = (simulation_ctx.wind_speed_peak_kmh + 1) % (SIMULATION_WIND_SPEED_KMH_MAX + 1);
-        simulation_ctx.wind_direction_table_index = (simulation_ctx.wind_direction_table_index + 1) % SEN15901_WIND_DIRECTION_NUMBER;
-        simulation_ctx.rainfall_peak_irq_count = (simulation_ctx.rainfall_peak_irq_count + 1) % (SIMULATION_RAINFALL_IRQ_COUNT_MAX + 1);
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+        synchro_frame.command = (SYNCHRO_command_t) (event.data >> SIMULATION_SYNCHRO_EVENT_COMMAND_SHIFT);
+        synchro_frame.argument = (uint16_t) (event.data & SIMULATION_SYNCHRO_EVENT_ARGUMENT_MASK);
+        synchro_frame.tick = (uint16_t) ((event.data >> SIMULATION_SYNCHRO_EVENT_TICK_SHIFT) & SIMULATION_SYNCHRO_EVENT_TICK_MASK);
+        // Campaign control.
+        if (synchro_frame.command == SYNCHRO_COMMAND_RESET) {
+            _SIMULATION_set_campaign_step(synchro_frame.argument);
+#ifdef SEN15901_EMULATOR_MODE_WEATHER
+            weather_status = WEATHER_init(&SIMULATION_WEATHER_CONFIGURATION);
+            WEATHER_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_WEATHER);
+#endif
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+            STRESS_init();
+#endif
+#ifdef SEN15901_EMULATOR_COVERAGE
+            COVERAGE_init();
+#endif
+        }
+        if (synchro_frame.command == SYNCHRO_COMMAND_JUMP) {
+            _SIMULATION_set_campaign_step(synchro_frame.argument);
+        }
+        // Repeat and reset commands keep the current amplitudes.
+        next_step = ((synchro_frame.command == SYNCHRO_COMMAND_LEGACY) || (synchro_frame.command == SYNCHRO_COMMAND_NEXT)) ? 1 : 0;
+#endif
+#ifdef SEN15901_EMULATOR_CLUSTER_FOLLOWER
+        // Amplitudes follow the campaign step of the leader.
+        next_step = (event.data == ((simulation_ctx.campaign_step + 1) & CLUSTER_STEP_MAX)) ? 1 : 0;
+        if (next_step == 0) {
+            _SIMULATION_set_campaign_step(event.data);
+        }
+#endif
+        if (next_step != 0) {
+            // Increment amplitudes.
+            simulation_ctx.campaign_step++;
+            simulation_ctx.wind_speed_peak_kmh = (simulation_ctx.wind_speed_peak_kmh + 1) % (SIMULATION_WIND_SPEED_KMH_MAX + 1);
+            simulation_ctx.wind_direction_table_index = (simulation_ctx.wind_direction_table_index + 1) % SEN15901_WIND_DIRECTION_NUMBER;
+            simulation_ctx.rainfall_peak_irq_count = (simulation_ctx.rainfall_peak_irq_count + 1) % (SIMULATION_RAINFALL_IRQ_COUNT_MAX + 1);
+#ifdef SEN15901_EMULATOR_MODE_WEATHER
+            // Draw new mean wind speed.
+            WEATHER_new_period();
+#endif
+        }
+#ifdef SEN15901_EMULATOR_MODE_PROFILE
+        // Play the profile of the campaign step (the DUT selects profile N with the jump command).
+        profile_status = PROFILE_start(&(SIMULATION_PROFILE_SCHEDULE[simulation_ctx.campaign_step % SIMULATION_PROFILE_SCHEDULE_SIZE]));
+        PROFILE_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_PROFILE);
+#endif
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+        // Position the step once restarted (the seek also positions the profile).
+        if (synchro_frame.command == SYNCHRO_COMMAND_SEEK) {
+            simulation_status = SIMULATION_seek(synchro_frame.argument, synchro_frame.tick);
+            SIMULATION_stack_error(ERROR_BASE_SIMULATION);
+        }
+#endif
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+        // Apply next frequency of the capacity search.
+        stress_status = STRESS_new_period();
+        STRESS_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_STRESS);
+        stress_channel = STRESS_get_channel();
+        if (stress_channel < STRESS_CHANNEL_LAST) {
+            stress_status = STRESS_get_report(stress_channel, &stress_report);
+            STRESS_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_STRESS);
+            _SIMULATION_update_signature(SIMULATION_SIGNATURE_OUTPUT_STRESS_FREQUENCY, ((stress_report.frequency_mhz << 1) | (uint32_t) stress_channel));
+        }
+#endif
+#ifdef SEN15901_EMULATOR_CLUSTER_LEADER
+        _SIMULATION_send_step_marker();
+#endif
         // Turn LED on.
-        GPIO_write(&GPIO_LED_SYNCHRO, 1);
-        GPIO_write(&GPIO_BATTERY_CHARGER_DISABLE, 1);
+        _SIMULATION_write_output(&GPIO_LED_SYNCHRO, ENERGY_STATE_LED_SYNCHRO, 1);
+        _SIMULATION_write_output(&GPIO_BATTERY_CHARGER_DISABLE, ENERGY_STATE_CHARGER_DISABLED, 1);
+    }
+    // Check missed synchronization.
+    if ((simulation_ctx.synchro_locked != 0) && (simulation_ctx.time_ms > simulation_ctx.fault_threshold_ms) && (simulation_ctx.flags.synchro_missed == 0)) {
+        simulation_ctx.flags.synchro_missed = 1;
+        TRACE_write(TRACE_EVENT_SYNCHRO_MISSED, (uint16_t) simulation_ctx.synchro_missed_count);
+        simulation_ctx.synchro_missed_count++;
     }
     // Manage synchronization interrupt.
-    if (simulation_ctx.time_ms > SIMULATION_DUT_SYNCHRO_IRQ_FILTER_MS) {
-        GPIO_write(&GPIO_LED_SYNCHRO, 0);
-        GPIO_write(&GPIO_BATTERY_CHARGER_DISABLE, 0);
-        simulation_ctx.flags.synchro_irq_enable = 1;
-    }
-    // Check timer flag.
-    if (simulation_ctx.flags.timer != 0) {
-        // Clear flag.
-        simulation_ctx.flags.timer = 0;
+    if (simulation_ctx.time_ms > simulation_ctx.synchro_filter_ms) {
+        _SIMULATION_write_output(&GPIO_LED_SYNCHRO, ENERGY_STATE_LED_SYNCHRO, 0);
+        _SIMULATION_write_output(&GPIO_BATTERY_CHARGER_DISABLE, ENERGY_STATE_CHARGER_DISABLED, 0);
+        simulation_ctx.synchro_irq_enable = 1;
+    }
+    // Process one tick event per call.
+    if (EVENT_QUEUE_pop(&(simulation_ctx.timer_queue), &event) == EVENT_QUEUE_SUCCESS) {
+        timer_event = 1;
+        // Values staged on this event are committed on next tick.
+        simulation_ctx.signature_tick = (event.data + 1);
+#ifdef SEN15901_EMULATOR_CLUSTER_LEADER
+        _SIMULATION_send_tick_marker();
+#endif
         // Blink LED.
         GPIO_toggle(&GPIO_LED_RUN);
-        // Wind speed.
-        if (simulation_ctx.wind_speed_peak_kmh > 0) {
-            if (simulation_ctx.wind_speed_kmh >= simulation_ctx.wind_speed_peak_kmh) {
-                // Clamp speed and start ramp down.
-                simulation_ctx.wind_speed_kmh = (simulation_ctx.wind_speed_peak_kmh - 1);
-                simulation_ctx.flags.wind_speed_down = 1;
-            }
-            else {
-                if (simulation_ctx.wind_speed_kmh == 0) {
-                    // Clamp speed and start ramp up.
-                    simulation_ctx.wind_speed_kmh = 1;
-                    simulation_ctx.flags.wind_speed_down = 0;
-                }
-                else {
-                    if (simulation_ctx.flags.wind_speed_down == 0) {
-                        simulation_ctx.wind_speed_kmh++;
-                    }
-                    else {
-                        simulation_ctx.wind_speed_kmh--;
-                    }
-                }
-            }
+        ENERGY_set_state(ENERGY_STATE_LED_RUN, GPIO_read(&GPIO_LED_RUN));
+        // Accumulate residency.
+        ENERGY_process();
+#ifdef SEN15901_EMULATOR_COVERAGE
+        // Values staged on previous tick have just been committed.
+        if ((simulation_ctx.coverage_staged & (0b1 << SIMULATION_SIGNATURE_OUTPUT_WIND_SPEED)) != 0) {
+            COVERAGE_add_wind_speed(simulation_ctx.coverage_wind_speed_ckmh);
         }
-        else {
-            simulation_ctx.wind_speed_kmh = 0;
+        if ((simulation_ctx.coverage_staged & (0b1 << SIMULATION_SIGNATURE_OUTPUT_WIND_DIRECTION)) != 0) {
+            COVERAGE_add_wind_direction(simulation_ctx.coverage_wind_direction_degrees);
         }
-        sen15901_status = SEN15901_set_wind_speed(simulation_ctx.wind_speed_kmh);
-        SEN15901_exit_error(SIMULATION_ERROR_BASE_SEN15901);
-        // Wind direction.
-        sen15901_status = SEN15901_set_wind_direction(SIMULATION_WIND_DIRECTION_TABLE[simulation_ctx.wind_direction_table_index]);
-        SEN15901_exit_error(SIMULATION_ERROR_BASE_SEN15901);
-        // Rainfall.
-        if ((simulation_ctx.time_ms >= SIMULATION_RAINFALL_TIMESTAMP_MS) && (simulation_ctx.rainfall_irq_count < simulation_ctx.rainfall_peak_irq_count)) {
+        simulation_ctx.coverage_staged = 0;
+#endif
+#ifdef SEN15901_EMULATOR_COVERAGE_CHECKPOINT
+        // Save one histogram counter per tick.
+        coverage_status = COVERAGE_checkpoint(NVM_ADDRESS_COVERAGE);
+        COVERAGE_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_COVERAGE);
+#endif
+    }
+    if (timer_event != 0) {
+        // Stage the values to be applied on next tick (once per tick, the synchronization only resets the current values).
+        status = _SIMULATION_stage_waveforms();
+        if (status != SIMULATION_SUCCESS) goto errors;
+        // Switch the waveform timer to the sub-tick rate if a vane rotation has been started.
+        _SIMULATION_update_timer_period();
+#ifdef SEN15901_EMULATOR_CHECK_INVARIANTS
+        _SIMULATION_check_invariants();
+#endif
+#ifndef SEN15901_EMULATOR_MODE_STRESS
+        // Rainfall (pulses train is driven by the capacity search in stress mode).
+#ifdef SEN15901_EMULATOR_MODE_WEATHER
+        if (simulation_ctx.weather_output.rainfall_pulse != 0) {
+#else
+        if ((simulation_ctx.time_ms >= simulation_ctx.rainfall_timestamp_ms) && (simulation_ctx.rainfall_irq_count < simulation_ctx.rainfall_peak_irq_count)) {
+#endif
             // Add rain.
             sen15901_status = SEN15901_make_rainfall_interrupt();
             SEN15901_exit_error(SIMULATION_ERROR_BASE_SEN15901);
+            _SIMULATION_update_signature(SIMULATION_SIGNATURE_OUTPUT_RAINFALL_PULSE, simulation_ctx.rainfall_irq_count);
             // Update counter.
             simulation_ctx.rainfall_irq_count++;
         }
-        if (log_enable != 0) {
-            // Open terminal.
-            terminal_status = TERMINAL_open(0, SIMULATION_LOG_BAUD_RATE, NULL);
-            TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+#endif
+        // Keep the tick values for the next host.
+        _SIMULATION_write_history(synchro_event);
+        if (simulation_ctx.flags.log_attached != 0) {
+            TRACE_write(TRACE_EVENT_LOG_START, 0);
             // Print current simulation values.
             _SIMULATION_print_sw_version();
             if (synchro_event != 0) {
                 _SIMULATION_print_string("DUT_synchro");
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+                _SIMULATION_print_value("DUT_command=", (int32_t) synchro_frame.command, NULL);
+                _SIMULATION_print_value("DUT_argument=", (int32_t) synchro_frame.argument, NULL);
+                _SIMULATION_print_value("DUT_tick=", (int32_t) synchro_frame.tick, NULL);
+#endif
             }
+#ifdef SEN15901_EMULATOR_MODE_WEATHER
+            _SIMULATION_print_value("Wind_speed=", (int32_t) simulation_ctx.weather_output.wind_speed_ckmh, "ckm/h");
+            _SIMULATION_print_value("Wind_speed_mean=", (int32_t) simulation_ctx.weather_output.wind_speed_mean_ckmh, "ckm/h");
+#elif (defined SEN15901_EMULATOR_MODE_PROFILE)
+            _SIMULATION_print_value("Wind_speed=", (int32_t) simulation_ctx.profile_wind_speed_ckmh, "ckm/h");
+            _SIMULATION_print_value("Profile=", (int32_t) SIMULATION_PROFILE_SCHEDULE[simulation_ctx.campaign_step % SIMULATION_PROFILE_SCHEDULE_SIZE].type, NULL);
+#else
             _SIMULATION_print_value("Wind_speed=", (int32_t) simulation_ctx.wind_speed_kmh, "km/h");
+#endif
+            sen15901_status = SEN15901_get_wind_speed_error(&wind_speed_error_ppm);
+            SEN15901_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_SEN15901);
+            _SIMULATION_print_value("Wind_speed_error=", wind_speed_error_ppm, "ppm");
+            if (SEN15901_get_personality() == SEN15901_PERSONALITY_DUAL) {
+                _SIMULATION_print_value("Wind_speed_classic=", (int32_t) SEN15901_get_classic_wind_speed_ckmh(), "ckm/h");
+            }
+#ifdef SEN15901_EMULATOR_MODE_WEATHER
+            _SIMULATION_print_value("Wind_direction=", (int32_t) simulation_ctx.weather_output.wind_direction_degrees, "d");
+            _SIMULATION_print_value("Rainfall=", (int32_t) simulation_ctx.rainfall_irq_count, "irq");
+#else
+#ifndef SEN15901_EMULATOR_MODE_PROFILE
             _SIMULATION_print_value("Wind_speed_peak=", (int32_t) simulation_ctx.wind_speed_peak_kmh, "km/h");
+#endif
             _SIMULATION_print_value("Wind_direction=", (int32_t) SIMULATION_WIND_DIRECTION_TABLE[simulation_ctx.wind_direction_table_index], "d");
             _SIMULATION_print_value("Rainfall=", (int32_t) simulation_ctx.rainfall_irq_count, "irq");
             _SIMULATION_print_value("Rainfall_peak=", (int32_t) simulation_ctx.rainfall_peak_irq_count, "irq");
+#endif
+#ifdef SEN15901_EMULATOR_MODE_STRESS
+            _SIMULATION_print_stress_report();
+#endif
+            _SIMULATION_print_synchro_report();
+#ifdef SEN15901_EMULATOR_CLUSTER_FOLLOWER
+            _SIMULATION_print_value("Cluster_skew=", simulation_ctx.cluster_skew_us, "us");
+#endif
+            if (simulation_ctx.signature_period != 0) {
+                _SIMULATION_print_signature();
+            }
+            if (simulation_ctx.flags.energy_report != 0) {
+                simulation_ctx.flags.energy_report = 0;
+                _SIMULATION_print_energy_report();
+            }
+            // Print boot timings once.
+            boot_status = BOOT_print(0);
+            BOOT_stack_error(ERROR_BASE_BOOT);
+            // Dump trace records.
+            trace_status = TRACE_print(0);
+            TRACE_stack_error(ERROR_BASE_TRACE);
+#ifdef SEN15901_EMULATOR_MODE_CAPTURE
+            // Stream waveform segments.
+            capture_status = CAPTURE_print(0);
+            CAPTURE_stack_error(ERROR_BASE_CAPTURE);
+#endif
+#ifdef SEN15901_EMULATOR_COVERAGE
+#ifdef SEN15901_EMULATOR_SYNCHRO_COMMAND
+            if (simulation_ctx.coverage_request != 0) {
+                simulation_ctx.coverage_request = 0;
+#else
+            if (synchro_event != 0) {
+#endif
+                coverage_status = COVERAGE_print(0);
+                COVERAGE_stack_error(ERROR_BASE_SIMULATION + SIMULATION_ERROR_BASE_COVERAGE);
+            }
+#endif
             _SIMULATION_print_string(NULL);
-            // Close terminal.
-            terminal_status = TERMINAL_close(0);
-            TERMINAL_stack_error(ERROR_BASE_TERMINAL);
+            TRACE_write(TRACE_EVENT_LOG_END, 0);
         }
     }
 errors:
@@ -0,0 +1,121 @@
+/*
+ * stress.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __STRESS_H__
+#define __STRESS_H__
+
+#include "error.h"
+#include "sen15901.h"
+#include "types.h"
+
+/*** STRESS structures ***/
+
+/*!******************************************************************
+ * \enum STRESS_status_t
+ * \brief Stress profile error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    STRESS_SUCCESS = 0,
+    STRESS_ERROR_NULL_PARAMETER,
+    STRESS_ERROR_CHANNEL,
+    // Low level driver errors.
+    STRESS_ERROR_BASE_SEN15901 = ERROR_BASE_STEP,
+    // Last base value.
+    STRESS_ERROR_BASE_LAST = (STRESS_ERROR_BASE_SEN15901 + SEN15901_ERROR_BASE_LAST)
+} STRESS_status_t;
+
+/*!******************************************************************
+ * \enum STRESS_channel_t
+ * \brief Stressed DUT input channels.
+ *******************************************************************/
+typedef enum {
+    STRESS_CHANNEL_WIND_SPEED = 0,
+    STRESS_CHANNEL_RAINFALL,
+    STRESS_CHANNEL_LAST
+} STRESS_channel_t;
+
+/*!******************************************************************
+ * \enum STRESS_verdict_t
+ * \brief Comparison result of the DUT counts with the generated pulses.
+ *******************************************************************/
+typedef enum {
+    STRESS_VERDICT_NONE = 0,
+    STRESS_VERDICT_PASS,
+    STRESS_VERDICT_FAIL,
+    STRESS_VERDICT_LAST
+} STRESS_verdict_t;
+
+/*!******************************************************************
+ * \struct STRESS_report_t
+ * \brief Binary search state of a channel.
+ *******************************************************************/
+typedef struct {
+    uint32_t frequency_mhz;
+    uint32_t pass_frequency_mhz;
+    uint32_t fail_frequency_mhz;
+    uint32_t step_count;
+    uint8_t done;
+} STRESS_report_t;
+
+/*** STRESS functions ***/
+
+/*!******************************************************************
+ * \fn void STRESS_init(void)
+ * \brief Init stress profile (wind speed channel is searched first).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void STRESS_init(void);
+
+/*!******************************************************************
+ * \fn void STRESS_set_verdict(STRESS_verdict_t verdict)
+ * \brief Give the result of the last tested frequency (interrupt safe).
+ * \param[in]   verdict: Result of the DUT counts comparison.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void STRESS_set_verdict(STRESS_verdict_t verdict);
+
+/*!******************************************************************
+ * \fn STRESS_status_t STRESS_new_period(void)
+ * \brief Update binary search with the received verdict and apply the frequency to test during the new synchronization period.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+STRESS_status_t STRESS_new_period(void);
+
+/*!******************************************************************
+ * \fn STRESS_status_t STRESS_get_report(STRESS_channel_t channel, STRESS_report_t* report)
+ * \brief Get capacity search state of a channel.
+ * \param[in]   channel: Channel to read.
+ * \param[out]  report: Pointer to the search state.
+ * \retval      Function execution status.
+ *******************************************************************/
+STRESS_status_t STRESS_get_report(STRESS_channel_t channel, STRESS_report_t* report);
+
+/*!******************************************************************
+ * \fn STRESS_channel_t STRESS_get_channel(void)
+ * \brief Get the channel currently under test.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Channel under test (STRESS_CHANNEL_LAST when all searches are completed).
+ *******************************************************************/
+STRESS_channel_t STRESS_get_channel(void);
+
+/*******************************************************************/
+#define STRESS_exit_error(base) { ERROR_check_exit(stress_status, STRESS_SUCCESS, base) }
+
+/*******************************************************************/
+#define STRESS_stack_error(base) { ERROR_check_stack(stress_status, STRESS_SUCCESS, base) }
+
+/*******************************************************************/
+#define STRESS_stack_exit_error(base, code) { ERROR_check_stack_exit(stress_status, STRESS_SUCCESS, base, code) }
+
+#endif /* __STRESS_H__ */
@@ -0,0 +1,165 @@
+/*
+ * stress.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "stress.h"
+
+#include "error.h"
+#include "sen15901.h"
+#include "types.h"
+
+/*** STRESS local macros ***/
+
+// Lower bounds are the nominal profile limits (assumed to be correctly counted by the DUT).
+#define STRESS_WIND_SPEED_MH_MIN                120000
+#define STRESS_WIND_FREQUENCY_MHZ_MAX           SEN15901_WIND_FREQUENCY_MHZ_MAX
+#define STRESS_RAINFALL_FREQUENCY_MHZ_MIN       2500
+#define STRESS_RAINFALL_FREQUENCY_MHZ_MAX       10000000
+
+// Search is stopped when the interval is lower than (pass_frequency / 2^STRESS_RESOLUTION_SHIFT).
+#define STRESS_RESOLUTION_SHIFT                 6
+
+// Wind speed in 0.01km/h is (frequency_mhz * wind_speed_1hz_to_mh / STRESS_WIND_SPEED_DIVIDER).
+#define STRESS_WIND_SPEED_DIVIDER               10000
+
+/*** STRESS local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t frequency_mhz_min;
+    uint32_t frequency_mhz_max;
+} STRESS_channel_range_t;
+
+/*******************************************************************/
+typedef struct {
+    STRESS_report_t report[STRESS_CHANNEL_LAST];
+    STRESS_channel_t channel;
+    volatile STRESS_verdict_t verdict;
+} STRESS_context_t;
+
+/*** STRESS local global variables ***/
+
+static STRESS_context_t stress_ctx;
+
+/*** STRESS local functions ***/
+
+/*******************************************************************/
+static STRESS_status_t _STRESS_apply(STRESS_channel_t channel, uint32_t frequency_mhz) {
+    // Local variables.
+    STRESS_status_t status = STRESS_SUCCESS;
+    SEN15901_status_t sen15901_status = SEN15901_SUCCESS;
+    uint32_t wind_speed_ckmh = 0;
+    uint32_t rainfall_frequency_mhz = 0;
+    // Only the channel under test is active.
+    if (channel == STRESS_CHANNEL_WIND_SPEED) {
+        wind_speed_ckmh = (uint32_t) ((((uint64_t) frequency_mhz) * SEN15901_get_wind_speed_1hz_to_mh()) / STRESS_WIND_SPEED_DIVIDER);
+    }
+    if (channel == STRESS_CHANNEL_RAINFALL) {
+        rainfall_frequency_mhz = frequency_mhz;
+    }
+    sen15901_status = SEN15901_set_wind_speed(wind_speed_ckmh);
+    SEN15901_exit_error(STRESS_ERROR_BASE_SEN15901);
+    sen15901_status = SEN15901_set_rainfall_frequency(rainfall_frequency_mhz);
+    SEN15901_exit_error(STRESS_ERROR_BASE_SEN15901);
+errors:
+    return status;
+}
+
+/*** STRESS functions ***/
+
+/*******************************************************************/
+void STRESS_init(void) {
+    // Local variables.
+    STRESS_channel_range_t channel_range[STRESS_CHANNEL_LAST] = {
+        { ((STRESS_WIND_SPEED_MH_MIN * MATH_POWER_10[3]) / SEN15901_get_wind_speed_1hz_to_mh()), STRESS_WIND_FREQUENCY_MHZ_MAX },
+        { STRESS_RAINFALL_FREQUENCY_MHZ_MIN, STRESS_RAINFALL_FREQUENCY_MHZ_MAX }
+    };
+    uint8_t idx = 0;
+    // Init search intervals (wind speed bound depends on the emulated personality).
+    for (idx = 0; idx < STRESS_CHANNEL_LAST; idx++) {
+        stress_ctx.report[idx].pass_frequency_mhz = channel_range[idx].frequency_mhz_min;
+        stress_ctx.report[idx].fail_frequency_mhz = channel_range[idx].frequency_mhz_max;
+        stress_ctx.report[idx].frequency_mhz = 0;
+        stress_ctx.report[idx].step_count = 0;
+        stress_ctx.report[idx].done = 0;
+    }
+    stress_ctx.channel = STRESS_CHANNEL_WIND_SPEED;
+    stress_ctx.verdict = STRESS_VERDICT_NONE;
+}
+
+/*******************************************************************/
+void STRESS_set_verdict(STRESS_verdict_t verdict) {
+    // Store last result.
+    if (verdict < STRESS_VERDICT_LAST) {
+        stress_ctx.verdict = verdict;
+    }
+}
+
+/*******************************************************************/
+STRESS_status_t STRESS_new_period(void) {
+    // Local variables.
+    STRESS_status_t status = STRESS_SUCCESS;
+    STRESS_report_t* report = NULL;
+    STRESS_verdict_t verdict = stress_ctx.verdict;
+    // Check state.
+    if (stress_ctx.channel >= STRESS_CHANNEL_LAST) goto errors;
+    report = &(stress_ctx.report[stress_ctx.channel]);
+    // Update interval with the result of the tested frequency (the same frequency is tested again until a verdict is received).
+    if ((report->frequency_mhz != 0) && (verdict != STRESS_VERDICT_NONE)) {
+        stress_ctx.verdict = STRESS_VERDICT_NONE;
+        if (verdict == STRESS_VERDICT_PASS) {
+            report->pass_frequency_mhz = report->frequency_mhz;
+        }
+        else {
+            report->fail_frequency_mhz = report->frequency_mhz;
+        }
+        report->frequency_mhz = 0;
+        report->step_count++;
+        // Check resolution.
+        if ((report->fail_frequency_mhz - report->pass_frequency_mhz) <= (report->pass_frequency_mhz >> STRESS_RESOLUTION_SHIFT)) {
+            report->done = 1;
+            stress_ctx.channel++;
+            if (stress_ctx.channel >= STRESS_CHANNEL_LAST) {
+                // All searches completed: back to idle outputs.
+                status = _STRESS_apply(STRESS_CHANNEL_LAST, 0);
+                goto errors;
+            }
+            report = &(stress_ctx.report[stress_ctx.channel]);
+        }
+    }
+    // Compute next frequency to test.
+    if (report->frequency_mhz == 0) {
+        report->frequency_mhz = report->pass_frequency_mhz + ((report->fail_frequency_mhz - report->pass_frequency_mhz) >> 1);
+        // Discard verdicts received before the new frequency is applied.
+        stress_ctx.verdict = STRESS_VERDICT_NONE;
+    }
+    status = _STRESS_apply(stress_ctx.channel, report->frequency_mhz);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+STRESS_status_t STRESS_get_report(STRESS_channel_t channel, STRESS_report_t* report) {
+    // Local variables.
+    STRESS_status_t status = STRESS_SUCCESS;
+    // Check parameters.
+    if (channel >= STRESS_CHANNEL_LAST) {
+        status = STRESS_ERROR_CHANNEL;
+        goto errors;
+    }
+    if (report == NULL) {
+        status = STRESS_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    (*report) = stress_ctx.report[channel];
+errors:
+    return status;
+}
+
+/*******************************************************************/
+STRESS_channel_t STRESS_get_channel(void) {
+    return (stress_ctx.channel);
+}
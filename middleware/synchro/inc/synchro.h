@@ -0,0 +1,140 @@
+/*
+ * synchro.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SYNCHRO_H__
+#define __SYNCHRO_H__
+
+#include "error.h"
+#include "types.h"
+
+/*** SYNCHRO macros ***/
+
+// Commands are encoded in the width of the DUT synchronization pulse (1ms resolution):
+//   1ms                    -> NEXT (move to the next campaign step).
+//   2ms                    -> REPEAT (restart the current campaign step).
+//   3ms                    -> RESET (restart the campaign from step P).
+//   4ms                    -> COVERAGE (print stimulus coverage histograms, the campaign goes on).
+//   5ms + N (N=0..2)       -> PERSONALITY switch to sensor variant N (stored as boot personality).
+//   10ms + N (N=0..255)    -> JUMP to campaign step ((P << 8) + N).
+//   300ms + N (N=1..999)   -> PERIOD announcement of (N * 10) seconds.
+//   1300ms + N (N=0..255)  -> PREFIX of the next command: P = ((P << 8) + N).
+//   1600ms + N (N=0..399)  -> SEEK to tick N of campaign step P.
+// Any other width is a legacy synchronization pulse (commands are all shorter than 2s).
+// The prefix value P is 0 by default, it is cleared by any other pulse and truncated to the step range.
+#define SYNCHRO_PERSONALITY_ARGUMENT_MAX    2
+#define SYNCHRO_JUMP_ARGUMENT_MAX           255
+#define SYNCHRO_PERIOD_ARGUMENT_MAX         999
+#define SYNCHRO_PREFIX_ARGUMENT_MAX         255
+#define SYNCHRO_SEEK_ARGUMENT_MAX           399
+#define SYNCHRO_STEP_MAX                    0xFFFF
+#define SYNCHRO_PERIOD_UNIT_MS              10000
+
+/*** SYNCHRO structures ***/
+
+/*!******************************************************************
+ * \enum SYNCHRO_status_t
+ * \brief Synchronization commands decoder error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    SYNCHRO_SUCCESS = 0,
+    SYNCHRO_ERROR_NULL_PARAMETER,
+    // Last base value.
+    SYNCHRO_ERROR_BASE_LAST = ERROR_BASE_STEP
+} SYNCHRO_status_t;
+
+/*!******************************************************************
+ * \enum SYNCHRO_command_t
+ * \brief DUT synchronization commands list.
+ *******************************************************************/
+typedef enum {
+    SYNCHRO_COMMAND_LEGACY = 0,
+    SYNCHRO_COMMAND_NEXT,
+    SYNCHRO_COMMAND_REPEAT,
+    SYNCHRO_COMMAND_RESET,
+    SYNCHRO_COMMAND_JUMP,
+    SYNCHRO_COMMAND_PERIOD,
+    SYNCHRO_COMMAND_SEEK,
+    SYNCHRO_COMMAND_COVERAGE,
+    SYNCHRO_COMMAND_PERSONALITY,
+    SYNCHRO_COMMAND_PREFIX,
+    SYNCHRO_COMMAND_LAST
+} SYNCHRO_command_t;
+
+/*!******************************************************************
+ * \struct SYNCHRO_estimation_t
+ * \brief DUT synchronization period estimation.
+ *******************************************************************/
+typedef struct {
+    uint32_t period_ms;
+    uint32_t jitter_ms;
+    uint32_t window_min_ms;
+    uint32_t window_max_ms;
+    uint32_t sample_count;
+    uint8_t locked;
+} SYNCHRO_estimation_t;
+
+/*!******************************************************************
+ * \struct SYNCHRO_frame_t
+ * \brief Decoded synchronization pulse.
+ *******************************************************************/
+typedef struct {
+    SYNCHRO_command_t command;
+    // Campaign step for the RESET, JUMP and SEEK commands.
+    uint16_t argument;
+    // Tick within the step for the SEEK command.
+    uint16_t tick;
+} SYNCHRO_frame_t;
+
+/*** SYNCHRO functions ***/
+
+/*!******************************************************************
+ * \fn void SYNCHRO_reset_estimation(uint32_t period_ms)
+ * \brief Restart DUT synchronization period learning.
+ * \param[in]   period_ms: Expected period in ms (0 if unknown).
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void SYNCHRO_reset_estimation(uint32_t period_ms);
+
+/*!******************************************************************
+ * \fn void SYNCHRO_add_interval(uint32_t interval_ms)
+ * \brief Update period and jitter estimation with the interval between two accepted synchronization pulses.
+ * \param[in]   interval_ms: Measured interval in ms.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void SYNCHRO_add_interval(uint32_t interval_ms);
+
+/*!******************************************************************
+ * \fn SYNCHRO_status_t SYNCHRO_get_estimation(SYNCHRO_estimation_t* estimation)
+ * \brief Get DUT synchronization period estimation and acceptance window.
+ * \param[in]   none
+ * \param[out]  estimation: Pointer to the current estimation.
+ * \retval      Function execution status.
+ *******************************************************************/
+SYNCHRO_status_t SYNCHRO_get_estimation(SYNCHRO_estimation_t* estimation);
+
+/*!******************************************************************
+ * \fn SYNCHRO_status_t SYNCHRO_decode(uint32_t pulse_width_us, SYNCHRO_frame_t* frame)
+ * \brief Decode a synchronization pulse (to be called from the synchronization interrupt only, the prefix is kept between calls).
+ * \param[in]   pulse_width_us: Measured width of the pulse in us.
+ * \param[out]  frame: Pointer to the decoded command and its argument.
+ * \retval      Function execution status.
+ *******************************************************************/
+SYNCHRO_status_t SYNCHRO_decode(uint32_t pulse_width_us, SYNCHRO_frame_t* frame);
+
+/*******************************************************************/
+#define SYNCHRO_exit_error(base) { ERROR_check_exit(synchro_status, SYNCHRO_SUCCESS, base) }
+
+/*******************************************************************/
+#define SYNCHRO_stack_error(base) { ERROR_check_stack(synchro_status, SYNCHRO_SUCCESS, base) }
+
+/*******************************************************************/
+#define SYNCHRO_stack_exit_error(base, code) { ERROR_check_stack_exit(synchro_status, SYNCHRO_SUCCESS, base, code) }
+
+#endif /* __SYNCHRO_H__ */
@@ -0,0 +1,194 @@
+/*
+ * synchro.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "synchro.h"
+
+#include "error.h"
+#include "types.h"
+
+/*** SYNCHRO local macros ***/
+
+#define SYNCHRO_US_PER_MS                    1000
+
+#define SYNCHRO_WIDTH_MS_NEXT                1
+#define SYNCHRO_WIDTH_MS_REPEAT              2
+#define SYNCHRO_WIDTH_MS_RESET               3
+#define SYNCHRO_WIDTH_MS_COVERAGE            4
+#define SYNCHRO_WIDTH_MS_PERSONALITY_BASE    5
+#define SYNCHRO_WIDTH_MS_JUMP_BASE           10
+#define SYNCHRO_WIDTH_MS_PERIOD_BASE         300
+#define SYNCHRO_WIDTH_MS_PREFIX_BASE         1300
+#define SYNCHRO_WIDTH_MS_SEEK_BASE           1600
+
+#define SYNCHRO_PREFIX_SHIFT                 8
+
+// Period and mean deviation are smoothed with 1/8 and 1/4 gains (stored in Q3 and Q2 formats).
+#define SYNCHRO_PERIOD_GAIN_SHIFT       3
+#define SYNCHRO_JITTER_GAIN_SHIFT       2
+// Acceptance window is the estimated period +/- (4 * jitter + period / 32).
+#define SYNCHRO_WINDOW_JITTER_FACTOR    4
+#define SYNCHRO_WINDOW_MARGIN_SHIFT     5
+// Estimation is used after this number of samples.
+#define SYNCHRO_LOCK_SAMPLE_COUNT       4
+// Learning is restarted after this number of consecutive intervals out of the window.
+#define SYNCHRO_OUTLIER_COUNT_MAX       3
+
+/*** SYNCHRO local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t period_q3;
+    uint32_t jitter_q2;
+    uint32_t sample_count;
+    uint8_t outlier_count;
+    uint32_t prefix;
+} SYNCHRO_context_t;
+
+/*** SYNCHRO local global variables ***/
+
+static SYNCHRO_context_t synchro_ctx = {
+    .period_q3 = 0,
+    .jitter_q2 = 0,
+    .sample_count = 0,
+    .outlier_count = 0,
+    .prefix = 0
+};
+
+/*** SYNCHRO local functions ***/
+
+/*******************************************************************/
+static void _SYNCHRO_compute_window(uint32_t* window_min_ms, uint32_t* window_max_ms) {
+    // Local variables.
+    uint32_t period_ms = (synchro_ctx.period_q3 >> SYNCHRO_PERIOD_GAIN_SHIFT);
+    uint32_t half_width_ms = (SYNCHRO_WINDOW_JITTER_FACTOR * (synchro_ctx.jitter_q2 >> SYNCHRO_JITTER_GAIN_SHIFT)) + (period_ms >> SYNCHRO_WINDOW_MARGIN_SHIFT);
+    // Compute bounds.
+    (*window_min_ms) = (half_width_ms < period_ms) ? (period_ms - half_width_ms) : 0;
+    (*window_max_ms) = (period_ms + half_width_ms);
+}
+
+/*** SYNCHRO functions ***/
+
+/*******************************************************************/
+void SYNCHRO_reset_estimation(uint32_t period_ms) {
+    // Seed estimation with the expected period (counted as locked).
+    synchro_ctx.period_q3 = (period_ms << SYNCHRO_PERIOD_GAIN_SHIFT);
+    synchro_ctx.jitter_q2 = ((period_ms >> SYNCHRO_WINDOW_MARGIN_SHIFT) << SYNCHRO_JITTER_GAIN_SHIFT);
+    synchro_ctx.sample_count = (period_ms == 0) ? 0 : SYNCHRO_LOCK_SAMPLE_COUNT;
+    synchro_ctx.outlier_count = 0;
+}
+
+/*******************************************************************/
+void SYNCHRO_add_interval(uint32_t interval_ms) {
+    // Local variables.
+    uint32_t window_min_ms = 0;
+    uint32_t window_max_ms = 0;
+    int32_t error_ms = 0;
+    // Reject outliers once locked (missed or spurious pulses), unless the DUT period has really changed.
+    if (synchro_ctx.sample_count >= SYNCHRO_LOCK_SAMPLE_COUNT) {
+        _SYNCHRO_compute_window(&window_min_ms, &window_max_ms);
+        if ((interval_ms < window_min_ms) || (interval_ms > window_max_ms)) {
+            synchro_ctx.outlier_count++;
+            if (synchro_ctx.outlier_count < SYNCHRO_OUTLIER_COUNT_MAX) goto errors;
+            // Restart learning from this interval.
+            SYNCHRO_reset_estimation(0);
+        }
+    }
+    // First sample.
+    if (synchro_ctx.sample_count == 0) {
+        synchro_ctx.period_q3 = (interval_ms << SYNCHRO_PERIOD_GAIN_SHIFT);
+        synchro_ctx.jitter_q2 = ((interval_ms >> 1) << SYNCHRO_JITTER_GAIN_SHIFT);
+        synchro_ctx.sample_count = 1;
+        goto errors;
+    }
+    synchro_ctx.outlier_count = 0;
+    // Mean deviation is updated with the error of the previous period estimation.
+    error_ms = ((int32_t) interval_ms) - ((int32_t) (synchro_ctx.period_q3 >> SYNCHRO_PERIOD_GAIN_SHIFT));
+    if (error_ms < 0) {
+        error_ms = (-error_ms);
+    }
+    synchro_ctx.jitter_q2 = synchro_ctx.jitter_q2 - (synchro_ctx.jitter_q2 >> SYNCHRO_JITTER_GAIN_SHIFT) + ((uint32_t) error_ms);
+    synchro_ctx.period_q3 = synchro_ctx.period_q3 - (synchro_ctx.period_q3 >> SYNCHRO_PERIOD_GAIN_SHIFT) + interval_ms;
+    synchro_ctx.sample_count++;
+errors:
+    return;
+}
+
+/*******************************************************************/
+SYNCHRO_status_t SYNCHRO_get_estimation(SYNCHRO_estimation_t* estimation) {
+    // Local variables.
+    SYNCHRO_status_t status = SYNCHRO_SUCCESS;
+    // Check parameter.
+    if (estimation == NULL) {
+        status = SYNCHRO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    estimation->period_ms = (synchro_ctx.period_q3 >> SYNCHRO_PERIOD_GAIN_SHIFT);
+    estimation->jitter_ms = (synchro_ctx.jitter_q2 >> SYNCHRO_JITTER_GAIN_SHIFT);
+    estimation->sample_count = synchro_ctx.sample_count;
+    estimation->locked = (synchro_ctx.sample_count >= SYNCHRO_LOCK_SAMPLE_COUNT) ? 1 : 0;
+    _SYNCHRO_compute_window(&(estimation->window_min_ms), &(estimation->window_max_ms));
+errors:
+    return status;
+}
+
+/*******************************************************************/
+SYNCHRO_status_t SYNCHRO_decode(uint32_t pulse_width_us, SYNCHRO_frame_t* frame) {
+    // Local variables.
+    SYNCHRO_status_t status = SYNCHRO_SUCCESS;
+    uint32_t pulse_width_ms = ((pulse_width_us + (SYNCHRO_US_PER_MS >> 1)) / SYNCHRO_US_PER_MS);
+    uint32_t prefix = synchro_ctx.prefix;
+    // Check parameter.
+    if (frame == NULL) {
+        status = SYNCHRO_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Default is legacy pulse, the prefix only applies to the next pulse.
+    frame->command = SYNCHRO_COMMAND_LEGACY;
+    frame->argument = 0;
+    frame->tick = 0;
+    synchro_ctx.prefix = 0;
+    // Fixed width commands.
+    if (pulse_width_ms == SYNCHRO_WIDTH_MS_NEXT) {
+        frame->command = SYNCHRO_COMMAND_NEXT;
+    }
+    else if (pulse_width_ms == SYNCHRO_WIDTH_MS_REPEAT) {
+        frame->command = SYNCHRO_COMMAND_REPEAT;
+    }
+    else if (pulse_width_ms == SYNCHRO_WIDTH_MS_RESET) {
+        frame->command = SYNCHRO_COMMAND_RESET;
+        frame->argument = (uint16_t) prefix;
+    }
+    else if (pulse_width_ms == SYNCHRO_WIDTH_MS_COVERAGE) {
+        frame->command = SYNCHRO_COMMAND_COVERAGE;
+    }
+    // Commands with argument.
+    else if ((pulse_width_ms >= SYNCHRO_WIDTH_MS_PERSONALITY_BASE) && (pulse_width_ms <= (SYNCHRO_WIDTH_MS_PERSONALITY_BASE + SYNCHRO_PERSONALITY_ARGUMENT_MAX))) {
+        frame->command = SYNCHRO_COMMAND_PERSONALITY;
+        frame->argument = (uint16_t) (pulse_width_ms - SYNCHRO_WIDTH_MS_PERSONALITY_BASE);
+    }
+    else if ((pulse_width_ms >= SYNCHRO_WIDTH_MS_JUMP_BASE) && (pulse_width_ms <= (SYNCHRO_WIDTH_MS_JUMP_BASE + SYNCHRO_JUMP_ARGUMENT_MAX))) {
+        frame->command = SYNCHRO_COMMAND_JUMP;
+        frame->argument = (uint16_t) (((prefix << SYNCHRO_PREFIX_SHIFT) + (pulse_width_ms - SYNCHRO_WIDTH_MS_JUMP_BASE)) & SYNCHRO_STEP_MAX);
+    }
+    else if ((pulse_width_ms > SYNCHRO_WIDTH_MS_PERIOD_BASE) && (pulse_width_ms <= (SYNCHRO_WIDTH_MS_PERIOD_BASE + SYNCHRO_PERIOD_ARGUMENT_MAX))) {
+        frame->command = SYNCHRO_COMMAND_PERIOD;
+        frame->argument = (uint16_t) (pulse_width_ms - SYNCHRO_WIDTH_MS_PERIOD_BASE);
+    }
+    else if ((pulse_width_ms >= SYNCHRO_WIDTH_MS_PREFIX_BASE) && (pulse_width_ms <= (SYNCHRO_WIDTH_MS_PREFIX_BASE + SYNCHRO_PREFIX_ARGUMENT_MAX))) {
+        // Argument is the accumulated prefix.
+        synchro_ctx.prefix = (((prefix << SYNCHRO_PREFIX_SHIFT) + (pulse_width_ms - SYNCHRO_WIDTH_MS_PREFIX_BASE)) & SYNCHRO_STEP_MAX);
+        frame->command = SYNCHRO_COMMAND_PREFIX;
+        frame->argument = (uint16_t) synchro_ctx.prefix;
+    }
+    else if ((pulse_width_ms >= SYNCHRO_WIDTH_MS_SEEK_BASE) && (pulse_width_ms <= (SYNCHRO_WIDTH_MS_SEEK_BASE + SYNCHRO_SEEK_ARGUMENT_MAX))) {
+        frame->command = SYNCHRO_COMMAND_SEEK;
+        frame->argument = (uint16_t) prefix;
+        frame->tick = (uint16_t) (pulse_width_ms - SYNCHRO_WIDTH_MS_SEEK_BASE);
+    }
+errors:
+    return status;
+}
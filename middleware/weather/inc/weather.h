@@ -0,0 +1,96 @@
+/*
+ * weather.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __WEATHER_H__
+#define __WEATHER_H__
+
+#include "error.h"
+#include "types.h"
+
+/*** WEATHER structures ***/
+
+/*!******************************************************************
+ * \enum WEATHER_status_t
+ * \brief Weather model error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    WEATHER_SUCCESS = 0,
+    WEATHER_ERROR_NULL_PARAMETER,
+    WEATHER_ERROR_SEED,
+    WEATHER_ERROR_DIRECTION,
+    // Last base value.
+    WEATHER_ERROR_BASE_LAST = ERROR_BASE_STEP
+} WEATHER_status_t;
+
+/*!******************************************************************
+ * \struct WEATHER_configuration_t
+ * \brief Weather model parameters (probabilities are expressed in Q16 format).
+ *******************************************************************/
+typedef struct {
+    uint32_t seed;
+    uint32_t wind_speed_scale_ckmh;
+    uint8_t gust_intensity_q8;
+    uint8_t gust_filter_shift;
+    uint32_t wind_direction_prevailing_degrees;
+    uint8_t wind_direction_step_degrees;
+    uint8_t wind_direction_return_shift;
+    uint16_t rainfall_cluster_start_probability;
+    uint16_t rainfall_cluster_stop_probability;
+    uint16_t rainfall_pulse_probability;
+} WEATHER_configuration_t;
+
+/*!******************************************************************
+ * \struct WEATHER_output_t
+ * \brief Weather model output for one tick.
+ *******************************************************************/
+typedef struct {
+    uint32_t wind_speed_ckmh;
+    uint32_t wind_speed_mean_ckmh;
+    uint32_t wind_direction_degrees;
+    uint8_t rainfall_pulse;
+} WEATHER_output_t;
+
+/*** WEATHER functions ***/
+
+/*!******************************************************************
+ * \fn WEATHER_status_t WEATHER_init(const WEATHER_configuration_t* configuration)
+ * \brief Init stochastic weather model.
+ * \param[in]   configuration: Pointer to the model parameters.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+WEATHER_status_t WEATHER_init(const WEATHER_configuration_t* configuration);
+
+/*!******************************************************************
+ * \fn void WEATHER_new_period(void)
+ * \brief Draw a new Weibull distributed mean wind speed.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void WEATHER_new_period(void);
+
+/*!******************************************************************
+ * \fn WEATHER_status_t WEATHER_process(WEATHER_output_t* output)
+ * \brief Compute next tick values (division-free).
+ * \param[in]   none
+ * \param[out]  output: Pointer to the tick values.
+ * \retval      Function execution status.
+ *******************************************************************/
+WEATHER_status_t WEATHER_process(WEATHER_output_t* output);
+
+/*******************************************************************/
+#define WEATHER_exit_error(base) { ERROR_check_exit(weather_status, WEATHER_SUCCESS, base) }
+
+/*******************************************************************/
+#define WEATHER_stack_error(base) { ERROR_check_stack(weather_status, WEATHER_SUCCESS, base) }
+
+/*******************************************************************/
+#define WEATHER_stack_exit_error(base, code) { ERROR_check_stack_exit(weather_status, WEATHER_SUCCESS, base, code) }
+
+#endif /* __WEATHER_H__ */
@@ -0,0 +1,163 @@
+/*
+ * weather.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "weather.h"
+
+#include "error.h"
+#include "types.h"
+
+/*** WEATHER local macros ***/
+
+#define WEATHER_WEIBULL_TABLE_SIZE          65
+#define WEATHER_WEIBULL_TABLE_SHIFT         10
+#define WEATHER_WEIBULL_Q                   12
+
+#define WEATHER_ANGLE_Q                     8
+#define WEATHER_ANGLE_FULL_SCALE            (MATH_2_PI_DEGREES << WEATHER_ANGLE_Q)
+#define WEATHER_ANGLE_HALF_SCALE            (WEATHER_ANGLE_FULL_SCALE >> 1)
+
+/*** WEATHER local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    WEATHER_configuration_t configuration;
+    uint32_t random_state;
+    uint32_t wind_speed_mean_ckmh;
+    int32_t gust_ckmh;
+    int32_t wind_direction_q8;
+    uint8_t rainfall_cluster;
+} WEATHER_context_t;
+
+/*** WEATHER local global variables ***/
+
+// Weibull (shape k=2) inverse cumulative distribution sqrt(-ln(1-u)) for u=i/64 in Q12 format (last point at u=1-1/512).
+static const uint16_t WEATHER_WEIBULL_TABLE[WEATHER_WEIBULL_TABLE_SIZE] = {
+    0, 514, 730, 897, 1041, 1168, 1285, 1394, 1497, 1595, 1688, 1779, 1866, 1952, 2035, 2117,
+    2197, 2276, 2354, 2431, 2507, 2583, 2658, 2733, 2808, 2883, 2957, 3032, 3107, 3182, 3258, 3334,
+    3410, 3487, 3565, 3644, 3724, 3805, 3888, 3971, 4057, 4144, 4233, 4324, 4418, 4514, 4613, 4716,
+    4823, 4934, 5050, 5171, 5299, 5435, 5581, 5737, 5907, 6093, 6302, 6540, 6820, 7165, 7625, 8353,
+    10230
+};
+
+static WEATHER_context_t weather_ctx;
+
+/*** WEATHER local functions ***/
+
+/*******************************************************************/
+static uint32_t _WEATHER_random(void) {
+    // Xorshift32 generator.
+    weather_ctx.random_state ^= (weather_ctx.random_state << 13);
+    weather_ctx.random_state ^= (weather_ctx.random_state >> 17);
+    weather_ctx.random_state ^= (weather_ctx.random_state << 5);
+    return weather_ctx.random_state;
+}
+
+/*******************************************************************/
+static int32_t _WEATHER_random_signed_q15(void) {
+    // Uniform value in [-32768;32767].
+    return (((int32_t) (_WEATHER_random() >> 16)) - 32768);
+}
+
+/*******************************************************************/
+static uint8_t _WEATHER_bernoulli(uint16_t probability) {
+    // Compare 16 random bits to the Q16 probability.
+    return (((_WEATHER_random() >> 16) < probability) ? 1 : 0);
+}
+
+/*** WEATHER functions ***/
+
+/*******************************************************************/
+WEATHER_status_t WEATHER_init(const WEATHER_configuration_t* configuration) {
+    // Local variables.
+    WEATHER_status_t status = WEATHER_SUCCESS;
+    // Check parameters.
+    if (configuration == NULL) {
+        status = WEATHER_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    if ((configuration->seed) == 0) {
+        status = WEATHER_ERROR_SEED;
+        goto errors;
+    }
+    if ((configuration->wind_direction_prevailing_degrees) >= MATH_2_PI_DEGREES) {
+        status = WEATHER_ERROR_DIRECTION;
+        goto errors;
+    }
+    // Init context.
+    weather_ctx.configuration = (*configuration);
+    weather_ctx.random_state = (configuration->seed);
+    weather_ctx.wind_speed_mean_ckmh = 0;
+    weather_ctx.gust_ckmh = 0;
+    weather_ctx.wind_direction_q8 = (int32_t) ((configuration->wind_direction_prevailing_degrees) << WEATHER_ANGLE_Q);
+    weather_ctx.rainfall_cluster = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+void WEATHER_new_period(void) {
+    // Local variables.
+    uint32_t u = (_WEATHER_random() >> 16);
+    uint32_t idx = (u >> WEATHER_WEIBULL_TABLE_SHIFT);
+    uint32_t fraction = (u & ((0b1 << WEATHER_WEIBULL_TABLE_SHIFT) - 1));
+    uint32_t weibull_q12 = 0;
+    // Linear interpolation of the inverse cumulative distribution.
+    weibull_q12 = WEATHER_WEIBULL_TABLE[idx];
+    weibull_q12 += (((WEATHER_WEIBULL_TABLE[idx + 1] - WEATHER_WEIBULL_TABLE[idx]) * fraction) >> WEATHER_WEIBULL_TABLE_SHIFT);
+    weather_ctx.wind_speed_mean_ckmh = ((weather_ctx.configuration.wind_speed_scale_ckmh * weibull_q12) >> WEATHER_WEIBULL_Q);
+}
+
+/*******************************************************************/
+WEATHER_status_t WEATHER_process(WEATHER_output_t* output) {
+    // Local variables.
+    WEATHER_status_t status = WEATHER_SUCCESS;
+    int32_t noise = 0;
+    int32_t wind_speed_ckmh = 0;
+    int32_t angle_error = 0;
+    // Check parameter.
+    if (output == NULL) {
+        status = WEATHER_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Gust: first order low-pass filtered white noise scaled by the turbulence intensity.
+    noise = ((_WEATHER_random_signed_q15() * ((int32_t) ((weather_ctx.wind_speed_mean_ckmh * weather_ctx.configuration.gust_intensity_q8) >> 8))) >> 13);
+    weather_ctx.gust_ckmh += ((noise - weather_ctx.gust_ckmh) >> weather_ctx.configuration.gust_filter_shift);
+    wind_speed_ckmh = ((int32_t) weather_ctx.wind_speed_mean_ckmh) + weather_ctx.gust_ckmh;
+    if (wind_speed_ckmh < 0) {
+        wind_speed_ckmh = 0;
+    }
+    // Direction: random walk with return to the prevailing heading.
+    angle_error = ((int32_t) (weather_ctx.configuration.wind_direction_prevailing_degrees << WEATHER_ANGLE_Q)) - weather_ctx.wind_direction_q8;
+    if (angle_error >= WEATHER_ANGLE_HALF_SCALE) {
+        angle_error -= WEATHER_ANGLE_FULL_SCALE;
+    }
+    if (angle_error < (-WEATHER_ANGLE_HALF_SCALE)) {
+        angle_error += WEATHER_ANGLE_FULL_SCALE;
+    }
+    weather_ctx.wind_direction_q8 += (angle_error >> weather_ctx.configuration.wind_direction_return_shift);
+    weather_ctx.wind_direction_q8 += ((_WEATHER_random_signed_q15() * weather_ctx.configuration.wind_direction_step_degrees) >> (15 - WEATHER_ANGLE_Q));
+    if (weather_ctx.wind_direction_q8 >= WEATHER_ANGLE_FULL_SCALE) {
+        weather_ctx.wind_direction_q8 -= WEATHER_ANGLE_FULL_SCALE;
+    }
+    if (weather_ctx.wind_direction_q8 < 0) {
+        weather_ctx.wind_direction_q8 += WEATHER_ANGLE_FULL_SCALE;
+    }
+    // Rainfall: clusters of Bernoulli (Poisson limit) pulses.
+    if (weather_ctx.rainfall_cluster == 0) {
+        weather_ctx.rainfall_cluster = _WEATHER_bernoulli(weather_ctx.configuration.rainfall_cluster_start_probability);
+    }
+    else {
+        weather_ctx.rainfall_cluster = (_WEATHER_bernoulli(weather_ctx.configuration.rainfall_cluster_stop_probability) == 0) ? 1 : 0;
+    }
+    // Update output.
+    output->wind_speed_ckmh = (uint32_t) wind_speed_ckmh;
+    output->wind_speed_mean_ckmh = weather_ctx.wind_speed_mean_ckmh;
+    output->wind_direction_degrees = (uint32_t) (weather_ctx.wind_direction_q8 >> WEATHER_ANGLE_Q);
+    output->rainfall_pulse = (weather_ctx.rainfall_cluster != 0) ? _WEATHER_bernoulli(weather_ctx.configuration.rainfall_pulse_probability) : 0;
+errors:
+    return status;
+}
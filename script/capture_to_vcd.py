@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+#
+# capture_to_vcd.py
+#
+#  Created on: 19 oct. 2026
+#      Author: Ludo
+#
+# Convert the waveform segments streamed by the emulator (SEN15901_EMULATOR_MODE_CAPTURE) to a VCD file for GTKWave.
+#
+# Usage: capture_to_vcd.py <terminal_log> <output.vcd>
+#
+# Each "Capture=<timestamp>us;<signal>;<value>" line describes the state of a signal from its timestamp until the next
+# record of the same signal. Timer based outputs are recorded as periods and high durations (in 100us ticks) and are
+# expanded here. Timer registers are preloaded: a new segment actually starts on the next update event after its
+# timestamp, with the phase of the previous pulses, unless the wind timer is restarted ("wind_restart" record) by a new
+# wind period, in which case the pulse in progress is cut and the new segment starts at the restart timestamp.
+
+import re
+import sys
+
+CAPTURE_TICK_US = 100
+CAPTURE_SYNCHRO_PULSE_US = 1000
+CAPTURE_TIMESTAMP_RANGE = (1 << 32)
+
+CAPTURE_SIGNALS = {
+    "wind_speed": 1,
+    "wind_direction": 1,
+    "vane": 8,
+    "rainfall": 1,
+    "synchro": 1,
+}
+
+CAPTURE_LINE = re.compile(r"Capture=(\d+)us;(\w+);(0x)?([0-9A-Fa-f]+)")
+
+
+def parse(log_file_name):
+    records = []
+    offset = 0
+    previous = None
+    with open(log_file_name, "r", errors="ignore") as log_file:
+        for line in log_file:
+            match = CAPTURE_LINE.search(line)
+            if match is None:
+                continue
+            timestamp = int(match.group(1))
+            # Unwrap 32-bits microseconds counter.
+            if (previous is not None) and ((timestamp + offset) < previous):
+                offset += CAPTURE_TIMESTAMP_RANGE
+            previous = (timestamp + offset)
+            records.append((previous, match.group(2), int(match.group(4), 16)))
+    return records
+
+
+def expand_pwm(edges, name, segments, restarts, end):
+    # The timer runs continuously: the phase is carried across segments and the preloaded registers written during a
+    # pulse are only loaded by the next update event, or by a restart of the timer.
+    if not segments:
+        return
+    time = segments[0][0]
+    index = 0
+    restart_index = 0
+    level = None
+    while time < end:
+        # Latest registers written before this update event.
+        while ((index + 1) < len(segments)) and (segments[index + 1][0] <= time):
+            index += 1
+        # Next restart of the timer after the start of this pulse.
+        while (restart_index < len(restarts)) and (restarts[restart_index] <= time):
+            restart_index += 1
+        period = ((segments[index][1] >> 16) * CAPTURE_TICK_US)
+        high = ((segments[index][1] & 0xFFFF) * CAPTURE_TICK_US)
+        if period == 0:
+            # Timer stopped until the next record.
+            if level != 0:
+                edges.append((time, name, 0))
+                level = 0
+            if (index + 1) >= len(segments):
+                return
+            time = segments[index + 1][0]
+            continue
+        if level != (1 if high > 0 else 0):
+            level = (1 if high > 0 else 0)
+            edges.append((time, name, level))
+        # Pulse is cut by a restart of the timer.
+        pulse_end = (time + period)
+        if (restart_index < len(restarts)) and (restarts[restart_index] < pulse_end):
+            pulse_end = restarts[restart_index]
+        if (high > 0) and (high < period) and ((time + high) < pulse_end) and ((time + high) < end):
+            edges.append((time + high, name, 0))
+            level = 0
+        time = pulse_end
+
+
+def expand(records):
+    edges = []
+    end = (records[-1][0] if records else 0)
+    # Timer outputs.
+    restarts = [timestamp for (timestamp, signal, value) in records if signal == "wind_restart"]
+    for name in ["wind_speed", "wind_direction"]:
+        expand_pwm(edges, name, [(timestamp, value) for (timestamp, signal, value) in records if signal == name], restarts, end)
+    # Rainfall pulses and trains.
+    trains = [(timestamp, value) for (timestamp, signal, value) in records if signal == "rainfall_train"]
+    for idx, (timestamp, half_period) in enumerate(trains):
+        if half_period == 0:
+            continue
+        train_end = (trains[idx + 1][0] if (idx + 1) < len(trains) else end)
+        time = timestamp + half_period
+        while time < train_end:
+            edges.append((time, "rainfall", 1))
+            edges.append((time + half_period, "rainfall", 0))
+            time += (2 * half_period)
+    for (timestamp, signal, value) in records:
+        if signal == "rainfall_pulse":
+            delay = ((value >> 16) * CAPTURE_TICK_US)
+            width = ((value & 0xFFFF) * CAPTURE_TICK_US)
+            edges.append((timestamp + delay, "rainfall", 1))
+            edges.append((timestamp + delay + width, "rainfall", 0))
+        elif signal == "vane":
+            edges.append((timestamp, "vane", value))
+        elif signal == "synchro":
+            edges.append((timestamp, "synchro", value))
+    # Rising edge only builds: draw a fixed width marker.
+    synchro_levels = [value for (timestamp, signal, value) in records if signal == "synchro"]
+    if synchro_levels and (0 not in synchro_levels):
+        edges += [(timestamp + CAPTURE_SYNCHRO_PULSE_US, "synchro", 0) for (timestamp, signal, value) in records if signal == "synchro"]
+    edges.sort(key=lambda edge: edge[0])
+    return edges
+
+
+def write_vcd(edges, vcd_file_name):
+    identifiers = {name: chr(ord("!") + idx) for idx, name in enumerate(CAPTURE_SIGNALS)}
+    with open(vcd_file_name, "w") as vcd_file:
+        vcd_file.write("$timescale 1us $end\n")
+        vcd_file.write("$scope module sen15901_emulator $end\n")
+        for name, width in CAPTURE_SIGNALS.items():
+            vcd_file.write("$var wire %d %s %s $end\n" % (width, identifiers[name], name))
+        vcd_file.write("$upscope $end\n$enddefinitions $end\n")
+        vcd_file.write("$dumpvars\n")
+        for name, width in CAPTURE_SIGNALS.items():
+            vcd_file.write(("b0 %s\n" % identifiers[name]) if width > 1 else ("0%s\n" % identifiers[name]))
+        vcd_file.write("$end\n")
+        current_time = None
+        for (time, name, value) in edges:
+            if time != current_time:
+                vcd_file.write("#%d\n" % time)
+                current_time = time
+            if CAPTURE_SIGNALS[name] > 1:
+                vcd_file.write("b%s %s\n" % (format(value, "b"), identifiers[name]))
+            else:
+                vcd_file.write("%d%s\n" % ((1 if value != 0 else 0), identifiers[name]))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        sys.exit("Usage: capture_to_vcd.py <terminal_log> <output.vcd>")
+    write_vcd(expand(parse(sys.argv[1])), sys.argv[2])
@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+#
+# profile_tables.py
+#
+#  Created on: 19 oct. 2026
+#      Author: Ludo
+#
+# Generate the fixed-point shape tables of the wind profiles library (middleware/profile/inc/profile_tables.h).
+#
+# Usage: profile_tables.py <output_header>
+#
+# Each table samples one cycle of a normalized shape (0 to 1 in Q16 format, saturated to 65535) over PROFILE_TABLE_SIZE
+# points, plus a guard point so that the linear interpolation never wraps.
+
+import math
+import sys
+
+PROFILE_TABLE_SIZE = 64
+PROFILE_Q = 16
+PROFILE_FULL_SCALE = ((1 << PROFILE_Q) - 1)
+# Exponential decay covers this number of time constants over one cycle.
+PROFILE_DECAY_TIME_CONSTANTS = 4
+
+PROFILE_SHAPES = [
+    ("SINE", "Sine wave (1 + sin(2.pi.x)) / 2", lambda x: (1.0 + math.sin(2.0 * math.pi * x)) / 2.0),
+    ("GUST_BURST", "Gust burst (1 - cos(2.pi.x)) / 2", lambda x: (1.0 - math.cos(2.0 * math.pi * x)) / 2.0),
+    ("EXPONENTIAL_DECAY", "Exponential decay exp(-%d.x)" % PROFILE_DECAY_TIME_CONSTANTS, lambda x: math.exp(-PROFILE_DECAY_TIME_CONSTANTS * x)),
+]
+
+
+def quantize(value):
+    return min(PROFILE_FULL_SCALE, max(0, int(round(value * (1 << PROFILE_Q)))))
+
+
+def write_table(header_file, name, description, shape):
+    values = [quantize(shape(idx / PROFILE_TABLE_SIZE)) for idx in range(PROFILE_TABLE_SIZE + 1)]
+    header_file.write("// %s for x=i/%d in Q%d format.\n" % (description, PROFILE_TABLE_SIZE, PROFILE_Q))
+    header_file.write("static const uint16_t PROFILE_TABLE_%s[PROFILE_TABLE_SIZE + 1] = {\n" % name)
+    for line in range(0, len(values), 16):
+        header_file.write("    %s%s\n" % (", ".join(str(value) for value in values[line:line + 16]), "," if (line + 16) < len(values) else ""))
+    header_file.write("};\n\n")
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("Usage: profile_tables.py <output_header>")
+    with open(sys.argv[1], "w") as header_file:
+        header_file.write("/*\n * profile_tables.h\n *\n *  Created on: 19 oct. 2026\n *      Author: Ludo\n */\n\n")
+        header_file.write("// Generated by script/profile_tables.py, do not edit. Included by profile.c only.\n\n")
+        header_file.write("#ifndef __PROFILE_TABLES_H__\n#define __PROFILE_TABLES_H__\n\n#include \"types.h\"\n\n")
+        header_file.write("/*** PROFILE tables ***/\n\n")
+        header_file.write("#define PROFILE_TABLE_SIZE          %d\n#define PROFILE_TABLE_SIZE_BITS     %d\n#define PROFILE_Q                   %d\n\n" % (PROFILE_TABLE_SIZE, int(math.log2(PROFILE_TABLE_SIZE)), PROFILE_Q))
+        for (name, description, shape) in PROFILE_SHAPES:
+            write_table(header_file, name, description, shape)
+        header_file.write("#endif /* __PROFILE_TABLES_H__ */\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+#
+# signature_check.py
+#
+#  Created on: 19 oct. 2026
+#      Author: Ludo
+#
+# Compare the per-period outputs signatures printed by the emulator ("Signature=<period>;<crc32>") with golden values.
+#
+# Usage:
+#   signature_check.py record <terminal_log> <golden.json> <configuration>
+#   signature_check.py check <terminal_log> <golden.json> <configuration> <baseline_version>
+#
+# Golden values are recorded per firmware version (first "Version=" line of the log) and per configuration name, which
+# should identify the build flags and the sequencer seed (for example "weather_seed1"). A log is always checked against
+# the given baseline version, so that a new firmware can not silently be compared with its own signatures.
+
+import json
+import os
+import re
+import sys
+
+SIGNATURE_LINE = re.compile(r"Signature=(\d+);(0x)?([0-9A-Fa-f]+)")
+VERSION_LINE = re.compile(r"Version=(\S+)")
+
+
+def parse(log_file_name):
+    version = None
+    signatures = {}
+    with open(log_file_name, "r", errors="ignore") as log_file:
+        for line in log_file:
+            match = VERSION_LINE.search(line)
+            if (match is not None) and (version is None):
+                version = match.group(1)
+            match = SIGNATURE_LINE.search(line)
+            if match is not None:
+                signatures[match.group(1)] = ("0x%08X" % int(match.group(3), 16))
+    if version is None:
+        sys.exit("No firmware version found in %s" % log_file_name)
+    return version, signatures
+
+
+def main():
+    usage = "Usage: signature_check.py record <terminal_log> <golden.json> <configuration>\n" \
+            "       signature_check.py check <terminal_log> <golden.json> <configuration> <baseline_version>"
+    if not (((len(sys.argv) == 5) and (sys.argv[1] == "record")) or ((len(sys.argv) == 6) and (sys.argv[1] == "check"))):
+        sys.exit(usage)
+    command, log_file_name, golden_file_name, configuration = sys.argv[1:5]
+    version, signatures = parse(log_file_name)
+    golden = {}
+    if os.path.exists(golden_file_name):
+        with open(golden_file_name, "r") as golden_file:
+            golden = json.load(golden_file)
+    if command == "check":
+        version = sys.argv[5]
+    key = ("%s/%s" % (version, configuration))
+    if command == "record":
+        golden.setdefault(key, {}).update(signatures)
+        with open(golden_file_name, "w") as golden_file:
+            json.dump(golden, golden_file, indent=4, sort_keys=True)
+        print("%d signatures recorded for %s" % (len(signatures), key))
+        return
+    if key not in golden:
+        sys.exit("No golden signatures for %s" % key)
+    # Report the first differing period.
+    for period in sorted(signatures, key=int):
+        expected = golden[key].get(period)
+        if expected is None:
+            continue
+        if expected != signatures[period]:
+            sys.exit("Period %s: signature %s differs from golden %s" % (period, signatures[period], expected))
+    print("%d signatures match %s" % (len(signatures), key))
+
+
+if __name__ == "__main__":
+    main()
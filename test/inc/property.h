@@ -0,0 +1,90 @@
+/*
+ * property.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __PROPERTY_H__
+#define __PROPERTY_H__
+
+#include "types.h"
+
+/*** PROPERTY macros ***/
+
+#define PROPERTY_CASE_SIZE_MAX      512
+
+/*** PROPERTY structures ***/
+
+/*!******************************************************************
+ * \fn PROPERTY_check_cb_t
+ * \brief Property to check on one case (list of random values interpreted by the test).
+ *******************************************************************/
+typedef uint8_t (*PROPERTY_check_cb_t)(const uint32_t* values, uint32_t size);
+
+/*!******************************************************************
+ * \struct PROPERTY_t
+ * \brief Property descriptor.
+ *******************************************************************/
+typedef struct {
+    const char_t* name;
+    PROPERTY_check_cb_t check;
+    // Cases have 1 to size_max values drawn in [0, value_max].
+    uint32_t size_max;
+    uint32_t value_max;
+    uint32_t case_count;
+} PROPERTY_t;
+
+/*** PROPERTY functions ***/
+
+/*!******************************************************************
+ * \fn void PROPERTY_init(int argc, char_t** argv)
+ * \brief Init the random generator (seed is the first argument of the test, 1 by default).
+ * \param[in]   argc: Number of arguments of the test.
+ * \param[in]   argv: Arguments of the test.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void PROPERTY_init(int argc, char_t** argv);
+
+/*!******************************************************************
+ * \fn uint32_t PROPERTY_random(void)
+ * \brief Draw a 32 bits random value.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Random value.
+ *******************************************************************/
+uint32_t PROPERTY_random(void);
+
+/*!******************************************************************
+ * \fn void PROPERTY_run(const PROPERTY_t* property)
+ * \brief Check a property on random cases and print the shrunk counterexample of the first failure.
+ * \param[in]   property: Pointer to the property to check.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void PROPERTY_run(const PROPERTY_t* property);
+
+/*!******************************************************************
+ * \fn void PROPERTY_fail(const char_t* condition, uint32_t line)
+ * \brief Record the failed condition of the current case.
+ * \param[in]   condition: Failed condition.
+ * \param[in]   line: Source line of the condition.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void PROPERTY_fail(const char_t* condition, uint32_t line);
+
+/*!******************************************************************
+ * \fn int PROPERTY_exit(void)
+ * \brief Print the summary of all properties.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Process exit code (0 if all properties hold).
+ *******************************************************************/
+int PROPERTY_exit(void);
+
+/*******************************************************************/
+#define PROPERTY_check(condition) { if (!(condition)) { PROPERTY_fail(#condition, __LINE__); return 1; } }
+
+#endif /* __PROPERTY_H__ */
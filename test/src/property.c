@@ -0,0 +1,152 @@
+/*
+ * property.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "property.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+
+/*** PROPERTY local macros ***/
+
+#define PROPERTY_SEED_DEFAULT       1
+// Bound of the number of checks run while shrinking a counterexample.
+#define PROPERTY_SHRINK_CHECKS_MAX  200000
+
+/*** PROPERTY local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t seed;
+    uint32_t random_state;
+    uint32_t failure_count;
+    const char_t* condition;
+    uint32_t line;
+    uint32_t shrink_checks;
+} PROPERTY_context_t;
+
+/*** PROPERTY local global variables ***/
+
+static PROPERTY_context_t property_ctx;
+
+/*** PROPERTY local functions ***/
+
+/*******************************************************************/
+static uint8_t _PROPERTY_fails(const PROPERTY_t* property, const uint32_t* values, uint32_t size) {
+    property_ctx.shrink_checks++;
+    return ((property->check(values, size) != 0) ? 1 : 0);
+}
+
+/*******************************************************************/
+static uint32_t _PROPERTY_shrink(const PROPERTY_t* property, uint32_t* values, uint32_t size) {
+    // Local variables.
+    uint32_t candidate[PROPERTY_CASE_SIZE_MAX];
+    uint32_t chunk = 0;
+    uint32_t idx = 0;
+    uint32_t delta = 0;
+    uint8_t progress = 1;
+    property_ctx.shrink_checks = 0;
+    while ((progress != 0) && (property_ctx.shrink_checks < PROPERTY_SHRINK_CHECKS_MAX)) {
+        progress = 0;
+        // Remove chunks of values, largest first.
+        for (chunk = (size >> 1); chunk > 0; chunk >>= 1) {
+            idx = 0;
+            while (((idx + chunk) <= size) && (size > 1)) {
+                memcpy(candidate, values, idx * sizeof(uint32_t));
+                memcpy(&(candidate[idx]), &(values[idx + chunk]), (size - idx - chunk) * sizeof(uint32_t));
+                if (_PROPERTY_fails(property, candidate, (size - chunk)) != 0) {
+                    size -= chunk;
+                    memcpy(values, candidate, size * sizeof(uint32_t));
+                    progress = 1;
+                }
+                else {
+                    idx += chunk;
+                }
+            }
+        }
+        // Move each value towards 0 (largest step first).
+        for (idx = 0; idx < size; idx++) {
+            memcpy(candidate, values, size * sizeof(uint32_t));
+            for (delta = values[idx]; delta > 0; delta >>= 1) {
+                candidate[idx] = (values[idx] - delta);
+                if (_PROPERTY_fails(property, candidate, size) != 0) {
+                    values[idx] = candidate[idx];
+                    progress = 1;
+                    break;
+                }
+            }
+        }
+    }
+    return size;
+}
+
+/*** PROPERTY functions ***/
+
+/*******************************************************************/
+void PROPERTY_init(int argc, char_t** argv) {
+    // Reset context.
+    property_ctx.seed = (argc > 1) ? ((uint32_t) strtoul(argv[1], NULL, 0)) : PROPERTY_SEED_DEFAULT;
+    if (property_ctx.seed == 0) {
+        property_ctx.seed = PROPERTY_SEED_DEFAULT;
+    }
+    property_ctx.random_state = property_ctx.seed;
+    property_ctx.failure_count = 0;
+    property_ctx.condition = NULL;
+    property_ctx.line = 0;
+}
+
+/*******************************************************************/
+uint32_t PROPERTY_random(void) {
+    // Xorshift32.
+    property_ctx.random_state ^= (property_ctx.random_state << 13);
+    property_ctx.random_state ^= (property_ctx.random_state >> 17);
+    property_ctx.random_state ^= (property_ctx.random_state << 5);
+    return property_ctx.random_state;
+}
+
+/*******************************************************************/
+void PROPERTY_run(const PROPERTY_t* property) {
+    // Local variables.
+    uint32_t values[PROPERTY_CASE_SIZE_MAX];
+    uint32_t size = 0;
+    uint32_t case_index = 0;
+    uint32_t size_max = (property->size_max > PROPERTY_CASE_SIZE_MAX) ? PROPERTY_CASE_SIZE_MAX : property->size_max;
+    uint32_t idx = 0;
+    // Cases loop.
+    for (case_index = 0; case_index < property->case_count; case_index++) {
+        size = 1 + (PROPERTY_random() % size_max);
+        for (idx = 0; idx < size; idx++) {
+            values[idx] = (property->value_max == 0xFFFFFFFF) ? PROPERTY_random() : (PROPERTY_random() % (property->value_max + 1));
+        }
+        if (property->check(values, size) == 0) continue;
+        // Shrink the counterexample and record the failure of the minimal case.
+        size = _PROPERTY_shrink(property, values, size);
+        property->check(values, size);
+        printf("FAIL %s (seed %u, case %u): %s (line %u)\r\n", property->name, property_ctx.seed, case_index, property_ctx.condition, property_ctx.line);
+        printf("     minimal case (%u values):", size);
+        for (idx = 0; idx < size; idx++) {
+            printf(" %u", values[idx]);
+        }
+        printf("\r\n");
+        property_ctx.failure_count++;
+        return;
+    }
+    printf("PASS %s (%u cases)\r\n", property->name, property->case_count);
+}
+
+/*******************************************************************/
+void PROPERTY_fail(const char_t* condition, uint32_t line) {
+    property_ctx.condition = condition;
+    property_ctx.line = line;
+}
+
+/*******************************************************************/
+int PROPERTY_exit(void) {
+    printf("%u property(ies) failed (seed %u)\r\n", property_ctx.failure_count, property_ctx.seed);
+    return ((property_ctx.failure_count == 0) ? 0 : 1);
+}
@@ -0,0 +1,151 @@
+/*
+ * test_cluster.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "cluster.h"
+#include "property.h"
+#include "types.h"
+
+/*** TEST CLUSTER local macros ***/
+
+#define TEST_CLUSTER_ASCII_MASK         0x7F
+#define TEST_CLUSTER_TICK_PERIOD_US_MIN 2
+// Offsets are summed on 32 bits, which limits the tick period to 2^31 us.
+#define TEST_CLUSTER_TICK_PERIOD_US_MAX 0x7FFFFFFF
+#define TEST_CLUSTER_SLEW_US_MAX        100000
+
+/*** TEST CLUSTER local functions ***/
+
+/*******************************************************************/
+static uint8_t _TEST_CLUSTER_decode_byte(uint8_t data, CLUSTER_marker_t* marker, uint32_t* marker_count) {
+    // Local variables.
+    CLUSTER_status_t cluster_status = CLUSTER_SUCCESS;
+    cluster_status = CLUSTER_decode(data, marker);
+    PROPERTY_check(cluster_status == CLUSTER_SUCCESS);
+    if (marker->type != CLUSTER_MARKER_TYPE_NONE) {
+        (*marker_count)++;
+    }
+    return 0;
+}
+
+/*******************************************************************/
+static uint8_t _TEST_CLUSTER_markers(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    CLUSTER_status_t cluster_status = CLUSTER_SUCCESS;
+    CLUSTER_marker_t marker;
+    uint8_t bytes[CLUSTER_STEP_MARKER_SIZE_BYTES];
+    uint32_t delay_us = 0;
+    uint32_t step = 0;
+    uint32_t marker_count = 0;
+    uint32_t idx = 0;
+    uint8_t byte_idx = 0;
+    CLUSTER_init();
+    // Markers interleaved with ASCII logs.
+    for (idx = 0; idx < size; idx++) {
+        switch (values[idx] & 0b11) {
+        case 0:
+            // Tick marker is rounded to the delay unit.
+            delay_us = ((values[idx] >> 2) % (CLUSTER_TICK_DELAY_MAX_US + 1));
+            cluster_status = CLUSTER_encode_tick_marker(delay_us, &(bytes[0]));
+            PROPERTY_check(cluster_status == CLUSTER_SUCCESS);
+            PROPERTY_check(bytes[0] > TEST_CLUSTER_ASCII_MASK);
+            marker_count = 0;
+            if (_TEST_CLUSTER_decode_byte(bytes[0], &marker, &marker_count) != 0) return 1;
+            PROPERTY_check(marker_count == 1);
+            PROPERTY_check(marker.type == CLUSTER_MARKER_TYPE_TICK);
+            PROPERTY_check(marker.value == (((delay_us + (CLUSTER_TICK_DELAY_UNIT_US >> 1)) / CLUSTER_TICK_DELAY_UNIT_US) * CLUSTER_TICK_DELAY_UNIT_US));
+            break;
+        case 1:
+            // Step marker is decoded on its last byte only.
+            step = ((values[idx] >> 2) & CLUSTER_STEP_MAX);
+            cluster_status = CLUSTER_encode_step_marker(step, bytes);
+            PROPERTY_check(cluster_status == CLUSTER_SUCCESS);
+            marker_count = 0;
+            for (byte_idx = 0; byte_idx < CLUSTER_STEP_MARKER_SIZE_BYTES; byte_idx++) {
+                PROPERTY_check(bytes[byte_idx] > TEST_CLUSTER_ASCII_MASK);
+                if (_TEST_CLUSTER_decode_byte(bytes[byte_idx], &marker, &marker_count) != 0) return 1;
+            }
+            PROPERTY_check(marker_count == 1);
+            PROPERTY_check(marker.type == CLUSTER_MARKER_TYPE_STEP);
+            PROPERTY_check(marker.value == step);
+            break;
+        default:
+            // Log characters never produce a marker.
+            marker_count = 0;
+            if (_TEST_CLUSTER_decode_byte((uint8_t) ((values[idx] >> 2) & TEST_CLUSTER_ASCII_MASK), &marker, &marker_count) != 0) return 1;
+            PROPERTY_check(marker_count == 0);
+            break;
+        }
+    }
+    // Out of range values are rejected.
+    PROPERTY_check(CLUSTER_encode_tick_marker((CLUSTER_TICK_DELAY_MAX_US + 1), &(bytes[0])) == CLUSTER_ERROR_TICK_DELAY);
+    PROPERTY_check(CLUSTER_encode_step_marker((CLUSTER_STEP_MAX + 1), bytes) == CLUSTER_ERROR_STEP);
+    return 0;
+}
+
+/*******************************************************************/
+static uint8_t _TEST_CLUSTER_phase_error(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    uint32_t tick_period_us = 0;
+    int32_t phase_error_us = 0;
+    int64_t expected_us = 0;
+    if (size < 3) return 0;
+    // Logarithmic distribution of the period to check short periods too.
+    tick_period_us = TEST_CLUSTER_TICK_PERIOD_US_MIN + ((values[0] >> (values[0] & 0x1F)) % (TEST_CLUSTER_TICK_PERIOD_US_MAX - TEST_CLUSTER_TICK_PERIOD_US_MIN + 1));
+    phase_error_us = CLUSTER_get_phase_error_us(values[1], values[2], tick_period_us);
+    // Error is the shortest offset between both ticks: in [-T/2, T/2) and congruent to (offset - age) modulo T.
+    PROPERTY_check((((int64_t) phase_error_us) << 1) >= (-((int64_t) tick_period_us)));
+    PROPERTY_check((((int64_t) phase_error_us) << 1) < ((int64_t) tick_period_us));
+    expected_us = ((((int64_t) values[1]) - ((int64_t) values[2])) - ((int64_t) phase_error_us)) % ((int64_t) tick_period_us);
+    PROPERTY_check(expected_us == 0);
+    return 0;
+}
+
+/*******************************************************************/
+static uint8_t _TEST_CLUSTER_correction(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    volatile int32_t phase_error_us = 0;
+    int32_t initial_us = 0;
+    int32_t correction_us = 0;
+    int64_t sum_us = 0;
+    uint32_t slew_max_us = 0;
+    uint32_t idx = 0;
+    if (size < 2) return 0;
+    initial_us = (int32_t) (values[0] >> 1);
+    initial_us = ((values[0] & 0b1) != 0) ? (-initial_us) : initial_us;
+    phase_error_us = initial_us;
+    // Correction slices are bounded by the slew and sum to the initial error.
+    for (idx = 1; idx < size; idx++) {
+        slew_max_us = (values[idx] % (TEST_CLUSTER_SLEW_US_MAX + 1));
+        correction_us = CLUSTER_get_correction_us(&phase_error_us, slew_max_us);
+        PROPERTY_check((correction_us <= ((int32_t) slew_max_us)) && (correction_us >= (-((int32_t) slew_max_us))));
+        sum_us += correction_us;
+        PROPERTY_check((sum_us + phase_error_us) == initial_us);
+    }
+    return 0;
+}
+
+/*** TEST CLUSTER global variables ***/
+
+static const PROPERTY_t TEST_CLUSTER_PROPERTIES[] = {
+    { "cluster_markers", &_TEST_CLUSTER_markers, 256, 0xFFFFFFFF, 20000 },
+    { "cluster_phase_error", &_TEST_CLUSTER_phase_error, 3, 0xFFFFFFFF, 200000 },
+    { "cluster_correction", &_TEST_CLUSTER_correction, 64, 0xFFFFFFFF, 20000 },
+};
+
+/*** TEST CLUSTER functions ***/
+
+/*******************************************************************/
+int main(int argc, char_t** argv) {
+    // Local variables.
+    uint32_t idx = 0;
+    // Properties loop.
+    PROPERTY_init(argc, argv);
+    for (idx = 0; idx < (sizeof(TEST_CLUSTER_PROPERTIES) / sizeof(PROPERTY_t)); idx++) {
+        PROPERTY_run(&(TEST_CLUSTER_PROPERTIES[idx]));
+    }
+    return PROPERTY_exit();
+}
@@ -0,0 +1,318 @@
+/*
+ * test_cluster_skew.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "cluster.h"
+#include "property.h"
+#include "types.h"
+
+/*** TEST CLUSTER SKEW local macros ***/
+
+// Time is scaled down: 50ms ticks made of 250 sub-ticks (3001ms and 12ms on target).
+#define TEST_CLUSTER_SKEW_TICK_PERIOD_US        50000
+#define TEST_CLUSTER_SKEW_SUBTICK_NUMBER        250
+#define TEST_CLUSTER_SKEW_SUBTICK_PERIOD_US     (TEST_CLUSTER_SKEW_TICK_PERIOD_US / TEST_CLUSTER_SKEW_SUBTICK_NUMBER)
+// Same step and slew thresholds as the simulation.
+#define TEST_CLUSTER_SKEW_PHASE_STEP_SHIFT      4
+#define TEST_CLUSTER_SKEW_SLEW_SHIFT            4
+#define TEST_CLUSTER_SKEW_FOLLOWER_NUMBER       2
+#define TEST_CLUSTER_SKEW_TICK_NUMBER           64
+#define TEST_CLUSTER_SKEW_SETTLING_TICKS        20
+#define TEST_CLUSTER_SKEW_STEP_TICKS            8
+#define TEST_CLUSTER_SKEW_DRIFT_PPM_MAX         500
+#define TEST_CLUSTER_SKEW_LEADER_DELAY_US_MAX   3000
+#define TEST_CLUSTER_SKEW_SKEW_US_MAX           1000
+#define TEST_CLUSTER_SKEW_SCENARIO_NUMBER       2
+
+/*******************************************************************/
+#define TEST_CLUSTER_SKEW_check(condition) { if (!(condition)) { printf("FAIL cluster_skew: %s (line %u)\r\n", #condition, __LINE__); return 1; } }
+
+/*** TEST CLUSTER SKEW local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    int master_fd;
+    int slave_fd;
+    int result_fd;
+    pid_t pid;
+    // Local oscillator error of the board.
+    int32_t drift_ppm;
+    uint32_t initial_offset_us;
+    // Results.
+    uint32_t skew_max_us;
+    uint32_t tick_count;
+    uint32_t step_count;
+    uint32_t step_error_count;
+    uint32_t last_step;
+} TEST_CLUSTER_SKEW_follower_t;
+
+/*******************************************************************/
+typedef struct {
+    uint64_t start_us;
+    uint32_t delay_seed;
+    TEST_CLUSTER_SKEW_follower_t followers[TEST_CLUSTER_SKEW_FOLLOWER_NUMBER];
+} TEST_CLUSTER_SKEW_context_t;
+
+/*** TEST CLUSTER SKEW local global variables ***/
+
+static TEST_CLUSTER_SKEW_context_t test_cluster_skew_ctx;
+
+/*** TEST CLUSTER SKEW local functions ***/
+
+/*******************************************************************/
+static uint64_t _TEST_CLUSTER_SKEW_get_time_us(void) {
+    // Local variables.
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((((uint64_t) now.tv_sec) * 1000000) + (((uint64_t) now.tv_nsec) / 1000));
+}
+
+/*******************************************************************/
+static void _TEST_CLUSTER_SKEW_sleep_until_us(uint64_t time_us) {
+    // Local variables.
+    struct timespec deadline;
+    deadline.tv_sec = (time_t) (time_us / 1000000);
+    deadline.tv_nsec = (long) ((time_us % 1000000) * 1000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) != 0);
+}
+
+/*******************************************************************/
+static void _TEST_CLUSTER_SKEW_write(const uint8_t* data, uint32_t size) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Same bytes on the log line of all followers.
+    for (idx = 0; idx < TEST_CLUSTER_SKEW_FOLLOWER_NUMBER; idx++) {
+        if (write(test_cluster_skew_ctx.followers[idx].master_fd, data, size) != ((ssize_t) size)) {
+            printf("Leader write error\r\n");
+        }
+    }
+}
+
+/*******************************************************************/
+static void _TEST_CLUSTER_SKEW_leader(void) {
+    // Local variables.
+    uint8_t step_marker[CLUSTER_STEP_MARKER_SIZE_BYTES];
+    uint8_t tick_marker = 0;
+    char_t log[32];
+    uint64_t tick_us = 0;
+    uint32_t delay_us = 0;
+    uint32_t random_state = test_cluster_skew_ctx.delay_seed;
+    uint32_t tick_count = 0;
+    int log_size = 0;
+    // Leader ticks are the time reference.
+    for (tick_count = 1; tick_count <= TEST_CLUSTER_SKEW_TICK_NUMBER; tick_count++) {
+        tick_us = test_cluster_skew_ctx.start_us + (((uint64_t) tick_count) * TEST_CLUSTER_SKEW_TICK_PERIOD_US);
+        // Random main loop latency before the marker transmission.
+        random_state = (random_state * 1103515245) + 12345;
+        _TEST_CLUSTER_SKEW_sleep_until_us(tick_us + ((random_state >> 8) % TEST_CLUSTER_SKEW_LEADER_DELAY_US_MAX));
+        delay_us = (uint32_t) (_TEST_CLUSTER_SKEW_get_time_us() - tick_us);
+        // Late markers are dropped as on target.
+        if (CLUSTER_encode_tick_marker(delay_us, &tick_marker) == CLUSTER_SUCCESS) {
+            _TEST_CLUSTER_SKEW_write(&tick_marker, 1);
+        }
+        // Step markers and ASCII logs share the line.
+        if ((tick_count % TEST_CLUSTER_SKEW_STEP_TICKS) == 0) {
+            CLUSTER_encode_step_marker((tick_count / TEST_CLUSTER_SKEW_STEP_TICKS), step_marker);
+            _TEST_CLUSTER_SKEW_write(step_marker, CLUSTER_STEP_MARKER_SIZE_BYTES);
+        }
+        log_size = snprintf(log, sizeof(log), "Tick=%u\r\n", tick_count);
+        _TEST_CLUSTER_SKEW_write((const uint8_t*) log, (uint32_t) log_size);
+    }
+}
+
+/*******************************************************************/
+static uint64_t _TEST_CLUSTER_SKEW_local_to_real_us(TEST_CLUSTER_SKEW_follower_t* follower, int64_t local_us) {
+    // Local oscillator runs (1 + drift) times faster than the leader one.
+    return (uint64_t) (((int64_t) test_cluster_skew_ctx.start_us) + ((int64_t) ((((double) local_us) * 1000000.0) / (1000000.0 + ((double) follower->drift_ppm)))));
+}
+
+/*******************************************************************/
+static int64_t _TEST_CLUSTER_SKEW_real_to_local_us(TEST_CLUSTER_SKEW_follower_t* follower, uint64_t real_us) {
+    return (int64_t) ((((double) (((int64_t) real_us) - ((int64_t) test_cluster_skew_ctx.start_us))) * (1000000.0 + ((double) follower->drift_ppm))) / 1000000.0);
+}
+
+/*******************************************************************/
+static void _TEST_CLUSTER_SKEW_follower(TEST_CLUSTER_SKEW_follower_t* follower) {
+    // Local variables.
+    CLUSTER_marker_t marker;
+    struct pollfd poll_fd;
+    struct timespec timeout;
+    volatile int32_t phase_error_us = 0;
+    int64_t tick_local_us = 0;
+    int64_t deadline_local_us = 0;
+    int64_t now_local_us = 0;
+    uint64_t deadline_us = 0;
+    uint64_t now_us = 0;
+    uint32_t subtick_count = 0;
+    uint32_t tick_offset_us = 0;
+    uint32_t marker_age_us = 0;
+    int32_t correction_us = 0;
+    int32_t error_us = 0;
+    int32_t skew_us = 0;
+    uint8_t locked = 0;
+    uint8_t data = 0;
+    // Free running tick with a random initial phase.
+    CLUSTER_init();
+    tick_local_us = (-((int64_t) follower->initial_offset_us));
+    deadline_local_us = tick_local_us + TEST_CLUSTER_SKEW_SUBTICK_PERIOD_US;
+    poll_fd.fd = follower->slave_fd;
+    poll_fd.events = POLLIN;
+    while (follower->tick_count < TEST_CLUSTER_SKEW_TICK_NUMBER) {
+        // Wait for the next sub-tick timer interrupt or a log byte.
+        deadline_us = _TEST_CLUSTER_SKEW_local_to_real_us(follower, deadline_local_us);
+        now_us = _TEST_CLUSTER_SKEW_get_time_us();
+        timeout.tv_sec = 0;
+        timeout.tv_nsec = (deadline_us > now_us) ? ((long) ((deadline_us - now_us) * 1000)) : 0;
+        if ((timeout.tv_nsec != 0) && (ppoll(&poll_fd, 1, &timeout, NULL) > 0)) {
+            if (read(follower->slave_fd, &data, 1) != 1) continue;
+            now_local_us = _TEST_CLUSTER_SKEW_real_to_local_us(follower, _TEST_CLUSTER_SKEW_get_time_us());
+            tick_offset_us = (uint32_t) (now_local_us - tick_local_us);
+            CLUSTER_decode(data, &marker);
+            if (marker.type == CLUSTER_MARKER_TYPE_TICK) {
+                // Same discipline as the simulation log RX callback.
+                marker_age_us = marker.value;
+                error_us = CLUSTER_get_phase_error_us(tick_offset_us, marker_age_us, TEST_CLUSTER_SKEW_TICK_PERIOD_US);
+                if ((locked == 0) || (((uint32_t) abs(error_us)) > (TEST_CLUSTER_SKEW_TICK_PERIOD_US >> TEST_CLUSTER_SKEW_PHASE_STEP_SHIFT))) {
+                    // Step the tick phase.
+                    tick_local_us = now_local_us - marker_age_us;
+                    subtick_count = (marker_age_us / TEST_CLUSTER_SKEW_SUBTICK_PERIOD_US);
+                    deadline_local_us = tick_local_us + (((int64_t) (subtick_count + 1)) * TEST_CLUSTER_SKEW_SUBTICK_PERIOD_US);
+                    phase_error_us = 0;
+                    locked = 1;
+                }
+                else {
+                    phase_error_us = error_us;
+                }
+            }
+            if (marker.type == CLUSTER_MARKER_TYPE_STEP) {
+                follower->step_count++;
+                // Steps are received once and in order.
+                if (marker.value != (follower->last_step + 1)) {
+                    follower->step_error_count++;
+                }
+                follower->last_step = marker.value;
+            }
+            continue;
+        }
+        // Sub-tick timer interrupt: spread the phase correction over the next periods.
+        correction_us = CLUSTER_get_correction_us(&phase_error_us, (TEST_CLUSTER_SKEW_SUBTICK_PERIOD_US >> TEST_CLUSTER_SKEW_SLEW_SHIFT));
+        subtick_count++;
+        if (subtick_count >= TEST_CLUSTER_SKEW_SUBTICK_NUMBER) {
+            subtick_count = 0;
+            tick_local_us = deadline_local_us;
+            // Skew with the closest leader tick, once settled.
+            if (locked != 0) {
+                follower->tick_count++;
+            }
+            if (follower->tick_count > TEST_CLUSTER_SKEW_SETTLING_TICKS) {
+                skew_us = CLUSTER_get_phase_error_us((uint32_t) (_TEST_CLUSTER_SKEW_local_to_real_us(follower, tick_local_us) - test_cluster_skew_ctx.start_us), 0, TEST_CLUSTER_SKEW_TICK_PERIOD_US);
+                if (((uint32_t) abs(skew_us)) > follower->skew_max_us) {
+                    follower->skew_max_us = (uint32_t) abs(skew_us);
+                }
+            }
+        }
+        deadline_local_us += (TEST_CLUSTER_SKEW_SUBTICK_PERIOD_US + correction_us);
+    }
+}
+
+/*******************************************************************/
+static uint8_t _TEST_CLUSTER_SKEW_open(TEST_CLUSTER_SKEW_follower_t* follower) {
+    // Local variables.
+    struct termios attributes;
+    // Pseudo-terminal stands for the log UART link between the leader and the follower.
+    follower->master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    TEST_CLUSTER_SKEW_check(follower->master_fd >= 0);
+    TEST_CLUSTER_SKEW_check(grantpt(follower->master_fd) == 0);
+    TEST_CLUSTER_SKEW_check(unlockpt(follower->master_fd) == 0);
+    follower->slave_fd = open(ptsname(follower->master_fd), (O_RDWR | O_NOCTTY));
+    TEST_CLUSTER_SKEW_check(follower->slave_fd >= 0);
+    // Raw bytes (markers are not ASCII).
+    TEST_CLUSTER_SKEW_check(tcgetattr(follower->slave_fd, &attributes) == 0);
+    cfmakeraw(&attributes);
+    TEST_CLUSTER_SKEW_check(tcsetattr(follower->slave_fd, TCSANOW, &attributes) == 0);
+    return 0;
+}
+
+/*******************************************************************/
+static uint8_t _TEST_CLUSTER_SKEW_run(uint32_t scenario) {
+    // Local variables.
+    TEST_CLUSTER_SKEW_follower_t* follower = NULL;
+    pid_t pid = 0;
+    int pipe_fd[2];
+    int result_fd = 0;
+    int wait_status = 0;
+    uint8_t idx = 0;
+    // Random oscillator errors and initial phases.
+    test_cluster_skew_ctx.delay_seed = PROPERTY_random();
+    for (idx = 0; idx < TEST_CLUSTER_SKEW_FOLLOWER_NUMBER; idx++) {
+        follower = &(test_cluster_skew_ctx.followers[idx]);
+        if (_TEST_CLUSTER_SKEW_open(follower) != 0) return 1;
+        follower->drift_ppm = ((int32_t) (PROPERTY_random() % ((2 * TEST_CLUSTER_SKEW_DRIFT_PPM_MAX) + 1))) - TEST_CLUSTER_SKEW_DRIFT_PPM_MAX;
+        follower->initial_offset_us = (PROPERTY_random() % TEST_CLUSTER_SKEW_TICK_PERIOD_US);
+        follower->skew_max_us = 0;
+        follower->tick_count = 0;
+        follower->step_count = 0;
+        follower->step_error_count = 0;
+        follower->last_step = 0;
+    }
+    test_cluster_skew_ctx.start_us = _TEST_CLUSTER_SKEW_get_time_us() + TEST_CLUSTER_SKEW_TICK_PERIOD_US;
+    // Each follower board is a process (own cluster decoder), results are sent back through a pipe.
+    for (idx = 0; idx < TEST_CLUSTER_SKEW_FOLLOWER_NUMBER; idx++) {
+        follower = &(test_cluster_skew_ctx.followers[idx]);
+        TEST_CLUSTER_SKEW_check(pipe(pipe_fd) == 0);
+        follower->pid = fork();
+        TEST_CLUSTER_SKEW_check(follower->pid >= 0);
+        if (follower->pid == 0) {
+            close(pipe_fd[0]);
+            _TEST_CLUSTER_SKEW_follower(follower);
+            _exit((write(pipe_fd[1], follower, sizeof(TEST_CLUSTER_SKEW_follower_t)) == ((ssize_t) sizeof(TEST_CLUSTER_SKEW_follower_t))) ? 0 : 1);
+        }
+        close(pipe_fd[1]);
+        follower->result_fd = pipe_fd[0];
+    }
+    _TEST_CLUSTER_SKEW_leader();
+    // Print the achieved skew of each follower.
+    for (idx = 0; idx < TEST_CLUSTER_SKEW_FOLLOWER_NUMBER; idx++) {
+        follower = &(test_cluster_skew_ctx.followers[idx]);
+        pid = follower->pid;
+        result_fd = follower->result_fd;
+        TEST_CLUSTER_SKEW_check(read(result_fd, follower, sizeof(TEST_CLUSTER_SKEW_follower_t)) == ((ssize_t) sizeof(TEST_CLUSTER_SKEW_follower_t)));
+        TEST_CLUSTER_SKEW_check(waitpid(pid, &wait_status, 0) == pid);
+        close(result_fd);
+        close(follower->slave_fd);
+        close(follower->master_fd);
+        printf("Scenario=%u;follower=%u;drift=%dppm;initial_offset=%uus;Cluster_skew_max=%uus;steps=%u\r\n", scenario, idx, follower->drift_ppm, follower->initial_offset_us, follower->skew_max_us, follower->step_count);
+        TEST_CLUSTER_SKEW_check(follower->skew_max_us < TEST_CLUSTER_SKEW_SKEW_US_MAX);
+        TEST_CLUSTER_SKEW_check(follower->step_count == (TEST_CLUSTER_SKEW_TICK_NUMBER / TEST_CLUSTER_SKEW_STEP_TICKS));
+        TEST_CLUSTER_SKEW_check(follower->step_error_count == 0);
+    }
+    return 0;
+}
+
+/*** TEST CLUSTER SKEW functions ***/
+
+/*******************************************************************/
+int main(int argc, char_t** argv) {
+    // Local variables.
+    uint32_t scenario = 0;
+    uint32_t failure_count = 0;
+    // Real time scenarios are not shrunk, the seed gives the oscillator errors and initial phases.
+    PROPERTY_init(argc, argv);
+    for (scenario = 0; scenario < TEST_CLUSTER_SKEW_SCENARIO_NUMBER; scenario++) {
+        failure_count += _TEST_CLUSTER_SKEW_run(scenario);
+    }
+    printf("%u scenario(s) failed\r\n", failure_count);
+    return ((failure_count == 0) ? 0 : 1);
+}
@@ -0,0 +1,142 @@
+/*
+ * test_event_queue.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include <pthread.h>
+#include "event_queue.h"
+#include "property.h"
+#include "types.h"
+
+/*** TEST EVENT QUEUE local macros ***/
+
+#define TEST_EVENT_QUEUE_THREAD_EVENTS_MIN  10000
+#define TEST_EVENT_QUEUE_THREAD_EVENTS_MAX  200000
+
+/*** TEST EVENT QUEUE local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    EVENT_QUEUE_t queue;
+    uint32_t event_count;
+    uint32_t pushed_count;
+    volatile uint8_t done;
+} TEST_EVENT_QUEUE_producer_t;
+
+/*** TEST EVENT QUEUE local functions ***/
+
+/*******************************************************************/
+static uint8_t _TEST_EVENT_QUEUE_model(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    EVENT_QUEUE_status_t event_queue_status = EVENT_QUEUE_SUCCESS;
+    EVENT_QUEUE_t queue;
+    EVENT_QUEUE_event_t event;
+    uint32_t model[PROPERTY_CASE_SIZE_MAX];
+    uint32_t model_write = 0;
+    uint32_t model_read = 0;
+    uint32_t overflow_count = 0;
+    uint32_t idx = 0;
+    PROPERTY_check(EVENT_QUEUE_init(&queue) == EVENT_QUEUE_SUCCESS);
+    // Random interleaving of interrupts (push) and main loop iterations (pop).
+    for (idx = 0; idx < size; idx++) {
+        if ((values[idx] & 0b1) != 0) {
+            event_queue_status = EVENT_QUEUE_push(&queue, idx, values[idx]);
+            if ((model_write - model_read) >= EVENT_QUEUE_DEPTH) {
+                // Full queue drops the new event and counts it.
+                PROPERTY_check(event_queue_status == EVENT_QUEUE_ERROR_FULL);
+                overflow_count++;
+            }
+            else {
+                PROPERTY_check(event_queue_status == EVENT_QUEUE_SUCCESS);
+                model[model_write++] = idx;
+            }
+        }
+        else {
+            event_queue_status = EVENT_QUEUE_pop(&queue, &event);
+            if (model_read == model_write) {
+                PROPERTY_check(event_queue_status == EVENT_QUEUE_ERROR_EMPTY);
+            }
+            else {
+                // Events are kept in order with their timestamp and data.
+                PROPERTY_check(event_queue_status == EVENT_QUEUE_SUCCESS);
+                PROPERTY_check(event.timestamp_ms == model[model_read]);
+                PROPERTY_check(event.data == values[model[model_read]]);
+                model_read++;
+            }
+        }
+        PROPERTY_check(EVENT_QUEUE_get_overflow_count(&queue) == overflow_count);
+    }
+    return 0;
+}
+
+/*******************************************************************/
+static void* _TEST_EVENT_QUEUE_producer(void* argument) {
+    // Local variables.
+    TEST_EVENT_QUEUE_producer_t* producer = (TEST_EVENT_QUEUE_producer_t*) argument;
+    uint32_t idx = 0;
+    // Interrupt side: sequence number as timestamp, its complement as data.
+    for (idx = 0; idx < producer->event_count; idx++) {
+        if (EVENT_QUEUE_push(&(producer->queue), idx, ~idx) == EVENT_QUEUE_SUCCESS) {
+            producer->pushed_count++;
+        }
+    }
+    __atomic_store_n(&(producer->done), 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+/*******************************************************************/
+static uint8_t _TEST_EVENT_QUEUE_threads(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    static TEST_EVENT_QUEUE_producer_t producer;
+    pthread_t thread;
+    EVENT_QUEUE_event_t event;
+    uint32_t popped_count = 0;
+    uint32_t next_min = 0;
+    uint8_t done = 0;
+    uint8_t valid = 1;
+    UNUSED(size);
+    PROPERTY_check(EVENT_QUEUE_init(&(producer.queue)) == EVENT_QUEUE_SUCCESS);
+    producer.event_count = TEST_EVENT_QUEUE_THREAD_EVENTS_MIN + (values[0] % (TEST_EVENT_QUEUE_THREAD_EVENTS_MAX - TEST_EVENT_QUEUE_THREAD_EVENTS_MIN + 1));
+    producer.pushed_count = 0;
+    producer.done = 0;
+    PROPERTY_check(pthread_create(&thread, NULL, &_TEST_EVENT_QUEUE_producer, &producer) == 0);
+    // Main loop side: events are received complete, once and in order.
+    do {
+        done = __atomic_load_n(&(producer.done), __ATOMIC_ACQUIRE);
+        while ((valid != 0) && (EVENT_QUEUE_pop(&(producer.queue), &event) == EVENT_QUEUE_SUCCESS)) {
+            valid = ((event.data == (~event.timestamp_ms)) && (event.timestamp_ms >= next_min)) ? 1 : 0;
+            next_min = (event.timestamp_ms + 1);
+            popped_count++;
+        }
+    }
+    while ((done == 0) && (valid != 0));
+    PROPERTY_check(pthread_join(thread, NULL) == 0);
+    PROPERTY_check(valid != 0);
+    // Every event is either received or counted as overflow.
+    PROPERTY_check(popped_count == producer.pushed_count);
+    PROPERTY_check((popped_count + EVENT_QUEUE_get_overflow_count(&(producer.queue))) == producer.event_count);
+    return 0;
+}
+
+/*** TEST EVENT QUEUE global variables ***/
+
+static const PROPERTY_t TEST_EVENT_QUEUE_PROPERTIES[] = {
+    { "event_queue_model", &_TEST_EVENT_QUEUE_model, 512, 0xFFFFFFFF, 20000 },
+    { "event_queue_threads", &_TEST_EVENT_QUEUE_threads, 1, 0xFFFFFFFF, 50 },
+};
+
+/*** TEST EVENT QUEUE functions ***/
+
+/*******************************************************************/
+int main(int argc, char_t** argv) {
+    // Local variables.
+    uint32_t idx = 0;
+    // Properties loop.
+    PROPERTY_init(argc, argv);
+    for (idx = 0; idx < (sizeof(TEST_EVENT_QUEUE_PROPERTIES) / sizeof(PROPERTY_t)); idx++) {
+        PROPERTY_run(&(TEST_EVENT_QUEUE_PROPERTIES[idx]));
+    }
+    return PROPERTY_exit();
+}
@@ -0,0 +1,100 @@
+/*
+ * test_profile.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "profile.h"
+#include "property.h"
+#include "types.h"
+
+/*** TEST PROFILE local macros ***/
+
+#define TEST_PROFILE_BASE_CKMH_MAX      20000
+#define TEST_PROFILE_DELAY_TICKS_MAX    64
+#define TEST_PROFILE_PERIOD_TICKS_MAX   1000
+#define TEST_PROFILE_SEEK_TICKS_MAX     4000
+
+/*** TEST PROFILE local functions ***/
+
+/*******************************************************************/
+static void _TEST_PROFILE_get_configuration(const uint32_t* values, PROFILE_configuration_t* configuration) {
+    configuration->type = (PROFILE_type_t) (values[0] % PROFILE_TYPE_LAST);
+    configuration->base_ckmh = (values[1] % (TEST_PROFILE_BASE_CKMH_MAX + 1));
+    configuration->amplitude_ckmh = ((values[1] >> 16) % (PROFILE_AMPLITUDE_CKMH_MAX + 1));
+    configuration->delay_ticks = (values[2] % (TEST_PROFILE_DELAY_TICKS_MAX + 1));
+    // Period is not used by the step profile (may be 0).
+    configuration->period_ticks = ((values[2] >> 8) % (TEST_PROFILE_PERIOD_TICKS_MAX + 1));
+    if ((configuration->type != PROFILE_TYPE_STEP) && (configuration->period_ticks == 0)) {
+        configuration->period_ticks = 1;
+    }
+    configuration->duty_q8 = (uint8_t) (values[0] >> 24);
+}
+
+/*******************************************************************/
+static uint8_t _TEST_PROFILE_seek(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    PROFILE_configuration_t configuration;
+    uint32_t seek_ticks = 0;
+    uint32_t played_ckmh = 0;
+    uint32_t sought_ckmh = 0;
+    uint32_t idx = 0;
+    if (size < 4) return 0;
+    _TEST_PROFILE_get_configuration(values, &configuration);
+    seek_ticks = (values[3] % (TEST_PROFILE_SEEK_TICKS_MAX + 1));
+    // Play the profile tick by tick.
+    PROPERTY_check(PROFILE_start(&configuration) == PROFILE_SUCCESS);
+    for (idx = 0; idx <= seek_ticks; idx++) {
+        PROPERTY_check(PROFILE_process(&played_ckmh) == PROFILE_SUCCESS);
+    }
+    // Seeking gives the same output than playing the skipped ticks.
+    PROPERTY_check(PROFILE_start(&configuration) == PROFILE_SUCCESS);
+    PROFILE_seek(seek_ticks);
+    PROPERTY_check(PROFILE_process(&sought_ckmh) == PROFILE_SUCCESS);
+    PROPERTY_check(sought_ckmh == played_ckmh);
+    return 0;
+}
+
+/*******************************************************************/
+static uint8_t _TEST_PROFILE_bounds(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    PROFILE_configuration_t configuration;
+    uint32_t wind_speed_ckmh = 0;
+    uint32_t idx = 0;
+    if (size < 3) return 0;
+    _TEST_PROFILE_get_configuration(values, &configuration);
+    PROPERTY_check(PROFILE_start(&configuration) == PROFILE_SUCCESS);
+    // Output stays within [base, base + amplitude].
+    for (idx = 0; idx < (2 * (configuration.delay_ticks + configuration.period_ticks)); idx++) {
+        PROPERTY_check(PROFILE_process(&wind_speed_ckmh) == PROFILE_SUCCESS);
+        PROPERTY_check(wind_speed_ckmh >= configuration.base_ckmh);
+        PROPERTY_check(wind_speed_ckmh <= (configuration.base_ckmh + configuration.amplitude_ckmh));
+        // Base wind speed during the delay.
+        if (idx < configuration.delay_ticks) {
+            PROPERTY_check(wind_speed_ckmh == configuration.base_ckmh);
+        }
+    }
+    return 0;
+}
+
+/*** TEST PROFILE global variables ***/
+
+static const PROPERTY_t TEST_PROFILE_PROPERTIES[] = {
+    { "profile_seek", &_TEST_PROFILE_seek, 4, 0xFFFFFFFF, 20000 },
+    { "profile_bounds", &_TEST_PROFILE_bounds, 3, 0xFFFFFFFF, 5000 },
+};
+
+/*** TEST PROFILE functions ***/
+
+/*******************************************************************/
+int main(int argc, char_t** argv) {
+    // Local variables.
+    uint32_t idx = 0;
+    // Properties loop.
+    PROPERTY_init(argc, argv);
+    for (idx = 0; idx < (sizeof(TEST_PROFILE_PROPERTIES) / sizeof(PROPERTY_t)); idx++) {
+        PROPERTY_run(&(TEST_PROFILE_PROPERTIES[idx]));
+    }
+    return PROPERTY_exit();
+}
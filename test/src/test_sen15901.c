@@ -0,0 +1,276 @@
+/*
+ * test_sen15901.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include <string.h>
+#include "gpio_registers.h"
+#include "property.h"
+#include "sen15901.h"
+#include "tim_registers.h"
+#include "types.h"
+
+/*** TEST SEN15901 local macros ***/
+
+#define TEST_SEN15901_TIM_CLOCK_HZ              16000000
+#define TEST_SEN15901_TIM_CYCLES_PER_US         (TEST_SEN15901_TIM_CLOCK_HZ / 1000000)
+#define TEST_SEN15901_TIM_CR1_UDIS              (0b1 << 1)
+#define TEST_SEN15901_TIM_EGR_UG                (0b1 << 0)
+// Divided clock is selected so that the period is at least half of the 16-bits ARR.
+#define TEST_SEN15901_WIND_PERIOD_MIN_DIVIDED   32768
+// Sub-tick periods of the classic (12ms) and Ultimeter (24ms) ticks bound the rotation steps.
+#define TEST_SEN15901_ROTATION_STEP_US_MIN      12000
+#define TEST_SEN15901_ROTATION_STEP_US_MAX      24004
+#define TEST_SEN15901_MDEG_FULL_SCALE           360000
+#define TEST_SEN15901_WIND_SPEED_CKMH_MIN       100
+#define TEST_SEN15901_WIND_SPEED_CKMH_MAX       30000
+#define TEST_SEN15901_ERROR_PPM_TOLERANCE       2.0
+
+/*** TEST SEN15901 local functions ***/
+
+/*******************************************************************/
+static void _TEST_SEN15901_init(uint32_t personality) {
+    // Reset host registers.
+    memset(&HOST_GPIOA, 0, sizeof(HOST_GPIOA));
+    memset(&HOST_GPIOB, 0, sizeof(HOST_GPIOB));
+    memset(&HOST_TIM22, 0, sizeof(HOST_TIM22));
+    SEN15901_init((SEN15901_personality_t) (personality % SEN15901_PERSONALITY_LAST));
+}
+
+/*******************************************************************/
+static void _TEST_SEN15901_commit(void) {
+    SEN15901_commit_cb_t commit = SEN15901_get_commit_callback();
+    commit();
+}
+
+/*******************************************************************/
+static uint8_t _TEST_SEN15901_check_vane(void) {
+    // Local variables.
+    uint32_t set_mask = 0;
+    uint32_t reset_mask = 0;
+    uint32_t rotated_mask = 0;
+    uint32_t count = 0;
+    uint8_t idx = 0;
+    // Vane resistors are driven by the classic output only.
+    if (SEN15901_get_personality() == SEN15901_PERSONALITY_ULTIMETER) return 0;
+    // Nothing written yet.
+    if ((HOST_GPIOA.BSRR == 0) && (HOST_GPIOB.BSRR == 0)) return 0;
+    // Resistors are PA3-PA7 and PB0-PB2.
+    set_mask = (((HOST_GPIOA.BSRR >> 3) & 0x1F) | ((HOST_GPIOB.BSRR & 0x07) << 5));
+    reset_mask = (((HOST_GPIOA.BSRR >> 19) & 0x1F) | (((HOST_GPIOB.BSRR >> 16) & 0x07) << 5));
+    // Each resistor is either set or reset by the atomic port write.
+    PROPERTY_check((set_mask ^ reset_mask) == 0xFF);
+    for (idx = 0; idx < 8; idx++) {
+        count += ((set_mask >> idx) & 0b1);
+    }
+    // One resistor or two adjacent resistors (circular).
+    rotated_mask = (((set_mask >> 1) | (set_mask << 7)) & 0xFF);
+    PROPERTY_check((count == 1) || ((count == 2) && ((set_mask & rotated_mask) != 0)));
+    return 0;
+}
+
+/*******************************************************************/
+static uint8_t _TEST_SEN15901_vane_combinations(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    uint32_t idx = 0;
+    uint32_t argument = 0;
+    // Personality is given by the first value.
+    _TEST_SEN15901_init(values[0]);
+    PROPERTY_check(SEN15901_check_wind_direction() == SEN15901_SUCCESS);
+    // Events sequence.
+    for (idx = 1; idx < size; idx++) {
+        argument = (values[idx] >> 2);
+        switch (values[idx] & 0b11) {
+        case 0:
+            PROPERTY_check(SEN15901_set_wind_direction(argument % 360) == SEN15901_SUCCESS);
+            break;
+        case 1:
+            PROPERTY_check(SEN15901_set_wind_direction_target((argument % 360), (1 + ((argument >> 9) % SEN15901_WIND_DIRECTION_VELOCITY_DPS_MAX))) == SEN15901_SUCCESS);
+            break;
+        case 2:
+            SEN15901_rotate_wind_direction(argument % (TEST_SEN15901_ROTATION_STEP_US_MAX + 1));
+            break;
+        default:
+            _TEST_SEN15901_commit();
+            break;
+        }
+        if (_TEST_SEN15901_check_vane() != 0) return 1;
+    }
+    return 0;
+}
+
+/*******************************************************************/
+static uint8_t _TEST_SEN15901_rotation(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    uint32_t start_degrees = (values[0] % 360);
+    uint32_t target_degrees = 0;
+    uint32_t velocity_dps = 0;
+    uint32_t distance_mdeg = 0;
+    uint32_t covered_mdeg = 0;
+    uint32_t elapsed_us = 0;
+    uint32_t gpioa_bsrr = 0;
+    uint32_t gpiob_bsrr = 0;
+    uint32_t idx = 0;
+    if (size < 3) return 0;
+    target_degrees = (values[1] % 360);
+    velocity_dps = (1 + (values[2] % SEN15901_WIND_DIRECTION_VELOCITY_DPS_MAX));
+    // Shortest distance between both directions.
+    distance_mdeg = (((target_degrees + 360 - start_degrees) % 360) * 1000);
+    if (distance_mdeg > (TEST_SEN15901_MDEG_FULL_SCALE >> 1)) {
+        distance_mdeg = (TEST_SEN15901_MDEG_FULL_SCALE - distance_mdeg);
+    }
+    _TEST_SEN15901_init(values[0] >> 16);
+    PROPERTY_check(SEN15901_set_wind_direction(start_degrees) == SEN15901_SUCCESS);
+    _TEST_SEN15901_commit();
+    PROPERTY_check(SEN15901_set_wind_direction_target(target_degrees, velocity_dps) == SEN15901_SUCCESS);
+    // The vane moves by (velocity * elapsed) on the shortest path and stops exactly on the target.
+    for (idx = 3; idx < size; idx++) {
+        PROPERTY_check(SEN15901_is_wind_direction_rotating() == ((covered_mdeg < distance_mdeg) ? 1 : 0));
+        elapsed_us = TEST_SEN15901_ROTATION_STEP_US_MIN + (values[idx] % (TEST_SEN15901_ROTATION_STEP_US_MAX - TEST_SEN15901_ROTATION_STEP_US_MIN + 1));
+        SEN15901_rotate_wind_direction(elapsed_us);
+        covered_mdeg += ((velocity_dps * elapsed_us) / 1000);
+        // Vane resistors follow the rotation before the commit (sub-tick positions are not dropped).
+        gpioa_bsrr = HOST_GPIOA.BSRR;
+        gpiob_bsrr = HOST_GPIOB.BSRR;
+        _TEST_SEN15901_commit();
+        PROPERTY_check((HOST_GPIOA.BSRR == gpioa_bsrr) && (HOST_GPIOB.BSRR == gpiob_bsrr));
+        if (_TEST_SEN15901_check_vane() != 0) return 1;
+    }
+    PROPERTY_check(SEN15901_is_wind_direction_rotating() == ((covered_mdeg < distance_mdeg) ? 1 : 0));
+    return 0;
+}
+
+/*******************************************************************/
+static uint8_t _TEST_SEN15901_wind_speed_error(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    uint32_t wind_speed_ckmh = 0;
+    uint32_t prescaler = 0;
+    uint32_t period = 0;
+    uint32_t period_min = 0xFFFFFFFF;
+    uint32_t period_max = 0;
+    float64_t frequency_sum_hz = 0.0;
+    float64_t target_hz = 0.0;
+    float64_t error_ppm = 0.0;
+    int32_t reported_ppm = 0;
+    uint32_t idx = 0;
+    if (size < 3) return 0;
+    _TEST_SEN15901_init(values[0]);
+    wind_speed_ckmh = TEST_SEN15901_WIND_SPEED_CKMH_MIN + (values[1] % (TEST_SEN15901_WIND_SPEED_CKMH_MAX - TEST_SEN15901_WIND_SPEED_CKMH_MIN + 1));
+    PROPERTY_check(SEN15901_set_wind_speed(wind_speed_ckmh) == SEN15901_SUCCESS);
+    // One commit per tick, all ticks have the same duration.
+    for (idx = 2; idx < size; idx++) {
+        _TEST_SEN15901_commit();
+        PROPERTY_check((HOST_TIM22.CR1 & TEST_SEN15901_TIM_CR1_UDIS) == 0);
+        // Same counter clock on all ticks.
+        if (idx > 2) {
+            PROPERTY_check((HOST_TIM22.PSC + 1) == prescaler);
+        }
+        prescaler = (HOST_TIM22.PSC + 1);
+        period = (HOST_TIM22.ARR + 1);
+        PROPERTY_check((prescaler == 1) || (period >= TEST_SEN15901_WIND_PERIOD_MIN_DIVIDED));
+        PROPERTY_check(HOST_TIM22.CCR1 == ((period * 50) / 100));
+        if (SEN15901_get_personality() != SEN15901_PERSONALITY_CLASSIC) {
+            PROPERTY_check(HOST_TIM22.CCR2 < period);
+        }
+        period_min = (period < period_min) ? period : period_min;
+        period_max = (period > period_max) ? period : period_max;
+        frequency_sum_hz += (((float64_t) TEST_SEN15901_TIM_CLOCK_HZ) / (((float64_t) period) * ((float64_t) prescaler)));
+    }
+    // Dithering between N and (N + 1) counts only.
+    PROPERTY_check((period_max - period_min) <= 1);
+    // Reported error matches the average frequency of the emitted ticks.
+    target_hz = ((((float64_t) wind_speed_ckmh) * 10.0) / ((float64_t) SEN15901_get_wind_speed_1hz_to_mh()));
+    error_ppm = (((frequency_sum_hz / ((float64_t) (size - 2))) / target_hz) - 1.0) * 1000000.0;
+    PROPERTY_check(SEN15901_get_wind_speed_error(&reported_ppm) == SEN15901_SUCCESS);
+    PROPERTY_check((((float64_t) reported_ppm) - error_ppm) <= TEST_SEN15901_ERROR_PPM_TOLERANCE);
+    PROPERTY_check((error_ppm - ((float64_t) reported_ppm)) <= TEST_SEN15901_ERROR_PPM_TOLERANCE);
+    return 0;
+}
+
+/*******************************************************************/
+static void _TEST_SEN15901_load_timer(uint32_t* phase, uint32_t* period, uint32_t* high) {
+    // Update event: counter is reset and the preloaded registers are loaded (in timer clock cycles).
+    (*phase) = 0;
+    (*period) = ((HOST_TIM22.ARR + 1) * (HOST_TIM22.PSC + 1));
+    (*high) = (HOST_TIM22.CCR1 * (HOST_TIM22.PSC + 1));
+}
+
+/*******************************************************************/
+static void _TEST_SEN15901_run_timer(uint32_t cycles, uint32_t* phase, uint32_t* period, uint32_t* high, uint32_t* pulse_count) {
+    // Reference timer: preloaded registers are loaded on each update event, one rising edge per period when CCR1 is not null.
+    while (cycles >= ((*period) - (*phase))) {
+        cycles -= ((*period) - (*phase));
+        _TEST_SEN15901_load_timer(phase, period, high);
+        (*pulse_count) += ((*high) != 0) ? 1 : 0;
+    }
+    (*phase) += cycles;
+}
+
+/*******************************************************************/
+static uint8_t _TEST_SEN15901_wind_speed_pulses(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    uint32_t tick_cycles = 0;
+    uint32_t offset_us = 0;
+    uint32_t phase = 0;
+    uint32_t period = 0;
+    uint32_t high = 0;
+    uint32_t pulse_count = 0;
+    uint32_t offset_phase = 0;
+    uint32_t offset_period = 0;
+    uint32_t offset_high = 0;
+    uint32_t offset_pulse_count = 0;
+    uint32_t idx = 0;
+    if (size < 2) return 0;
+    _TEST_SEN15901_init(values[0]);
+    tick_cycles = (SEN15901_get_tick_period_ms() * (TEST_SEN15901_TIM_CLOCK_HZ / 1000));
+    _TEST_SEN15901_load_timer(&phase, &period, &high);
+    PROPERTY_check(SEN15901_get_wind_speed_pulse_count(0) == 0);
+    // New wind speed (or none) on each tick.
+    for (idx = 1; idx < size; idx++) {
+        PROPERTY_check(SEN15901_set_wind_speed(((values[idx] & 0b11) == 0) ? 0 : (TEST_SEN15901_WIND_SPEED_CKMH_MIN + ((values[idx] >> 2) % (TEST_SEN15901_WIND_SPEED_CKMH_MAX - TEST_SEN15901_WIND_SPEED_CKMH_MIN + 1)))) == SEN15901_SUCCESS);
+        // Count within the tick.
+        offset_us = (values[idx] % (tick_cycles / TEST_SEN15901_TIM_CYCLES_PER_US));
+        offset_phase = phase;
+        offset_period = period;
+        offset_high = high;
+        offset_pulse_count = pulse_count;
+        _TEST_SEN15901_run_timer((offset_us * TEST_SEN15901_TIM_CYCLES_PER_US), &offset_phase, &offset_period, &offset_high, &offset_pulse_count);
+        PROPERTY_check(SEN15901_get_wind_speed_pulse_count(offset_us) == offset_pulse_count);
+        // Count at the end of the tick.
+        _TEST_SEN15901_run_timer(tick_cycles, &phase, &period, &high, &pulse_count);
+        HOST_TIM22.EGR = 0;
+        _TEST_SEN15901_commit();
+        // Forced update event: the current pulse is cut, rising edge only if the output was low.
+        if ((HOST_TIM22.EGR & TEST_SEN15901_TIM_EGR_UG) != 0) {
+            pulse_count += ((phase >= high) && (HOST_TIM22.CCR1 != 0)) ? 1 : 0;
+            _TEST_SEN15901_load_timer(&phase, &period, &high);
+        }
+        PROPERTY_check(SEN15901_get_wind_speed_pulse_count(0) == pulse_count);
+    }
+    return 0;
+}
+
+/*** TEST SEN15901 global variables ***/
+
+static const PROPERTY_t TEST_SEN15901_PROPERTIES[] = {
+    { "sen15901_vane_combinations", &_TEST_SEN15901_vane_combinations, 256, 0xFFFFFFFF, 2000 },
+    { "sen15901_rotation", &_TEST_SEN15901_rotation, 512, 0xFFFFFFFF, 2000 },
+    { "sen15901_wind_speed_error", &_TEST_SEN15901_wind_speed_error, 256, 0xFFFFFFFF, 5000 },
+    { "sen15901_wind_speed_pulses", &_TEST_SEN15901_wind_speed_pulses, 64, 0xFFFFFFFF, 2000 },
+};
+
+/*** TEST SEN15901 functions ***/
+
+/*******************************************************************/
+int main(int argc, char_t** argv) {
+    // Local variables.
+    uint32_t idx = 0;
+    // Properties loop.
+    PROPERTY_init(argc, argv);
+    for (idx = 0; idx < (sizeof(TEST_SEN15901_PROPERTIES) / sizeof(PROPERTY_t)); idx++) {
+        PROPERTY_run(&(TEST_SEN15901_PROPERTIES[idx]));
+    }
+    return PROPERTY_exit();
+}
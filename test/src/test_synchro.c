@@ -0,0 +1,177 @@
+/*
+ * test_synchro.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "property.h"
+#include "synchro.h"
+#include "types.h"
+
+/*** TEST SYNCHRO local macros ***/
+
+#define TEST_SYNCHRO_WIDTH_MS_MAX       70000
+// Half of the pulses are drawn below this width to test the prefixed commands sequences.
+#define TEST_SYNCHRO_WIDTH_MS_SHORT_MAX 2000
+#define TEST_SYNCHRO_PREFIX_SHIFT       8
+#define TEST_SYNCHRO_PERIOD_MS_MIN      1000
+#define TEST_SYNCHRO_PERIOD_MS_MAX      3900000
+#define TEST_SYNCHRO_LOCK_SAMPLE_COUNT  4
+#define TEST_SYNCHRO_RELOCK_SAMPLE_MAX  8
+
+/*** TEST SYNCHRO local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint32_t width_ms_min;
+    uint32_t width_ms_max;
+    SYNCHRO_command_t command;
+    // Argument is (width - argument_origin_ms).
+    uint32_t argument_origin_ms;
+} TEST_SYNCHRO_range_t;
+
+/*** TEST SYNCHRO local global variables ***/
+
+// Commands table of synchro.h.
+static const TEST_SYNCHRO_range_t TEST_SYNCHRO_RANGES[] = {
+    { 1, 1, SYNCHRO_COMMAND_NEXT, 1 },
+    { 2, 2, SYNCHRO_COMMAND_REPEAT, 2 },
+    { 3, 3, SYNCHRO_COMMAND_RESET, 3 },
+    { 4, 4, SYNCHRO_COMMAND_COVERAGE, 4 },
+    { 5, 7, SYNCHRO_COMMAND_PERSONALITY, 5 },
+    { 10, 265, SYNCHRO_COMMAND_JUMP, 10 },
+    { 301, 1299, SYNCHRO_COMMAND_PERIOD, 300 },
+    { 1300, 1555, SYNCHRO_COMMAND_PREFIX, 1300 },
+    { 1600, 1999, SYNCHRO_COMMAND_SEEK, 1600 },
+};
+
+/*** TEST SYNCHRO local functions ***/
+
+/*******************************************************************/
+static uint8_t _TEST_SYNCHRO_decode(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    SYNCHRO_frame_t frame;
+    SYNCHRO_command_t command = SYNCHRO_COMMAND_LEGACY;
+    uint32_t argument = 0;
+    uint32_t tick = 0;
+    uint32_t prefix = 0;
+    uint32_t width_ms = 0;
+    uint32_t width_us = 0;
+    int32_t error_us = 0;
+    uint32_t idx = 0;
+    uint32_t range = 0;
+    // Clear the prefix of the previous case with a legacy pulse.
+    PROPERTY_check(SYNCHRO_decode(0, &frame) == SYNCHRO_SUCCESS);
+    PROPERTY_check(frame.command == SYNCHRO_COMMAND_LEGACY);
+    // Pulses loop.
+    for (idx = 0; idx < size; idx++) {
+        // Pulse width measured with an error up to +/- 0.499ms.
+        width_ms = (values[idx] % ((((values[idx] >> 31) & 0b1) != 0) ? TEST_SYNCHRO_WIDTH_MS_SHORT_MAX : TEST_SYNCHRO_WIDTH_MS_MAX));
+        error_us = ((int32_t) ((values[idx] >> 20) % 999)) - 499;
+        if ((width_ms == 0) && (error_us < 0)) {
+            error_us = (-error_us);
+        }
+        width_us = (uint32_t) (((int32_t) (width_ms * 1000)) + error_us);
+        // Expected frame.
+        command = SYNCHRO_COMMAND_LEGACY;
+        argument = 0;
+        tick = 0;
+        for (range = 0; range < (sizeof(TEST_SYNCHRO_RANGES) / sizeof(TEST_SYNCHRO_range_t)); range++) {
+            if ((width_ms >= TEST_SYNCHRO_RANGES[range].width_ms_min) && (width_ms <= TEST_SYNCHRO_RANGES[range].width_ms_max)) {
+                command = TEST_SYNCHRO_RANGES[range].command;
+                argument = (command == SYNCHRO_COMMAND_NEXT) || (command == SYNCHRO_COMMAND_REPEAT) || (command == SYNCHRO_COMMAND_RESET) || (command == SYNCHRO_COMMAND_COVERAGE) ? 0 : (width_ms - TEST_SYNCHRO_RANGES[range].argument_origin_ms);
+            }
+        }
+        // Prefix extends the step of the next reset, jump or seek command, and is cleared by any other pulse.
+        if (command == SYNCHRO_COMMAND_SEEK) {
+            tick = argument;
+        }
+        if ((command == SYNCHRO_COMMAND_RESET) || (command == SYNCHRO_COMMAND_SEEK)) {
+            argument = prefix;
+        }
+        if ((command == SYNCHRO_COMMAND_JUMP) || (command == SYNCHRO_COMMAND_PREFIX)) {
+            argument = (((prefix << TEST_SYNCHRO_PREFIX_SHIFT) + argument) & SYNCHRO_STEP_MAX);
+        }
+        prefix = (command == SYNCHRO_COMMAND_PREFIX) ? argument : 0;
+        PROPERTY_check(SYNCHRO_decode(width_us, &frame) == SYNCHRO_SUCCESS);
+        PROPERTY_check(frame.command == command);
+        PROPERTY_check(frame.argument == argument);
+        PROPERTY_check(frame.tick == tick);
+    }
+    return 0;
+}
+
+/*******************************************************************/
+static uint8_t _TEST_SYNCHRO_window(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    SYNCHRO_estimation_t estimation;
+    uint32_t period_ms = 0;
+    uint32_t jitter_ms = 0;
+    uint32_t interval_ms = 0;
+    uint32_t idx = 0;
+    if (size < 2) return 0;
+    // Period with a bounded jitter.
+    period_ms = TEST_SYNCHRO_PERIOD_MS_MIN + (values[0] % (TEST_SYNCHRO_PERIOD_MS_MAX - TEST_SYNCHRO_PERIOD_MS_MIN + 1));
+    jitter_ms = (values[1] % ((period_ms >> 7) + 1));
+    SYNCHRO_reset_estimation(0);
+    for (idx = 2; idx < size; idx++) {
+        interval_ms = (period_ms - jitter_ms) + (values[idx] % ((jitter_ms << 1) + 1));
+        PROPERTY_check(SYNCHRO_get_estimation(&estimation) == SYNCHRO_SUCCESS);
+        // Lock after a fixed number of samples.
+        PROPERTY_check(estimation.locked == (((idx - 2) >= TEST_SYNCHRO_LOCK_SAMPLE_COUNT) ? 1 : 0));
+        // Intervals of the same period are always accepted once locked.
+        if (estimation.locked != 0) {
+            PROPERTY_check((interval_ms >= estimation.window_min_ms) && (interval_ms <= estimation.window_max_ms));
+        }
+        SYNCHRO_add_interval(interval_ms);
+    }
+    return 0;
+}
+
+/*******************************************************************/
+static uint8_t _TEST_SYNCHRO_relock(const uint32_t* values, uint32_t size) {
+    // Local variables.
+    SYNCHRO_estimation_t estimation;
+    uint32_t period_ms = 0;
+    uint32_t new_period_ms = 0;
+    uint32_t idx = 0;
+    if (size < 3) return 0;
+    // Lock on a first period, then switch to a different one.
+    period_ms = TEST_SYNCHRO_PERIOD_MS_MIN + (values[0] % (TEST_SYNCHRO_PERIOD_MS_MAX - TEST_SYNCHRO_PERIOD_MS_MIN + 1));
+    new_period_ms = TEST_SYNCHRO_PERIOD_MS_MIN + (values[1] % (TEST_SYNCHRO_PERIOD_MS_MAX - TEST_SYNCHRO_PERIOD_MS_MIN + 1));
+    SYNCHRO_reset_estimation(0);
+    for (idx = 0; idx < (2 * TEST_SYNCHRO_LOCK_SAMPLE_COUNT); idx++) {
+        SYNCHRO_add_interval(period_ms);
+    }
+    // The new period is learned after a bounded number of intervals.
+    for (idx = 0; idx < TEST_SYNCHRO_RELOCK_SAMPLE_MAX; idx++) {
+        SYNCHRO_add_interval(new_period_ms);
+    }
+    PROPERTY_check(SYNCHRO_get_estimation(&estimation) == SYNCHRO_SUCCESS);
+    PROPERTY_check(estimation.locked != 0);
+    PROPERTY_check((new_period_ms >= estimation.window_min_ms) && (new_period_ms <= estimation.window_max_ms));
+    return 0;
+}
+
+/*** TEST SYNCHRO global variables ***/
+
+static const PROPERTY_t TEST_SYNCHRO_PROPERTIES[] = {
+    { "synchro_decode", &_TEST_SYNCHRO_decode, 64, 0xFFFFFFFF, 20000 },
+    { "synchro_window", &_TEST_SYNCHRO_window, 128, 0xFFFFFFFF, 20000 },
+    { "synchro_relock", &_TEST_SYNCHRO_relock, 3, 0xFFFFFFFF, 20000 },
+};
+
+/*** TEST SYNCHRO functions ***/
+
+/*******************************************************************/
+int main(int argc, char_t** argv) {
+    // Local variables.
+    uint32_t idx = 0;
+    // Properties loop.
+    PROPERTY_init(argc, argv);
+    for (idx = 0; idx < (sizeof(TEST_SYNCHRO_PROPERTIES) / sizeof(PROPERTY_t)); idx++) {
+        PROPERTY_run(&(TEST_SYNCHRO_PROPERTIES[idx]));
+    }
+    return PROPERTY_exit();
+}
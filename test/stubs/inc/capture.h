@@ -0,0 +1,29 @@
+/*
+ * capture.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __CAPTURE_H__
+#define __CAPTURE_H__
+
+#include "types.h"
+
+/*** CAPTURE structures ***/
+
+typedef enum {
+    CAPTURE_SIGNAL_WIND_SPEED = 0,
+    CAPTURE_SIGNAL_WIND_DIRECTION,
+    CAPTURE_SIGNAL_VANE,
+    CAPTURE_SIGNAL_RAINFALL_PULSE,
+    CAPTURE_SIGNAL_RAINFALL_TRAIN,
+    CAPTURE_SIGNAL_LAST
+} CAPTURE_signal_t;
+
+/*** CAPTURE functions ***/
+
+// Host build: waveform capture is not used.
+void CAPTURE_write(CAPTURE_signal_t signal, uint32_t value);
+
+#endif /* __CAPTURE_H__ */
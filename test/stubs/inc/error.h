@@ -0,0 +1,36 @@
+/*
+ * error.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __ERROR_H__
+#define __ERROR_H__
+
+#include "maths.h"
+#include "types.h"
+
+/*** ERROR macros ***/
+
+#define ERROR_BASE_STEP     0x0100
+
+/*** ERROR structures ***/
+
+typedef uint16_t ERROR_code_t;
+
+/*** ERROR functions ***/
+
+void ERROR_stack_add(ERROR_code_t code);
+uint32_t ERROR_stack_get_count(void);
+
+/*******************************************************************/
+#define ERROR_check_exit(status_var, success, base) { if (status_var != success) { status = (base + status_var); goto errors; } }
+
+/*******************************************************************/
+#define ERROR_check_stack(status_var, success, base) { if (status_var != success) { ERROR_stack_add(base + status_var); } }
+
+/*******************************************************************/
+#define ERROR_check_stack_exit(status_var, success, base, code) { if (status_var != success) { ERROR_stack_add(base + status_var); status = code; goto errors; } }
+
+#endif /* __ERROR_H__ */
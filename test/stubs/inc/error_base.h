@@ -0,0 +1,25 @@
+/*
+ * error_base.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __ERROR_BASE_H__
+#define __ERROR_BASE_H__
+
+#include "error.h"
+
+/*** ERROR BASE structures ***/
+
+/*!******************************************************************
+ * \enum ERROR_base_t
+ * \brief Host build: only the bases used by the tested modules.
+ *******************************************************************/
+typedef enum {
+    SUCCESS = 0,
+    ERROR_BASE_SEN15901 = ERROR_BASE_STEP,
+    ERROR_BASE_LAST = (ERROR_BASE_SEN15901 + (16 * ERROR_BASE_STEP))
+} ERROR_base_t;
+
+#endif /* __ERROR_BASE_H__ */
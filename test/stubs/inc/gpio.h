@@ -0,0 +1,55 @@
+/*
+ * gpio.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __GPIO_H__
+#define __GPIO_H__
+
+#include "gpio_registers.h"
+#include "types.h"
+
+/*** GPIO structures ***/
+
+/*!******************************************************************
+ * \struct GPIO_pin_t
+ * \brief GPIO pin descriptor.
+ *******************************************************************/
+typedef struct {
+    GPIO_registers_t* port;
+    uint8_t port_index;
+    uint8_t pin;
+    uint8_t alternate_function;
+} GPIO_pin_t;
+
+typedef enum {
+    GPIO_MODE_INPUT = 0,
+    GPIO_MODE_OUTPUT,
+    GPIO_MODE_ALTERNATE_FUNCTION,
+    GPIO_MODE_ANALOG
+} GPIO_mode_t;
+
+typedef enum {
+    GPIO_TYPE_PUSH_PULL = 0,
+    GPIO_TYPE_OPEN_DRAIN
+} GPIO_type_t;
+
+typedef enum {
+    GPIO_SPEED_LOW = 0
+} GPIO_speed_t;
+
+typedef enum {
+    GPIO_PULL_NONE = 0,
+    GPIO_PULL_UP,
+    GPIO_PULL_DOWN
+} GPIO_pull_t;
+
+/*** GPIO functions ***/
+
+void GPIO_configure(const GPIO_pin_t* gpio, GPIO_mode_t mode, GPIO_type_t type, GPIO_speed_t speed, GPIO_pull_t pull);
+void GPIO_write(const GPIO_pin_t* gpio, uint8_t state);
+uint8_t GPIO_read(const GPIO_pin_t* gpio);
+
+#endif /* __GPIO_H__ */
@@ -0,0 +1,42 @@
+/*
+ * gpio_registers.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __GPIO_REGISTERS_H__
+#define __GPIO_REGISTERS_H__
+
+#include "types.h"
+
+/*** GPIO registers ***/
+
+/*!******************************************************************
+ * \struct GPIO_registers_t
+ * \brief GPIO registers map.
+ *******************************************************************/
+typedef struct {
+    volatile uint32_t MODER;
+    volatile uint32_t OTYPER;
+    volatile uint32_t OSPEEDR;
+    volatile uint32_t PUPDR;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t LCKR;
+    volatile uint32_t AFRL;
+    volatile uint32_t AFRH;
+    volatile uint32_t BRR;
+} GPIO_registers_t;
+
+/*** GPIO registers base addresses ***/
+
+// Host build: registers are plain variables.
+extern GPIO_registers_t HOST_GPIOA;
+extern GPIO_registers_t HOST_GPIOB;
+
+#define GPIOA   (&HOST_GPIOA)
+#define GPIOB   (&HOST_GPIOB)
+
+#endif /* __GPIO_REGISTERS_H__ */
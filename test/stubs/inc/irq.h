@@ -0,0 +1,19 @@
+/*
+ * irq.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __IRQ_H__
+#define __IRQ_H__
+
+#include "types.h"
+
+/*** IRQ macros ***/
+
+// Host build: single threaded, interrupts are simulated by direct calls.
+#define IRQ_SAVE(primask) { primask = 0; }
+#define IRQ_RESTORE(primask) { UNUSED(primask); }
+
+#endif /* __IRQ_H__ */
@@ -0,0 +1,23 @@
+/*
+ * maths.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __MATHS_H__
+#define __MATHS_H__
+
+#include "types.h"
+
+/*** MATH macros ***/
+
+#define MATH_2_PI_DEGREES       360
+#define MATH_PERCENT_MAX        100
+#define MATH_U32_MAX            0xFFFFFFFF
+
+/*** MATH global variables ***/
+
+extern const uint32_t MATH_POWER_10[10];
+
+#endif /* __MATHS_H__ */
@@ -0,0 +1,44 @@
+/*
+ * mcu_mapping.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __MCU_MAPPING_H__
+#define __MCU_MAPPING_H__
+
+#include "gpio.h"
+#include "tim.h"
+
+/*** MCU MAPPING macros ***/
+
+#define TIM_INSTANCE_WIND           TIM_INSTANCE_TIM22
+#define TIM_INSTANCE_RAINFALL       TIM_INSTANCE_TIM21
+#define TIM_CHANNEL_RAINFALL        TIM_CHANNEL_1
+
+/*** MCU MAPPING structures ***/
+
+/*******************************************************************/
+typedef enum {
+    TIM_CHANNEL_INDEX_WIND_SPEED = 0,
+    TIM_CHANNEL_INDEX_WIND_DIRECTION,
+    TIM_CHANNEL_INDEX_WIND_LAST
+} TIM_channel_index_wind_t;
+
+/*** MCU MAPPING global variables ***/
+
+// Host build: same ports and pins as the board.
+extern const TIM_gpio_t TIM_GPIO_WIND_CLASSIC;
+extern const TIM_gpio_t TIM_GPIO_WIND_ULTIMETER;
+extern const GPIO_pin_t GPIO_WIND_DIRECTION_N;
+extern const GPIO_pin_t GPIO_WIND_DIRECTION_NE;
+extern const GPIO_pin_t GPIO_WIND_DIRECTION_E;
+extern const GPIO_pin_t GPIO_WIND_DIRECTION_SE;
+extern const GPIO_pin_t GPIO_WIND_DIRECTION_S;
+extern const GPIO_pin_t GPIO_WIND_DIRECTION_SW;
+extern const GPIO_pin_t GPIO_WIND_DIRECTION_W;
+extern const GPIO_pin_t GPIO_WIND_DIRECTION_NW;
+extern const TIM_gpio_t TIM_GPIO_RAINFALL;
+
+#endif /* __MCU_MAPPING_H__ */
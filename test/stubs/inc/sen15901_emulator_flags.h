@@ -0,0 +1,15 @@
+/*
+ * sen15901_emulator_flags.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SEN15901_EMULATOR_FLAGS_H__
+#define __SEN15901_EMULATOR_FLAGS_H__
+
+/*** Host build flags (the others are given by the test targets) ***/
+
+#define SEN15901_EMULATOR_VANE_VELOCITY_DPS 0
+
+#endif /* __SEN15901_EMULATOR_FLAGS_H__ */
@@ -0,0 +1,15 @@
+/*
+ * stm32l0xx_drivers_flags.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __STM32L0XX_DRIVERS_FLAGS_H__
+#define __STM32L0XX_DRIVERS_FLAGS_H__
+
+/*** STM32L0xx drivers compilation flags used by the tested modules ***/
+
+#define STM32L0XX_DRIVERS_RCC_HSE_FREQUENCY_HZ          16000000
+
+#endif /* __STM32L0XX_DRIVERS_FLAGS_H__ */
@@ -0,0 +1,78 @@
+/*
+ * tim.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TIM_H__
+#define __TIM_H__
+
+#include "error.h"
+#include "gpio.h"
+#include "types.h"
+
+/*** TIM structures ***/
+
+/*!******************************************************************
+ * \enum TIM_status_t
+ * \brief TIM driver error codes.
+ *******************************************************************/
+typedef enum {
+    TIM_SUCCESS = 0,
+    TIM_ERROR_BASE_LAST = ERROR_BASE_STEP
+} TIM_status_t;
+
+typedef enum {
+    TIM_INSTANCE_TIM2 = 0,
+    TIM_INSTANCE_TIM21,
+    TIM_INSTANCE_TIM22
+} TIM_instance_t;
+
+typedef enum {
+    TIM_CHANNEL_1 = 0,
+    TIM_CHANNEL_2,
+    TIM_CHANNEL_3,
+    TIM_CHANNEL_4
+} TIM_channel_t;
+
+typedef enum {
+    TIM_POLARITY_ACTIVE_HIGH = 0,
+    TIM_POLARITY_ACTIVE_LOW
+} TIM_polarity_t;
+
+/*!******************************************************************
+ * \struct TIM_channel_gpio_t
+ * \brief Timer channel pin.
+ *******************************************************************/
+typedef struct {
+    TIM_channel_t channel;
+    const GPIO_pin_t* gpio;
+    TIM_polarity_t polarity;
+} TIM_channel_gpio_t;
+
+/*!******************************************************************
+ * \struct TIM_gpio_t
+ * \brief Timer channels pins list.
+ *******************************************************************/
+typedef struct {
+    const TIM_channel_gpio_t** list;
+    uint8_t list_size;
+} TIM_gpio_t;
+
+/*** TIM functions ***/
+
+TIM_status_t TIM_PWM_init(TIM_instance_t instance, TIM_gpio_t* pins);
+TIM_status_t TIM_PWM_de_init(TIM_instance_t instance, TIM_gpio_t* pins);
+TIM_status_t TIM_PWM_set_waveform(TIM_instance_t instance, TIM_channel_t channel, uint32_t frequency_mhz, uint8_t duty_cycle_percent);
+TIM_status_t TIM_OPM_init(TIM_instance_t instance, TIM_gpio_t* pins);
+TIM_status_t TIM_OPM_de_init(TIM_instance_t instance, TIM_gpio_t* pins);
+TIM_status_t TIM_OPM_make_pulse(TIM_instance_t instance, uint8_t channels_mask, uint32_t delay_us, uint32_t pulse_duration_us, uint8_t dma_enable);
+
+/*******************************************************************/
+#define TIM_exit_error(base) { ERROR_check_exit(tim_status, TIM_SUCCESS, base) }
+
+/*******************************************************************/
+#define TIM_stack_error(base) { ERROR_check_stack(tim_status, TIM_SUCCESS, base) }
+
+#endif /* __TIM_H__ */
@@ -0,0 +1,54 @@
+/*
+ * tim_registers.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TIM_REGISTERS_H__
+#define __TIM_REGISTERS_H__
+
+#include "types.h"
+
+/*** TIM registers ***/
+
+/*!******************************************************************
+ * \struct TIM_registers_t
+ * \brief TIM registers map.
+ *******************************************************************/
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t SMCR;
+    volatile uint32_t DIER;
+    volatile uint32_t SR;
+    volatile uint32_t EGR;
+    volatile uint32_t CCMR1;
+    volatile uint32_t CCMR2;
+    volatile uint32_t CCER;
+    volatile uint32_t CNT;
+    volatile uint32_t PSC;
+    volatile uint32_t ARR;
+    volatile uint32_t RESERVED0;
+    volatile uint32_t CCR1;
+    volatile uint32_t CCR2;
+    volatile uint32_t CCR3;
+    volatile uint32_t CCR4;
+    volatile uint32_t RESERVED1;
+    volatile uint32_t DCR;
+    volatile uint32_t DMAR;
+    volatile uint32_t OR;
+} TIM_registers_t;
+
+/*** TIM registers base addresses ***/
+
+// Host build: registers are plain variables.
+extern TIM_registers_t HOST_TIM2;
+extern TIM_registers_t HOST_TIM21;
+extern TIM_registers_t HOST_TIM22;
+
+#define TIM2    (&HOST_TIM2)
+#define TIM21   (&HOST_TIM21)
+#define TIM22   (&HOST_TIM22)
+
+#endif /* __TIM_REGISTERS_H__ */
@@ -0,0 +1,26 @@
+/*
+ * trace.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include "types.h"
+
+/*** TRACE structures ***/
+
+typedef enum {
+    TRACE_EVENT_WIND_SPEED = 0,
+    TRACE_EVENT_WIND_DIRECTION,
+    TRACE_EVENT_RAINFALL_PULSE,
+    TRACE_EVENT_LAST
+} TRACE_event_t;
+
+/*** TRACE functions ***/
+
+void TRACE_write(TRACE_event_t event, uint16_t data);
+
+#endif /* __TRACE_H__ */
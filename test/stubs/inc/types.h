@@ -0,0 +1,26 @@
+/*
+ * types.h
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __TYPES_H__
+#define __TYPES_H__
+
+// Host build: fixed width types come from the C library.
+#include <stddef.h>
+#include <stdint.h>
+
+/*!******************************************************************
+ * \brief Custom variables types.
+ *******************************************************************/
+
+typedef char                char_t;
+
+typedef float               float32_t;
+typedef double              float64_t;
+
+#define UNUSED(x)           ((void) x)
+
+#endif /* __TYPES_H__ */
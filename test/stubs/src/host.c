@@ -0,0 +1,144 @@
+/*
+ * host.c
+ *
+ *  Created on: 19 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "capture.h"
+#include "error.h"
+#include "gpio.h"
+#include "gpio_registers.h"
+#include "maths.h"
+#include "mcu_mapping.h"
+#include "tim.h"
+#include "tim_registers.h"
+#include "trace.h"
+#include "types.h"
+
+/*** HOST global variables ***/
+
+const uint32_t MATH_POWER_10[10] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+GPIO_registers_t HOST_GPIOA;
+GPIO_registers_t HOST_GPIOB;
+
+TIM_registers_t HOST_TIM2;
+TIM_registers_t HOST_TIM21;
+TIM_registers_t HOST_TIM22;
+
+const GPIO_pin_t GPIO_WIND_DIRECTION_N = { GPIOA, 0, 3, 0 };
+const GPIO_pin_t GPIO_WIND_DIRECTION_NE = { GPIOA, 0, 4, 0 };
+const GPIO_pin_t GPIO_WIND_DIRECTION_E = { GPIOA, 0, 5, 0 };
+const GPIO_pin_t GPIO_WIND_DIRECTION_SE = { GPIOA, 0, 6, 0 };
+const GPIO_pin_t GPIO_WIND_DIRECTION_S = { GPIOA, 0, 7, 0 };
+const GPIO_pin_t GPIO_WIND_DIRECTION_SW = { GPIOB, 1, 0, 0 };
+const GPIO_pin_t GPIO_WIND_DIRECTION_W = { GPIOB, 1, 1, 0 };
+const GPIO_pin_t GPIO_WIND_DIRECTION_NW = { GPIOB, 1, 2, 0 };
+
+static const GPIO_pin_t HOST_GPIO_TIM22_CH1 = { GPIOB, 1, 4, 4 };
+static const GPIO_pin_t HOST_GPIO_TIM22_CH2 = { GPIOB, 1, 5, 4 };
+static const GPIO_pin_t HOST_GPIO_TIM21_CH1 = { GPIOB, 1, 6, 5 };
+static const TIM_channel_gpio_t HOST_TIM_CHANNEL_WIND_SPEED = { TIM_CHANNEL_1, &HOST_GPIO_TIM22_CH1, TIM_POLARITY_ACTIVE_HIGH };
+static const TIM_channel_gpio_t HOST_TIM_CHANNEL_WIND_DIRECTION = { TIM_CHANNEL_2, &HOST_GPIO_TIM22_CH2, TIM_POLARITY_ACTIVE_HIGH };
+static const TIM_channel_gpio_t HOST_TIM_CHANNEL_RAINFALL = { TIM_CHANNEL_1, &HOST_GPIO_TIM21_CH1, TIM_POLARITY_ACTIVE_HIGH };
+static const TIM_channel_gpio_t* const HOST_TIM_CHANNELS_WIND_CLASSIC[] = { &HOST_TIM_CHANNEL_WIND_SPEED };
+static const TIM_channel_gpio_t* const HOST_TIM_CHANNELS_WIND_ULTIMETER[] = { &HOST_TIM_CHANNEL_WIND_SPEED, &HOST_TIM_CHANNEL_WIND_DIRECTION };
+static const TIM_channel_gpio_t* const HOST_TIM_CHANNELS_RAINFALL[] = { &HOST_TIM_CHANNEL_RAINFALL };
+
+const TIM_gpio_t TIM_GPIO_WIND_CLASSIC = { (const TIM_channel_gpio_t**) &HOST_TIM_CHANNELS_WIND_CLASSIC, 1 };
+const TIM_gpio_t TIM_GPIO_WIND_ULTIMETER = { (const TIM_channel_gpio_t**) &HOST_TIM_CHANNELS_WIND_ULTIMETER, 2 };
+const TIM_gpio_t TIM_GPIO_RAINFALL = { (const TIM_channel_gpio_t**) &HOST_TIM_CHANNELS_RAINFALL, 1 };
+
+static uint32_t host_error_count = 0;
+
+/*** HOST functions ***/
+
+/*******************************************************************/
+void ERROR_stack_add(ERROR_code_t code) {
+    UNUSED(code);
+    host_error_count++;
+}
+
+/*******************************************************************/
+uint32_t ERROR_stack_get_count(void) {
+    return host_error_count;
+}
+
+/*******************************************************************/
+void GPIO_configure(const GPIO_pin_t* gpio, GPIO_mode_t mode, GPIO_type_t type, GPIO_speed_t speed, GPIO_pull_t pull) {
+    UNUSED(gpio);
+    UNUSED(mode);
+    UNUSED(type);
+    UNUSED(speed);
+    UNUSED(pull);
+}
+
+/*******************************************************************/
+void GPIO_write(const GPIO_pin_t* gpio, uint8_t state) {
+    gpio->port->BSRR = (0b1 << ((gpio->pin) + ((state == 0) ? 16 : 0)));
+}
+
+/*******************************************************************/
+uint8_t GPIO_read(const GPIO_pin_t* gpio) {
+    return (((gpio->port->ODR) >> (gpio->pin)) & 0b1);
+}
+
+/*******************************************************************/
+TIM_status_t TIM_PWM_init(TIM_instance_t instance, TIM_gpio_t* pins) {
+    UNUSED(instance);
+    UNUSED(pins);
+    return TIM_SUCCESS;
+}
+
+/*******************************************************************/
+TIM_status_t TIM_PWM_de_init(TIM_instance_t instance, TIM_gpio_t* pins) {
+    UNUSED(instance);
+    UNUSED(pins);
+    return TIM_SUCCESS;
+}
+
+/*******************************************************************/
+TIM_status_t TIM_PWM_set_waveform(TIM_instance_t instance, TIM_channel_t channel, uint32_t frequency_mhz, uint8_t duty_cycle_percent) {
+    UNUSED(instance);
+    UNUSED(channel);
+    UNUSED(frequency_mhz);
+    UNUSED(duty_cycle_percent);
+    return TIM_SUCCESS;
+}
+
+/*******************************************************************/
+TIM_status_t TIM_OPM_init(TIM_instance_t instance, TIM_gpio_t* pins) {
+    UNUSED(instance);
+    UNUSED(pins);
+    return TIM_SUCCESS;
+}
+
+/*******************************************************************/
+TIM_status_t TIM_OPM_de_init(TIM_instance_t instance, TIM_gpio_t* pins) {
+    UNUSED(instance);
+    UNUSED(pins);
+    return TIM_SUCCESS;
+}
+
+/*******************************************************************/
+TIM_status_t TIM_OPM_make_pulse(TIM_instance_t instance, uint8_t channels_mask, uint32_t delay_us, uint32_t pulse_duration_us, uint8_t dma_enable) {
+    UNUSED(instance);
+    UNUSED(channels_mask);
+    UNUSED(delay_us);
+    UNUSED(pulse_duration_us);
+    UNUSED(dma_enable);
+    return TIM_SUCCESS;
+}
+
+/*******************************************************************/
+void TRACE_write(TRACE_event_t event, uint16_t data) {
+    UNUSED(event);
+    UNUSED(data);
+}
+
+/*******************************************************************/
+void CAPTURE_write(CAPTURE_signal_t signal, uint32_t value) {
+    UNUSED(signal);
+    UNUSED(value);
+}